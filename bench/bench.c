@@ -0,0 +1,348 @@
+// Copyright 2013 Allen Boyd Cunningham
+
+// This file is part of pokyr.
+
+//     pokyr is free software: you can redistribute it and/or modify
+//     it under the terms of the GNU General Public License as published by
+//     the Free Software Foundation, either version 3 of the License, or
+//     (at your option) any later version.
+//     pokyr is distributed in the hope that it will be useful,
+//     but WITHOUT ANY WARRANTY; without even the implied warranty of
+//     MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//     GNU General Public License for more details.
+
+//     You should have received a copy of the GNU General Public License
+//     along with pokyr.  If not, see <http://www.gnu.org/licenses/>.
+
+
+//Throughput of the C engines without python in the way, as JSON on
+//stdout (see the Makefile and compare.py).
+//
+//    bench [--quick] [--threads n] [--filter name]
+//
+//Each case runs for at least a quarter second (--quick: 20ms).  evals counts
+//hands ranked, boards times hands for the enumerations, whether or not
+//suit symmetry or a table spared some of the work.  On linux the hardware
+//counters of the whole run, threads included, come from perf_event_open
+//and are null when the kernel won't give them.
+
+#define _GNU_SOURCE
+#include "poker_heavy.h"
+
+#include <string.h>
+#include <time.h>
+
+#ifdef __linux__
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+#define MAX_PLAYERS 9
+#define BOARD_AT (MAX_PLAYERS * 2)
+#define NUM_DEALS 4096
+#define RIVER_DEALS 256
+#define MC_RUNS 100000
+
+#define NUM_COUNTERS 4
+static const char *Counter_Names[NUM_COUNTERS] =
+    {"cycles", "instructions", "cache_misses", "branch_misses"};
+
+//MAX_PLAYERS hands and a board, NUM_DEALS times
+static uint32_t Deals[NUM_DEALS][BOARD_AT + 5];
+static uint32_t Sevens[NUM_DEALS * 7];
+static uint16_t Ranks[NUM_DEALS];
+
+static double Min_Seconds = 0.25;
+static int Threads = 1;
+
+typedef struct bench_case bench_case;
+//one unit of work, the i'th since the case started
+//Return the evaluations it made
+typedef uint64_t (*bench_fn)(const bench_case *c, uint64_t i);
+
+struct bench_case{
+    const char *name;
+    const char *engine;
+    bench_fn run;
+    int players;        //0 when it doesn't apply
+    int nboard;         //-1 when it doesn't apply
+    int calls;          //calls per unit
+    bool once;          //for the table builds, which only happen once
+};
+
+typedef struct{
+    int fds[NUM_COUNTERS];
+    uint64_t values[NUM_COUNTERS];
+    bool ok;
+}counters;
+
+
+static double now(void){
+    struct timespec t;
+    clock_gettime(CLOCK_MONOTONIC, &t);
+    return t.tv_sec + t.tv_nsec * 1e-9;
+}
+
+
+#ifdef __linux__
+static int open_counter(uint64_t config){
+    struct perf_event_attr attr;
+
+    memset(&attr, 0, sizeof(attr));
+    attr.size = sizeof(attr);
+    attr.type = PERF_TYPE_HARDWARE;
+    attr.config = config;
+    attr.disabled = 1;
+    attr.inherit = 1;           //count the threads the work starts too
+    attr.exclude_kernel = 1;
+    attr.exclude_hv = 1;
+    return (int) syscall(SYS_perf_event_open, &attr, 0, -1, -1, 0);
+}
+#endif
+
+static void start_counters(counters *k){
+    int i;
+
+    k->ok = false;
+#ifdef __linux__
+    static const uint64_t configs[NUM_COUNTERS] = {PERF_COUNT_HW_CPU_CYCLES,
+        PERF_COUNT_HW_INSTRUCTIONS, PERF_COUNT_HW_CACHE_MISSES, PERF_COUNT_HW_BRANCH_MISSES};
+
+    k->ok = true;
+    for (i = 0; i < NUM_COUNTERS; i++){
+        if ( (k->fds[i] = open_counter(configs[i])) < 0 )
+            k->ok = false;
+    }
+    for (i = 0; i < NUM_COUNTERS; i++){
+        if (k->fds[i] >= 0 && k->ok)
+            ioctl(k->fds[i], PERF_EVENT_IOC_ENABLE, 0);
+    }
+#else
+    for (i = 0; i < NUM_COUNTERS; i++)
+        k->fds[i] = -1;
+#endif
+}
+
+static void stop_counters(counters *k){
+    int i;
+
+    for (i = 0; i < NUM_COUNTERS; i++){
+#ifdef __linux__
+        if (k->fds[i] < 0)
+            continue;
+        ioctl(k->fds[i], PERF_EVENT_IOC_DISABLE, 0);
+        if (read(k->fds[i], &k->values[i], sizeof(uint64_t)) != sizeof(uint64_t))
+            k->ok = false;
+        close(k->fds[i]);
+#endif
+    }
+}
+
+
+//results the timed loops store so they can't be optimized away
+static volatile uint64_t Sink;
+
+
+static uint64_t choose(int n, int k){
+    uint64_t c = 1;
+    int i;
+
+    for (i = 1; i <= k; i++)
+        c = c * (uint64_t) (n - k + i) / (uint64_t) i;
+    return c;
+}
+
+
+static uint64_t lite_handvalue(const bench_case *c, uint64_t i){
+    uint64_t sum = 0;
+    int j;
+
+    for (j = 0; j < NUM_DEALS; j++)
+        sum += handvalue(Sevens + j * 7);
+    Sink = sum;
+    return NUM_DEALS;
+}
+
+static uint64_t heavy_rank_batch(const bench_case *c, uint64_t i){
+    rank_batch(Sevens, NUM_DEALS, Ranks);
+    return NUM_DEALS;
+}
+
+static uint64_t heavy_holdem2p(const bench_case *c, uint64_t i){
+    uint32_t *d;
+    int j, sum = 0;
+
+    for (j = 0; j < NUM_DEALS; j++){
+        d = Deals[j];
+        sum += holdem2p(d, d + 2, d + BOARD_AT);
+    }
+    Sink = sum;
+    return NUM_DEALS * 2;
+}
+
+static uint64_t heavy_rivervalue(const bench_case *c, uint64_t i){
+    uint32_t *d;
+    int j, sum = 0;
+
+    for (j = 0; j < RIVER_DEALS; j++){
+        d = Deals[(i * RIVER_DEALS + j) % NUM_DEALS];
+        sum += rivervalue(d, d + BOARD_AT).wins;
+    }
+    Sink = sum;
+    //the hand and all 990 others
+    return RIVER_DEALS * 991;
+}
+
+static uint64_t heavy_enum2p(const bench_case *c, uint64_t i){
+    uint32_t *d = Deals[i % NUM_DEALS];
+
+    enum2p(d, d + 2, Threads);
+    return PREFLOP_BOARDS * 2;
+}
+
+static uint64_t heavy_full_enumeration(const bench_case *c, uint64_t i){
+    uint32_t *d = Deals[i % NUM_DEALS];
+    double results[MAX_HANDS];
+
+    full_enumeration((uint32_t (*)[2]) d, c->players, d + BOARD_AT, c->nboard, results, Threads);
+    return choose(52 - 2 * c->players - c->nboard, 5 - c->nboard) * c->players;
+}
+
+static uint64_t heavy_monte_carlo(const bench_case *c, uint64_t i){
+    uint32_t *d = Deals[i % NUM_DEALS];
+    double results[MAX_HANDS], stderrs[MAX_HANDS];
+
+    monte_carlo((uint32_t (*)[2]) d, c->players, d + BOARD_AT, c->nboard, NULL, 0, MC_RUNS,
+                0.0, results, stderrs, i + 1, Threads);
+    return (uint64_t) MC_RUNS * c->players;
+}
+
+static uint64_t build_rank_tables(const bench_case *c, uint64_t i){
+    init_tables();
+    return 0;
+}
+
+static uint64_t build_best5(const bench_case *c, uint64_t i){
+    init_best5();
+    return 0;
+}
+
+static uint64_t build_lows(const bench_case *c, uint64_t i){
+    init_lows();
+    return 0;
+}
+
+static uint64_t build_short_deck(const bench_case *c, uint64_t i){
+    init_short_deck();
+    return 0;
+}
+
+
+static void deal_all(void){
+    deck d;
+    int i, j;
+
+    initdeck(&d, NULL, 1);
+    for (i = 0; i < NUM_DEALS; i++){
+        deal(&d, Deals[i], BOARD_AT + 5);
+        for (j = 0; j < 7; j++)
+            Sevens[i * 7 + j] = Deals[i][(j < 2) ? j : BOARD_AT + j - 2];
+    }
+}
+
+
+static bool First_Result = true;
+
+static void run_case(const bench_case *c){
+    counters k;
+    uint64_t units = 0, evals = 0;
+    double start, seconds;
+    int i;
+
+    start_counters(&k);
+    start = now();
+    do{
+        evals += c->run(c, units++);
+    }while (!c->once && now() - start < Min_Seconds);
+    seconds = now() - start;
+    stop_counters(&k);
+
+    printf("%s\n    {\"name\": \"%s\", \"engine\": \"%s\", ", First_Result ? "" : ",", c->name, c->engine);
+    First_Result = false;
+    if (c->players)
+        printf("\"players\": %i, ", c->players);
+    if (c->nboard >= 0)
+        printf("\"board\": %i, ", c->nboard);
+    printf("\"threads\": %i, \"calls\": %llu, \"evals\": %llu, \"seconds\": %.6f, "
+           "\"ns_per_call\": %.3f, \"evals_per_sec\": %.1f",
+           Threads, (unsigned long long) units * c->calls, (unsigned long long) evals, seconds,
+           seconds * 1e9 / (double) (units * c->calls), evals / seconds);
+    for (i = 0; i < NUM_COUNTERS; i++){
+        if (k.ok)
+            printf(", \"%s\": %llu", Counter_Names[i], (unsigned long long) k.values[i]);
+        else
+            printf(", \"%s\": null", Counter_Names[i]);
+    }
+    printf("}");
+    fflush(stdout);
+}
+
+
+int main(int argc, char *argv[]){
+    bench_case cases[64];
+    const char *filter = NULL;
+    int i, n = 0, players, nboard;
+
+    for (i = 1; i < argc; i++){
+        if (!strcmp(argv[i], "--quick"))
+            Min_Seconds = 0.02;
+        else if (!strcmp(argv[i], "--threads") && i + 1 < argc)
+            Threads = atoi(argv[++i]);
+        else if (!strcmp(argv[i], "--filter") && i + 1 < argc)
+            filter = argv[++i];
+        else{
+            fprintf(stderr, "usage: %s [--quick] [--threads n] [--filter name]\n", argv[0]);
+            return 1;
+        }
+    }
+
+    //the builds go first since everything else needs them
+    cases[n++] = (bench_case) {"init_tables", "heavy", build_rank_tables, 0, -1, 1, true};
+    cases[n++] = (bench_case) {"init_best5", "heavy", build_best5, 0, -1, 1, true};
+    cases[n++] = (bench_case) {"init_lows", "heavy", build_lows, 0, -1, 1, true};
+    cases[n++] = (bench_case) {"init_short_deck", "heavy", build_short_deck, 0, -1, 1, true};
+    cases[n++] = (bench_case) {"handvalue", "lite", lite_handvalue, 0, -1, NUM_DEALS, false};
+    cases[n++] = (bench_case) {"rank_batch", "heavy", heavy_rank_batch, 0, -1, NUM_DEALS, false};
+    cases[n++] = (bench_case) {"holdem2p", "heavy", heavy_holdem2p, 2, 5, NUM_DEALS, false};
+    cases[n++] = (bench_case) {"rivervalue", "heavy", heavy_rivervalue, 0, 5, RIVER_DEALS, false};
+    cases[n++] = (bench_case) {"enum2p", "heavy", heavy_enum2p, 2, 0, 1, false};
+    for (players = 2; players <= MAX_PLAYERS; players++){
+        for (nboard = 0; nboard <= 4; nboard++)
+            cases[n++] = (bench_case) {"full_enumeration", "heavy", heavy_full_enumeration,
+                                       players, nboard, 1, false};
+    }
+    cases[n++] = (bench_case) {"monte_carlo", "heavy", heavy_monte_carlo, 3, 0, 1, false};
+    cases[n++] = (bench_case) {"monte_carlo", "heavy", heavy_monte_carlo, 6, 3, 1, false};
+
+    deal_all();
+    printf("{\n  \"compact_ranks\": %s,\n  \"min_seconds\": %g,\n  \"results\": [",
+#ifdef COMPACT_RANKS
+           "true",
+#else
+           "false",
+#endif
+           Min_Seconds);
+    for (i = 0; i < n; i++){
+        //the table builds run regardless, just not reported
+        if (filter && !strstr(cases[i].name, filter) && !cases[i].once)
+            continue;
+        if (filter && !strstr(cases[i].name, filter))
+            cases[i].run(&cases[i], 0);
+        else
+            run_case(&cases[i]);
+    }
+    printf("\n  ]\n}\n");
+    return 0;
+}
@@ -0,0 +1,58 @@
+#!/usr/bin/env python
+"""Per call cost of cpoker's cheap entry points, in ns per call.
+
+The work behind these calls is a few table lookups, so most of what they
+cost is the call itself: argument parsing, converting the cards and
+building the result.  `len` of a list is shown as a floor for any call
+from python.
+
+    $ python bench/call_overhead.py [--json]
+"""
+
+from __future__ import print_function
+
+import json
+import os
+import sys
+import timeit
+
+sys.path.insert(0, os.path.join(os.path.dirname(os.path.abspath(__file__)), '..'))
+
+from poker import cpoker  # noqa: E402
+
+
+H1, H2, BOARD = [0, 5], [48, 49], [8, 12, 16, 20, 45]
+HANDS = [H1, H2, [30, 33]]
+SEVEN = H1 + BOARD
+
+CALLS = [
+    ('len (floor)', len, (SEVEN,)),
+    ('handvalue', cpoker.handvalue, (SEVEN,)),
+    ('holdem2p', cpoker.holdem2p, (H1, H2, BOARD)),
+    ('multi_holdem 3 hands', cpoker.multi_holdem, (HANDS, BOARD)),
+    ('rivervalue', cpoker.rivervalue, (H1, BOARD)),
+    ('riverties', cpoker.riverties, (H1, BOARD)),
+    ('best5_rank 7 cards', cpoker.best5_rank, (SEVEN,)),
+    ('low_rank 7 cards', cpoker.low_rank, (SEVEN,)),
+    ('omaha_rank', cpoker.omaha_rank, ([0, 5, 30, 33], BOARD)),
+    ('short_rank', cpoker.short_rank, ([0, 5, 8, 12, 16, 20, 25],)),
+]
+
+
+def per_call(fn, args, number=200000, repeat=5):
+    #best of repeat runs of number calls, in ns
+    timer = timeit.Timer(lambda: fn(*args))
+    return min(timer.repeat(repeat, number)) / number * 1e9
+
+
+def main():
+    results = dict((name, per_call(fn, args)) for name, fn, args in CALLS)
+    if '--json' in sys.argv[1:]:
+        print(json.dumps(results, indent=2, sort_keys=True))
+        return
+    for name, fn, args in CALLS:
+        print('%-22s %7.1f ns' % (name, results[name]))
+
+
+if __name__ == '__main__':
+    main()
@@ -0,0 +1,73 @@
+#!/usr/bin/env python
+"""Line up two benchmark runs (bench or engines.py JSON) case by case.
+
+    $ python bench/compare.py baseline.json current.json [--threshold 0.9]
+
+Prints new/old throughput for every case both runs have, and the cache
+and branch misses per eval when both runs counted them.  Exits 1 when
+any case ran below threshold times its baseline speed.
+"""
+
+from __future__ import division, print_function
+
+import json
+import sys
+
+
+def key(result):
+    return (result['name'], result['engine'], result.get('players'), result.get('board'),
+            result.get('threads', 1))
+
+
+def speed(result):
+    #the table builds make no evals, so go by time for them
+    if result['evals']:
+        return result['evals_per_sec']
+    return 1e9 / result['ns_per_call']
+
+
+def per_eval(result, counter):
+    if result.get(counter) is None or not result['evals']:
+        return None
+    return result[counter] / result['evals']
+
+
+def main(argv):
+    threshold = 0.9
+    if '--threshold' in argv:
+        i = argv.index('--threshold')
+        threshold = float(argv[i + 1])
+        del argv[i:i + 2]
+    if len(argv) != 2:
+        print(__doc__, file=sys.stderr)
+        return 2
+    with open(argv[0]) as f:
+        old = dict((key(r), r) for r in json.load(f)['results'])
+    with open(argv[1]) as f:
+        new = [r for r in json.load(f)['results'] if key(r) in old]
+
+    slower = 0
+    for r in new:
+        name, engine, players, board, threads = key(r)
+        label = '%s %s' % (engine, name)
+        if players:
+            label += ' %ip' % players
+        if board is not None:
+            label += ' %ib' % board
+        if threads != 1:
+            label += ' x%i' % threads
+        ratio = speed(r) / speed(old[key(r)])
+        line = '%-36s %6.3fx' % (label, ratio)
+        for counter in ('cache_misses', 'branch_misses'):
+            a, b = per_eval(old[key(r)], counter), per_eval(r, counter)
+            if a is not None and b is not None:
+                line += '  %s/eval %.4f -> %.4f' % (counter, a, b)
+        if ratio < threshold:
+            line += '  SLOWER'
+            slower += 1
+        print(line)
+    return 1 if slower else 0
+
+
+if __name__ == '__main__':
+    sys.exit(main(sys.argv[1:]))
@@ -0,0 +1,102 @@
+#!/usr/bin/env python
+"""Throughput of the engines as python sees them: cpoker, the pure python
+poker module and poker_lite, as JSON in the shape bench.c writes.
+
+    $ python bench/engines.py [--quick]
+
+evals counts hands ranked (boards times hands for the enumerations).
+The pure python engines only get the cases they finish in reasonable time.
+"""
+
+from __future__ import division, print_function
+
+import json
+import os
+import random
+import sys
+import time
+
+sys.path.insert(0, os.path.join(os.path.dirname(os.path.abspath(__file__)), '..'))
+
+from poker import cpoker, poker, poker_lite  # noqa: E402
+
+ENGINES = [('cpoker', cpoker), ('python', poker), ('python-lite', poker_lite)]
+
+
+def choose(n, k):
+    c = 1
+    for i in range(1, k + 1):
+        c = c * (n - k + i) // i
+    return c
+
+
+def deals(players, nboard, count=256):
+    rng = random.Random(1)
+    out = []
+    for __ in range(count):
+        cards = rng.sample(range(52), 2 * players + nboard)
+        out.append(([cards[2 * i:2 * i + 2] for i in range(players)], cards[2 * players:]))
+    return out
+
+
+def cases():
+    #(name, players, board, [(engine, call, evals per call)]) with call(i)
+    #doing the i'th call
+    sevens = [sum(h, b) for h, b in deals(1, 5)]
+    rivers = deals(2, 5)
+    three = deals(3, 5)
+
+    yield 'handvalue', 0, -1, [(name, lambda i, m=m: m.handvalue(sevens[i % 256]), 1)
+                               for name, m in ENGINES]
+    yield 'holdem2p', 2, 5, [(name, lambda i, m=m: m.holdem2p(*(rivers[i % 256][0] + [rivers[i % 256][1]])), 2)
+                             for name, m in ENGINES]
+    yield 'multi_holdem', 3, 5, [(name, lambda i, m=m: m.multi_holdem(*three[i % 256]), 3)
+                                 for name, m in ENGINES]
+    yield 'rivervalue', 0, 5, [('cpoker', lambda i: cpoker.rivervalue(rivers[i % 256][0][0],
+                                                                      rivers[i % 256][1]), 991)]
+    for players, nboard in [(2, 0), (2, 3), (2, 4), (3, 3), (3, 4), (6, 3), (9, 0), (9, 4)]:
+        boards = deals(players, nboard, 16)
+        evals = choose(52 - 2 * players - nboard, 5 - nboard) * players
+        engines = [('cpoker', lambda i, b=boards: cpoker.full_enumeration(*b[i % 16]), evals)]
+        if nboard >= 3 and players <= 3:
+            engines.append(('python', lambda i, b=boards: poker.full_enumeration(*b[i % 16]), evals))
+        yield 'full_enumeration', players, nboard, engines
+    for players in (3, 6):
+        hands = [h for h, b in deals(players, 0, 16)]
+        yield 'monte_carlo', players, 0, [('cpoker', lambda i, h=hands: cpoker.monte_carlo(
+            h[i % 16], 100000, seed=i + 1), 100000 * players)]
+
+
+def run(call, min_seconds):
+    calls = 0
+    start = time.time()
+    while True:
+        call(calls)
+        calls += 1
+        seconds = time.time() - start
+        if seconds >= min_seconds:
+            return calls, seconds
+
+
+def main():
+    min_seconds = 0.02 if '--quick' in sys.argv[1:] else 0.25
+    results = []
+    for name, players, nboard, engines in cases():
+        for engine, call, evals in engines:
+            calls, seconds = run(call, min_seconds)
+            result = {'name': name, 'engine': engine}
+            if players:
+                result['players'] = players
+            if nboard >= 0:
+                result['board'] = nboard
+            result.update(threads=1, calls=calls, evals=calls * evals, seconds=seconds,
+                          ns_per_call=seconds * 1e9 / calls,
+                          evals_per_sec=calls * evals / seconds)
+            results.append(result)
+    json.dump({'python': sys.version.split()[0], 'min_seconds': min_seconds,
+               'results': results}, sys.stdout, indent=2, sort_keys=True)
+    print()
+
+
+if __name__ == '__main__':
+    main()
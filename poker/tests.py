@@ -16,6 +16,11 @@
 #     along with pokyr.  If not, see <http://www.gnu.org/licenses/>.
 
 
+import collections
+import itertools
+import random
+import threading
+
 from . import cpoker
 from . import poker_lite
 from . import poker
@@ -26,6 +31,29 @@ def assert_close(a, b, error=.001):
     if abs(a - b) > error:
         raise AssertionError
 
+def assert_raises(exc, f):
+    try:
+        f()
+    except exc:
+        pass
+    else:
+        raise AssertionError
+
+def five_value(cards):
+    #a sortable value of a 5 card hand, by brute force
+    ranks = sorted((12 - (c >> 2) for c in cards), reverse=True)
+    counts = collections.Counter(ranks)
+    groups = sorted(counts.items(), key=lambda rc: (rc[1], rc[0]), reverse=True)
+    shape, order = [n for r, n in groups], [r for r, n in groups]
+    flush = len(set(c & 3 for c in cards)) == 1
+    wheel = ranks == [12, 3, 2, 1, 0]
+    if len(counts) == 5 and (ranks[0] - ranks[4] == 4 or wheel):
+        return (8 if flush else 4, [3 if wheel else ranks[0]])
+    if flush and len(counts) == 5:
+        return (5, order)
+    return ({(4, 1): 7, (3, 2): 6, (3, 1, 1): 3, (2, 2, 1): 2, (2, 1, 1, 1): 1}.get(tuple(shape), 0), order)
+
+
 def test_full_enumeration():
     f = lambda *hands: cpoker.full_enumeration([utils.to_cards(h) for h in hands])
     map(assert_close, f("3s 2c", "5c 2h"), [0.398847108925, 1 - 0.398847108925])
@@ -160,6 +188,564 @@ def test_multi_holdem():
         result)
 
 
+def test_suit_symmetric_enumeration():
+    #hands that leave suits interchangeable take the reduced path
+    f = lambda hands, board='': cpoker.full_enumeration(
+        [utils.to_cards(h) for h in hands], utils.to_cards(board) if board else [])
+    for hands in [('2s 3s', '5s Js'), ('2h 3h', '5h Jh'), ('2d 3d', 'Jd 5d')]:
+        assert_close(f(hands)[0], 0.329603271382, 1e-9)
+    for hands, board in [(('Ah Kh', 'Qh Jh', 'Th 9h'), 'As 2c'),
+                         (('Ac Ad', 'Kc Kd'), '7h 8s 9c'),
+                         (('4c 5c', '6d 7d', '8c 9d'), '2h'),
+                         (('Qs Js', 'Ts 9s'), 'Ks 2h 3h 4d')]:
+        for a, b in zip(f(hands, board), poker.full_enumeration(
+                [utils.to_cards(h) for h in hands], utils.to_cards(board))):
+            assert_close(a, b, 1e-9)
+
+
+def test_enumeration_kernels():
+    #each number of hands has its own kernel up to 9, and more share one
+    for nhands in range(2, 12):
+        cards = utils.deal([2] * nhands + [4])
+        hands, board = cards[:nhands], cards[nhands]
+        shares = [0.0] * nhands
+        live = [c for c in range(52) if c not in sum(cards, [])]
+        for card in live:
+            winners = cpoker.multi_holdem(hands, board + [card])
+            for i in winners:
+                shares[i] += 1.0 / len(winners)
+        for a, b in zip(cpoker.full_enumeration(hands, board), shares):
+            assert_close(a, b / len(live), 1e-12)
+        exact = cpoker.full_enumeration(hands, board[:2])
+        assert cpoker.full_enumeration(hands, board[:2], threads=3) == exact
+        assert_close(sum(exact), 1.0, 1e-12)
+
+
+def test_headsup_counts():
+    #exact counts over the flop and turn runouts, and the evs from them
+    for __ in range(30):
+        h1, h2, board = utils.deal([2, 2, 4])
+        for nboard in (3, 4):
+            counts = [0, 0, 0]
+            live = [c for c in range(52) if c not in h1 + h2 + board[:nboard]]
+            for runout in itertools.combinations(live, 5 - nboard):
+                counts[cpoker.holdem2p(h1, h2, board[:nboard] + list(runout))] += 1
+            assert cpoker.headsup_counts(h1, h2, board[:nboard]) == tuple(counts)
+            ev = (counts[0] + 0.5 * counts[2]) / sum(counts)
+            assert_close(cpoker.full_enumeration([h1, h2], board[:nboard])[0], ev, 1e-12)
+    wins, losses, ties = cpoker.headsup_counts([0, 1], [48, 49])
+    assert_close(cpoker.full_enumeration([[0, 1], [48, 49]])[0],
+                 (wins + 0.5 * ties) / (wins + losses + ties), 1e-12)
+    assert_raises(ValueError, lambda: cpoker.headsup_counts([0, 1], [2, 3], [4, 5]))
+
+
+def test_threaded_enumeration():
+    hands = [utils.to_cards(h) for h in ('As Kd', '8c 2s', '7h 8h', 'Tc Td')]
+    for n, board in [(2, ''), (3, ''), (4, 'Kc'), (3, 'Kc 6h'), (4, 'Kc 6h 9h')]:
+        board = utils.to_cards(board) if board else []
+        serial = cpoker.full_enumeration(hands[:n], board)
+        for threads in (2, 3, 0):
+            assert cpoker.full_enumeration(hands[:n], board, threads=threads) == serial
+
+
+def test_seeded_monte_carlo():
+    hands = [utils.to_cards(h) for h in ('As Kd', '8c 2s', '7h 8h')]
+    first = cpoker.monte_carlo(hands, 20000, seed=7)
+    assert cpoker.monte_carlo(hands, 20000, seed=7) == first
+    for threads in (2, 3, 0):
+        assert cpoker.monte_carlo(hands, 20000, seed=7, threads=threads) == first
+    assert cpoker.monte_carlo(hands, 20000, seed=8) != first
+    assert cpoker.monte_carlo(hands, 1000, seed=2 ** 64 - 1) != cpoker.monte_carlo(hands, 1000, seed=0)
+    for seed in [-1, 2 ** 64]:
+        assert_raises(OverflowError, lambda: cpoker.monte_carlo(hands, 1000, seed=seed))
+    assert_close(sum(first), 1.0, 1e-9)
+    for ev, exact in zip(first, cpoker.full_enumeration(hands)):
+        assert_close(ev, exact, .02)
+
+
+def test_monte_carlo_board_and_target():
+    hands = [utils.to_cards(h) for h in ('As Kd', '8c 2s', '7h 8h', 'Qc Jc')]
+    board = utils.to_cards('Kc 6h 9h')
+    dead = utils.to_cards('2h 3h')
+    exact = [0.0] * 4
+    live = set(range(52)).difference(sum(hands, board + dead))
+    runouts = list(itertools.combinations(live, 2))
+    for runout in runouts:
+        winners = cpoker.multi_holdem(hands, board + list(runout))
+        for w in winners:
+            exact[w] += 1.0 / len(winners) / len(runouts)
+    evs = cpoker.monte_carlo(hands, 50000, seed=3, board=board, dead=dead)
+    for ev, e in zip(evs, exact):
+        assert_close(ev, e, .01)
+
+    evs, errors, n = cpoker.monte_carlo(hands, 10 ** 7, seed=3, board=board, target_se=.005)
+    assert n < 10 ** 6 and max(errors) <= .005
+    evs, errors, n = cpoker.monte_carlo(hands, 1000, seed=3, board=board, target_se=1e-9)
+    assert n == 1000 and min(errors) > 0
+    for bad in [dict(board=board, dead=board[:1]), dict(target_se=0)]:
+        assert_raises(ValueError, lambda: cpoker.monte_carlo(hands, **bad))
+
+
+def test_range_equity():
+    def weighted(*hands):
+        return dict((tuple(utils.to_cards(h)), w) for h, w in hands)
+
+    ranges = [weighted(('As Kd', 1), ('Ah Ad', .5), ('7h 8h', 2)),
+              weighted(('Ks Kd', 1), ('9c 9d', 1), ('Ah Jh', .3), ('As Ks', 1)),
+              weighted(('Tc Td', 1), ('6c 6d', 1), ('Jh Th', 1))]
+    board = utils.to_cards('Kc 6h 9h')
+    for n, extra in [(2, []), (2, [0]), (2, [0, 51]), (3, []), (3, [1])]:
+        expected = [0.0] * n
+        total = 0.0
+        for combos in itertools.product(*[r.items() for r in ranges[:n]]):
+            hands = [list(hand) for hand, w in combos]
+            if len(set(sum(hands, board + extra))) < 2 * n + len(board + extra):
+                continue
+            weight = 1.0
+            for hand, w in combos:
+                weight *= w
+            if len(extra) < 2:
+                evs = cpoker.full_enumeration(hands, board + extra)
+            else:
+                winners = cpoker.multi_holdem(hands, board + extra)
+                evs = [1.0 / len(winners) if i in winners else 0.0 for i in range(n)]
+            for i in range(n):
+                expected[i] += weight * evs[i]
+            total += weight
+        result = cpoker.range_equity(ranges[:n], board + extra)
+        for r, e in zip(result, expected):
+            assert_close(r, e / total, 1e-9)
+        assert cpoker.range_equity(ranges[:n], board + extra, threads=3) == result
+
+    hands = [utils.to_cards('As Kd'), utils.to_cards('8c 2s')]
+    evs = cpoker.range_equity([{tuple(hands[0]): 1}, {tuple(hands[1]): 1}])
+    for r, e in zip(evs, cpoker.full_enumeration(hands)):
+        assert_close(r, e, 1e-9)
+    full = [1] * 1326
+    assert_close(cpoker.range_equity([full, full], board)[0], .5, 1e-9)
+
+
+def test_hand_strength():
+    hand = utils.to_cards('Ah 9h')
+    board = utils.to_cards('Kh 6h 9c 2d')
+    deck = [c for c in range(52) if c not in hand + board]
+    now = poker_lite.handvalue(hand + board)
+    hs = hs2 = 0.0
+    hp = [[0] * 3 for __ in range(3)]
+    for river in deck:
+        mine = poker_lite.handvalue(hand + board + [river])
+        counts = [0] * 3
+        for opp in itertools.combinations([c for c in deck if c != river], 2):
+            opp = list(opp)
+            c = (now > poker_lite.handvalue(opp + board)) - (now < poker_lite.handvalue(opp + board)) + 1
+            d = (mine > poker_lite.handvalue(opp + board + [river])) - \
+                (mine < poker_lite.handvalue(opp + board + [river])) + 1
+            hp[c][d] += 1
+            counts[d] += 1
+        ev = (counts[2] + .5 * counts[1]) / sum(counts)
+        hs += ev
+        hs2 += ev * ev
+    tot = [sum(row) for row in hp]
+    expected = ((tot[2] + .5 * tot[1]) / sum(tot), hs / len(deck), hs2 / len(deck),
+                (hp[0][2] + .5 * hp[0][1] + .5 * hp[1][2]) / (tot[0] + .5 * tot[1]),
+                (hp[2][0] + .5 * hp[2][1] + .5 * hp[1][0]) / (tot[2] + .5 * tot[1]))
+    result = cpoker.hand_strength(hand, board)
+    for r, e in zip(result, expected):
+        assert_close(r, e, 1e-9)
+
+    index = list(itertools.combinations(range(52), 2)).index(tuple(sorted(hand)))
+    strengths = cpoker.hand_strengths(board)
+    assert strengths[index] == result
+    assert strengths.count(None) == 1326 - 1128
+    assert cpoker.hand_strengths(board, threads=3) == strengths
+    board = board + [0]
+    assert cpoker.hand_strengths(board)[index] == cpoker.hand_strength(hand, board)
+    assert_close(cpoker.hand_strength(hand, board)[0], cpoker.rivervalue(hand, board), 1e-9)
+
+
+def test_ochs():
+    hand_values = [(a * 7 + b) % 40 for a in range(52) for b in range(a + 1, 52)]
+    grouping = cpoker.HandGrouping(hand_values)
+    assert grouping.ngroups == 40
+    hand, board = utils.to_cards('Qs Qd'), utils.to_cards('2c 7d 9h Js')
+    combos = list(itertools.combinations(range(52), 2))
+    for group in [-1, 1326, 2 ** 31, 2 ** 40, 2 ** 64]:
+        values = [group] + hand_values[1:]
+        assert_raises(ValueError, lambda: cpoker.HandGrouping(values))
+        assert_raises(ValueError, lambda: cpoker.HandGrouping(dict(zip(combos, values))))
+    points, opponents = [0] * 40, [0] * 40
+    for river in range(52):
+        if river in hand + board:
+            continue
+        cards = hand + board + [river]
+        histogram = cpoker.river_distribution(hand, board + [river], grouping)
+        assert histogram == cpoker.river_distribution(hand, board + [river], hand_values)
+        for group, p in enumerate(histogram):
+            points[group] += p
+        for combo, group in zip(combos, hand_values):
+            if not set(combo) & set(cards):
+                opponents[group] += 1
+    for result, p, n in zip(grouping.ochs(hand, board), points, opponents):
+        assert_close(result, p / (2.0 * n), 1e-12)
+
+    hands = [list(c) for c in combos[::50]] + [hand, [board[0], 0]]
+    many = grouping.ochs_many(hands, board[:3])
+    assert many[-2] == grouping.ochs(hand, board[:3])
+    assert repr(grouping.ochs_many(hands, board[:3], threads=3)) == repr(many)
+    assert repr(many[-1]) == repr([float('nan')] * 40)
+
+
+def test_card_abstraction():
+    import os
+    import shutil
+    import tempfile
+
+    directory = tempfile.mkdtemp()
+    histograms = os.path.join(directory, 'flop.hst')
+    buckets = [os.path.join(directory, 'flop%i.bkt' % i) for i in range(2)]
+    try:
+        assert cpoker.save_histograms(histograms, 3, bins=10, first=20, count=6, threads=2) == 6
+        assert_raises(ValueError,
+                      lambda: cpoker.save_histograms(histograms, 3, first=cpoker.board_classes(3) + 1))
+        distance = cpoker.cluster_histograms(histograms, buckets[0], 5, seed=7, threads=1)
+        assert cpoker.cluster_histograms(histograms, buckets[1], 5, seed=7, threads=3) == distance
+        with open(buckets[0], 'rb') as f, open(buckets[1], 'rb') as g:
+            assert f.read() == g.read()
+        table = cpoker.BucketTable(buckets[0])
+    finally:
+        shutil.rmtree(directory)
+    assert (table.nbuckets, table.street) == (5, 3)
+
+    #relabeling the suits of a hand and board keeps its bucket, and hands
+    #with the same histogram on a board share one
+    boards = [list(b) for b in itertools.combinations(range(52), 3)
+              if 20 <= cpoker.board_class(list(b)) < 26]
+    assert len(boards) == 64
+    combos = list(itertools.combinations(range(52), 2))
+    relabel = lambda cards, perm: [c & ~3 | perm[c & 3] for c in cards]
+    board = boards[0]
+    seen = {}
+    for combo, histogram in zip(combos, cpoker.equity_histograms(board, 10)):
+        if histogram is None:
+            continue
+        bucket = table.lookup(list(combo), board)
+        assert seen.setdefault(tuple(histogram), bucket) == bucket
+        for perm in itertools.permutations(range(4)):
+            assert table.lookup(relabel(combo, perm), relabel(board, perm)) == bucket
+    for board in boards[1::7]:
+        for combo in combos[::11]:
+            if not set(combo) & set(board):
+                assert 0 <= table.lookup(list(combo), board) < 5
+    assert_raises(ValueError, lambda: table.lookup([0, 5], [8, 12, 16]))
+    for bins in [0, 1025, 2 ** 20]:
+        assert_raises(ValueError, lambda: cpoker.equity_histograms(board, bins))
+
+
+def test_omaha():
+    def omaha_value(hole, board):
+        return max(five_value(h + b) for h in itertools.combinations(hole, 2)
+                   for b in itertools.combinations(board, 3))
+
+    #ranks order hands like the best of 2 hole and 3 board cards, with a
+    #suited board most of the time so flushes come up
+    previous = None
+    for i in range(2000):
+        nhole, nboard = 4 + i % 2, 3 + i % 3
+        suited = random.sample([c for c in range(52) if c & 3 == i & 3], 3)
+        cards = suited + random.sample([c for c in range(52) if c not in suited], nhole + nboard - 3)
+        random.shuffle(cards)
+        hole, board = cards[:nhole], cards[nhole:]
+        current = (cpoker.omaha_rank(hole, board), omaha_value(hole, board))
+        if previous:
+            assert (current[0] > previous[0]) == (current[1] > previous[1])
+            assert (current[0] == previous[0]) == (current[1] == previous[1])
+        previous = current
+
+    hands = [[0, 5, 10, 15], [20, 25, 30, 35], [1, 2, 3, 6]]
+    board = [40, 44, 48, 51]
+    shares = [0.0] * 3
+    live = [c for c in range(52) if c not in sum(hands, []) + board]
+    for card in live:
+        values = [omaha_value(hand, board + [card]) for hand in hands]
+        winners = cpoker.multi_omaha(hands, board + [card])
+        assert winners == [i for i, v in enumerate(values) if v == max(values)]
+        for i in winners:
+            shares[i] += 1.0 / len(winners)
+    for a, b in zip(cpoker.omaha_enumeration(hands, board), shares):
+        assert_close(a, b / len(live), 1e-12)
+
+    plo5 = [[0, 5, 10, 15, 19], [20, 25, 30, 35, 38]]
+    exact = cpoker.omaha_enumeration(plo5, [40, 44, 49])
+    assert cpoker.omaha_enumeration(plo5, [40, 44, 49], threads=3) == exact
+    evs, stderrs, n = cpoker.omaha_monte_carlo(plo5, 20000, seed=1, board=[40, 44, 49], target_se=1.0)
+    assert_close(evs[0], exact[0], 5 * stderrs[0])
+    for bad in [lambda: cpoker.omaha_rank([0, 1, 2], [4, 5, 6]),
+                lambda: cpoker.omaha_enumeration([[0, 1, 2, 3], [3, 4, 5, 6]]),
+                lambda: cpoker.omaha_monte_carlo([[0, 1, 2, 3], [4, 5, 6, 7, 8]])]:
+        assert_raises((ValueError, TypeError), bad)
+
+
+def test_best5():
+    import array
+
+    def best_value(cards):
+        return max(five_value(list(h)) for h in itertools.combinations(cards, 5))
+
+    #every 5 card rank class gets its own value, from 1 up
+    every = array.array('B', itertools.chain.from_iterable(itertools.combinations(range(52), 5)))
+    assert sorted(set(cpoker.best5_ranks(every, 5))) == list(range(1, 7463))
+    assert cpoker.best5_rank([0, 4, 8, 12, 16]) == 7462
+    assert cpoker.best5_rank([28, 37, 42, 47, 48]) == 1
+
+    #5, 6 and 7 cards order like the best 5 of them, flushes often
+    for n in (5, 6, 7):
+        hands = []
+        for i in range(1500):
+            suited = random.sample([c for c in range(52) if c & 3 == i & 3], 3 + i % 3)
+            hand = suited + random.sample([c for c in range(52) if c not in suited], n - len(suited))
+            random.shuffle(hand)
+            hands.append(hand)
+        ranks = cpoker.best5_ranks(array.array('B', sum(hands, [])), n)
+        assert list(ranks) == [cpoker.best5_rank(h) for h in hands]
+        keyed = sorted(zip(ranks, (best_value(h) for h in hands)))
+        for a, b in zip(keyed, keyed[1:]):
+            assert (a[0] == b[0]) == (a[1] == b[1])
+            assert a[0] > b[0] or a[1] <= b[1]
+
+    #omaha hands are the best 5 of each two and three
+    hole, board = [0, 5, 10, 15], [20, 25, 30, 35, 40]
+    assert cpoker.omaha_rank(hole, board) == max(cpoker.best5_rank(list(h + b))
+        for h in itertools.combinations(hole, 2) for b in itertools.combinations(board, 3))
+
+    for bad in [lambda: cpoker.best5_rank([0, 1, 2, 3]),
+                lambda: cpoker.best5_rank([0, 1, 2, 3, 3]),
+                lambda: cpoker.best5_rank([0, 1, 2, 3, 52]),
+                lambda: cpoker.best5_ranks(array.array('B', [0, 1, 2, 3, 3]), 5),
+                lambda: cpoker.best5_ranks(array.array('B', range(8)), 4)]:
+        assert_raises((ValueError, TypeError), bad)
+
+
+def test_short_deck():
+    def short_value(cards):
+        #five_value with A-6-7-8-9 the low straight and flushes over boats
+        ranks = sorted((8 - (c >> 2) for c in cards), reverse=True)
+        counts = collections.Counter(ranks)
+        groups = sorted(counts.items(), key=lambda rc: (rc[1], rc[0]), reverse=True)
+        shape, order = [n for r, n in groups], [r for r, n in groups]
+        flush = len(set(c & 3 for c in cards)) == 1
+        wheel = ranks == [8, 3, 2, 1, 0]
+        if len(counts) == 5 and (ranks[0] - ranks[4] == 4 or wheel):
+            return (8 if flush else 4, [3 if wheel else ranks[0]])
+        if flush:
+            return (6, order)
+        return ({(4, 1): 7, (3, 2): 5, (3, 1, 1): 3, (2, 2, 1): 2, (2, 1, 1, 1): 1}.get(tuple(shape), 0), order)
+
+    def best_value(cards):
+        return max(short_value(h) for h in itertools.combinations(cards, 5))
+
+    hands = []
+    for i in range(3000):
+        suited = random.sample([c for c in range(36) if c & 3 == i & 3], i % 6)
+        hands.append(suited + random.sample([c for c in range(36) if c not in suited], 7 - len(suited)))
+    keyed = sorted((cpoker.short_rank(h), best_value(h)) for h in hands)
+    for a, b in zip(keyed, keyed[1:]):
+        assert (a[0] == b[0]) == (a[1] == b[1])
+        assert a[0] > b[0] or a[1] <= b[1]
+    #the wheel and a flush over a full house
+    assert cpoker.short_rank([0, 21, 25, 29, 33, 4, 8]) > cpoker.short_rank([1, 21, 25, 29, 6, 10, 14])
+    assert cpoker.short_rank([0, 4, 12, 16, 28, 9, 13]) > cpoker.short_rank([1, 2, 3, 5, 6, 20, 25])
+
+    hands, board = [[0, 5], [20, 25], [13, 14]], [8, 28, 33, 35]
+    shares = [0.0] * 3
+    live = [c for c in range(36) if c not in sum(hands, []) + board]
+    for card in live:
+        ranks = [cpoker.short_rank(h + board + [card]) for h in hands]
+        for i, rank in enumerate(ranks):
+            if rank == max(ranks):
+                shares[i] += 1.0 / ranks.count(rank)
+    for a, b in zip(cpoker.short_enumeration(hands, board), shares):
+        assert_close(a, b / len(live), 1e-12)
+    exact = cpoker.short_enumeration(hands[:2])
+    assert cpoker.short_enumeration(hands[:2], threads=3) == exact
+    evs, stderrs, n = cpoker.short_monte_carlo(hands[:2], 20000, seed=1, target_se=1.0)
+    assert_close(evs[0], exact[0], 5 * stderrs[0])
+
+    hand, board = [0, 5], [8, 28, 33, 35, 13]
+    wins = ties = 0
+    for opp in itertools.combinations([c for c in range(36) if c not in hand + board], 2):
+        mine, theirs = cpoker.short_rank(hand + board), cpoker.short_rank(list(opp) + board)
+        wins += mine > theirs
+        ties += mine == theirs
+    assert_close(cpoker.short_rivervalue(hand, board), (wins + ties / 2.0) / 406, 1e-12)
+    for bad in [lambda: cpoker.short_rank([0, 1, 2, 3, 4, 5, 36]),
+                lambda: cpoker.short_enumeration([[0, 1], [2, 40]]),
+                lambda: cpoker.short_monte_carlo([[0, 1], [1, 2]])]:
+        assert_raises(ValueError, bad)
+
+
+def test_hilo():
+    import array
+
+    def low_value(cards):
+        #the 5 lowest different ranks, A to 8, highest first, or None
+        ranks = sorted(set(1 if c < 4 else 14 - (c >> 2) for c in cards if c < 4 or c >= 24))
+        return tuple(reversed(ranks[:5])) if len(ranks) >= 5 else None
+
+    def check(pairs):
+        #lower low_values are better lows
+        pairs.sort(key=lambda p: p[0])
+        for (a, x), (b, y) in zip(pairs, pairs[1:]):
+            assert (a == 0) == (x is None)
+            if x and y:
+                assert (a == b) == (x == y) and (a < b) == (x > y)
+
+    for n in (5, 6, 7):
+        hands = [random.sample(range(52), n) for i in range(2000)]
+        lows = cpoker.low_ranks(array.array('B', sum(hands, [])), n)
+        assert list(lows) == [cpoker.low_rank(h) for h in hands]
+        check([(low, low_value(h)) for low, h in zip(lows, hands)])
+    assert cpoker.low_rank([0, 48, 44, 40, 36, 1, 2]) == 56
+    assert cpoker.low_rank([24, 28, 32, 36, 40]) == 1
+    assert cpoker.low_rank([0, 4, 8, 12, 16]) == 0
+
+    def omaha_low(hole, board):
+        lows = [low_value(h + b) for h in itertools.combinations(hole, 2)
+                for b in itertools.combinations(board, 3)]
+        lows = [low for low in lows if low]
+        return min(lows) if lows else None
+
+    pairs = []
+    for i in range(1000):
+        cards = random.sample(range(52), 9)
+        pairs.append((cpoker.omaha_low(cards[:4], cards[4:]), omaha_low(cards[:4], cards[4:])))
+    check(pairs)
+
+    #one pass over the runouts matches the winners of each board
+    hands = [[0, 45, 50, 30], [1, 46, 49, 5], [20, 24, 28, 32]]
+    board = [48, 41, 13, 2]
+    totals = [[0.0] * 4 for hand in hands]
+    live = [c for c in range(52) if c not in sum(hands, []) + board]
+    for card in live:
+        his, los = cpoker.multi_omaha_hilo(hands, board + [card])
+        assert his == cpoker.multi_omaha(hands, board + [card])
+        for i in his:
+            totals[i][0] += (0.5 if los else 1.0) / len(his)
+            totals[i][1] += 1.0 / len(his)
+        for i in los:
+            totals[i][0] += 0.5 / len(los)
+            totals[i][2] += 1.0 / len(los)
+        if len(his) == 1 and (not los or los == his):
+            totals[his[0]][3] += 1
+    for result, total in zip(cpoker.omaha_hilo_enumeration(hands, board), totals):
+        for a, b in zip(result, total):
+            assert_close(a, b / len(live), 1e-12)
+
+    results = cpoker.omaha_hilo_enumeration(hands, board[:3])
+    assert cpoker.omaha_hilo_enumeration(hands, board[:3], threads=3) == results
+    assert_close(sum(r[0] for r in results), 1.0, 1e-12)
+    assert_close(sum(r[1] for r in results), 1.0, 1e-12)
+    for bad in [lambda: cpoker.low_rank([0, 1, 2, 3]),
+                lambda: cpoker.low_rank([0, 1, 2, 3, 3]),
+                lambda: cpoker.omaha_hilo_enumeration([[0, 1, 2, 3], [3, 4, 5, 6]])]:
+        assert_raises(ValueError, bad)
+
+
+def test_isomorphism():
+    import array
+
+    sizes = [cpoker.iso_size(street) for street in (0, 3, 4, 5)]
+    assert sizes == [169, 1286792, 13960050, 123156254]
+    combos = [list(c) for c in itertools.combinations(range(52), 2)]
+    assert sorted(set(cpoker.iso_index(c, []) for c in combos)) == list(range(169))
+
+    #suits and the order within the hole cards and board don't matter,
+    #and unindexing gives back a hand with the same index
+    relabel = lambda cards, perm: [c & ~3 | perm[c & 3] for c in cards]
+    rows = []
+    for street in (3, 4, 5):
+        for __ in range(50):
+            cards = utils.deal(2 + street)
+            hand, board = cards[:2], cards[2:]
+            index = cpoker.iso_index(hand, board)
+            for perm in itertools.permutations(range(4)):
+                assert cpoker.iso_index(relabel(hand[::-1], perm), relabel(board[::-1], perm)) == index
+            assert cpoker.iso_index(*cpoker.iso_unindex(index, street)) == index
+            if street == 5:
+                rows += cards
+        for index in [0, sizes[street - 2] - 1] + [random.randrange(sizes[street - 2]) for __ in range(200)]:
+            hand, board = cpoker.iso_unindex(index, street)
+            assert cpoker.iso_index(hand, board) == index
+
+    indices = cpoker.iso_indices(array.array('B', rows), 5)
+    assert list(indices) == [cpoker.iso_index(rows[i:i + 2], rows[i + 2:i + 7])
+                             for i in range(0, len(rows), 7)]
+    for bad in [lambda: cpoker.iso_index([0, 0], []), lambda: cpoker.iso_index([0, 1], [2]),
+                lambda: cpoker.iso_unindex(169, 0), lambda: cpoker.iso_unindex(sizes[3], 5),
+                lambda: cpoker.iso_indices(bytearray(7), 5)]:
+        assert_raises(ValueError, bad)
+    for index in [-1, 2 ** 64 + 5]:
+        assert_raises(OverflowError, lambda: cpoker.iso_unindex(index, 5))
+
+
+def test_fast_calls():
+    hand, board = [0, 5], [8, 12, 16, 20, 45]
+    assert cpoker.holdem2p(hand1=hand, hand2=[48, 49], board=board) == \
+        cpoker.holdem2p(hand, [48, 49], board)
+    assert cpoker.rivervalue(hand, board, True) == cpoker.rivervalue(hand, board, optimistic=1)
+    assert cpoker.handvalue(hand=hand + board) == cpoker.handvalue(hand + board)
+    for bad in [lambda: cpoker.holdem2p(hand, [48, 49]),
+                lambda: cpoker.handvalue(hand + board, 1),
+                lambda: cpoker.riverties(hand, board=board, hand=hand),
+                lambda: cpoker.best5_rank(card=hand + board)]:
+        assert_raises(TypeError, bad)
+
+
+def test_stats():
+    cpoker.reset_stats()
+    if cpoker.stats() is None:
+        return
+    hands, board = [[0, 5], [48, 49]], [8, 12, 16, 20]
+    cpoker.handvalue([0, 5, 8, 12, 16, 20, 45])
+    cpoker.holdem2p(hands[0], hands[1], board + [45])
+    cpoker.full_enumeration(hands, board)
+    stats = cpoker.stats()
+    assert stats['calls']['handvalue'] == 1 and stats['hands_given']['handvalue'] == 1
+    assert stats['calls']['holdem2p'] == 1 and stats['hands_given']['holdem2p'] == 2
+    assert stats['hands_given']['full_enumeration'] == 2
+    assert sum(stats['latency']['full_enumeration']) == 1
+    assert 2 < stats['ranked'] <= 2 + 44 * 2
+    assert 0 <= stats['flush_ratio'] <= 1
+    cpoker.omaha_enumeration([[0, 5, 10, 15], [20, 25, 30, 35]], [8, 12, 16, 40])
+    cpoker.short_monte_carlo([[0, 5], [20, 25]], 1000, seed=1)
+    stats = cpoker.stats()
+    assert stats['hands_given']['omaha_enumeration'] == 2
+    assert stats['hands_given']['short_monte_carlo'] == 2
+    cpoker.reset_stats()
+    assert cpoker.stats()['calls']['handvalue'] == 0
+
+
+def test_python_threads():
+    hands = [utils.to_cards(h) for h in ('As Kd', '8c 2s', '7h 8h')]
+    board = utils.to_cards('Kc 6h')
+    hand, river = utils.to_cards('Qs Qd'), utils.to_cards('2c 7d 9h Js Ad')
+    hand_values = [(a + b) % 4 for a in range(52) for b in range(a + 1, 52)]
+    serial = cpoker.full_enumeration(hands, board)
+    histogram = cpoker.river_distribution(hand, river, hand_values)
+    results = []
+
+    def run():
+        results.append(cpoker.full_enumeration(hands, board) == serial)
+        results.append(len(cpoker.monte_carlo(hands, 1000)) == 3)
+        results.append(cpoker.river_distribution(hand, river, hand_values) == histogram)
+
+    threads = [threading.Thread(target=run) for i in range(4)]
+    for t in threads:
+        t.start()
+    for t in threads:
+        t.join()
+    assert results == [True] * 12
+
+
 def test_crivervalue():
     f = utils.pretty_args(cpoker.rivervalue)
     assert_close(f('2d 6d', 'Tc Ts 8s 6c 5s'), 0.620202020202)
@@ -193,6 +779,155 @@ def test_crivervalue():
     assert_close(f('Ac Qc', '4d 9d 4h 5h 4c'), 0.638888888889)
     assert_close(f('3c 9c', 'Ac 7s Ah Qc As'), 0.257070707071)
 
+def test_handranks():
+    import array
+
+    hands = [utils.deal(7) for __ in range(500)]
+    ranks = cpoker.handranks(array.array('B', sum(hands, [])))
+    assert len(ranks) == len(hands)
+
+    values = [cpoker.handvalue(h) for h in hands]
+    for i in range(1, len(hands)):
+        a, b = values[i - 1], values[i]
+        c, d = ranks[i - 1], ranks[i]
+        assert (a > b) == (c > d) and (a == b) == (c == d)
+
+    out = array.array('H', [0] * len(hands))
+    holes = array.array('i', sum([h[:2] for h in hands], []))
+    boards = array.array('q', sum([h[2:] for h in hands], []))
+    assert cpoker.holdem_handranks(holes, boards, out=out) is out
+    assert out == ranks
+    assert cpoker.handranks(bytearray(sum(hands, [])[:7])) == ranks[:1]
+
+    for bad in [bytearray([1, 2, 3]), bytearray([1, 2, 3, 4, 5, 6, 52]),
+                bytearray([1, 2, 3, 4, 5, 6, 1]), array.array('d', range(7))]:
+        assert_raises((ValueError, TypeError), lambda: cpoker.handranks(bad))
+    assert_raises(ValueError, lambda: cpoker.handranks(bytearray(7), out=array.array('i', [0])))
+
+
+def test_buffer_arguments():
+    import array
+
+    hands, board = [[0, 1], [4, 8], [20, 30]], [12, 13, 14, 40, 41]
+    flat = array.array('i', sum(hands, []))
+    rows = memoryview(flat).cast('B').cast('i', [3, 2])
+    evs = cpoker.full_enumeration(hands, board[:3])
+    for h in (flat, rows, tuple(map(tuple, hands)), [array.array('q', h) for h in hands]):
+        assert cpoker.full_enumeration(h, bytes(board[:3])) == evs
+    out = array.array('d', [0.0] * 3)
+    assert cpoker.full_enumeration(rows, board[:3], out=out) is out
+    assert list(out) == evs
+
+    evs = cpoker.monte_carlo(hands, 2000, seed=7)
+    assert cpoker.monte_carlo(rows, 2000, seed=7, out=out) is out
+    assert list(out) == evs
+
+    winners = cpoker.multi_holdem(hands, board)
+    assert cpoker.multi_holdem(rows, array.array('B', board)) == winners
+    out = array.array('i', [-1] * 3)
+    assert cpoker.multi_holdem(flat, tuple(board), out=out) == len(winners)
+    assert list(out[:len(winners)]) == winners
+
+    assert cpoker.rivervalue(bytes(hands[0]), tuple(board)) == cpoker.rivervalue(hands[0], board)
+
+    groups = [i % 3 for i in range(1326)]
+    chart = cpoker.river_distribution(hands[0], board, groups)
+    out = array.array('i', [7] * 3)
+    assert cpoker.river_distribution(bytes(hands[0]), tuple(board), out=out) is out
+    assert list(out) == chart
+
+    class BadCard(object):
+        def __index__(self):
+            raise ValueError
+
+    for bad in [lambda: cpoker.full_enumeration(rows, out=array.array('d', [0.0])),
+                lambda: cpoker.full_enumeration(rows, out=array.array('f', [0.0] * 3)),
+                lambda: cpoker.full_enumeration(bytes([0, 1, 2])),
+                lambda: cpoker.rivervalue(bytes([0, 52]), board),
+                lambda: cpoker.holdem2p([0, 5], [48, 49], board[:4] + [-1]),
+                lambda: cpoker.holdem2p([0, 5], [48, 49], board[:4] + [10 ** 9]),
+                lambda: cpoker.holdem2p([0, 5], [48, 49], board[:4] + [BadCard()])]:
+        assert_raises(ValueError, bad)
+
+
+def test_table_file():
+    import os
+    import tempfile
+
+    hands = [utils.to_cards(h) for h in ('As Kd', '8c 2s', '7h 8h')]
+    board = utils.to_cards('Kc 6h 9h')
+    before = cpoker.full_enumeration(hands, board)
+
+    fd, path = tempfile.mkstemp()
+    os.close(fd)
+    try:
+        cpoker.save_tables(path)
+        for prefault, hugepages in [(0, 0), (1, 0), (0, 1)]:
+            assert cpoker.load_tables(path, prefault, hugepages)
+            assert cpoker.full_enumeration(hands, board) == before
+        #later loads are only checked, leaving no more mappings behind
+        if os.path.exists('/proc/self/maps'):
+            with open('/proc/self/maps') as f:
+                assert f.read().count(path) <= 1
+
+        with open(path, 'r+b') as f:
+            f.seek(8192)
+            byte = f.read(1)
+            f.seek(8192)
+            f.write(bytes(bytearray([ord(byte) ^ 1])))
+        assert not cpoker.load_tables(path)
+        assert not cpoker.load_tables(path + '.missing')
+        assert cpoker.full_enumeration(hands, board) == before
+    finally:
+        os.remove(path)
+
+
+def test_preflop_table():
+    import os
+    import tempfile
+
+    fd, path = tempfile.mkstemp()
+    os.close(fd)
+    try:
+        with open(path, 'wb') as f:
+            f.write(b'POKYRPRE' + bytes(bytearray(100)))
+        assert not cpoker.load_preflop_table(path)
+        assert not cpoker.load_preflop_table(path + '.missing')
+    finally:
+        os.remove(path)
+
+    # building a whole table takes minutes, so check one given to us and
+    # otherwise one of a few matchups
+    if os.environ.get('POKYR_PREFLOP_FILE'):
+        for i in range(3):
+            hands = utils.deal([2, 2])
+            exact = cpoker.range_equity([{tuple(hands[0]): 1}, {tuple(hands[1]): 1}])
+            assert cpoker.preflop_equity(*hands) == cpoker.full_enumeration(hands)[0]
+            assert_close(cpoker.preflop_equity(*hands), exact[0], 1e-12)
+        return
+
+    matchups = [([0, 5], [48, 49]), ([8, 12], [9, 13]), ([20, 21], [0, 4])]
+    expected = [cpoker.full_enumeration(list(m))[0] for m in matchups]
+    fd, path = tempfile.mkstemp()
+    os.close(fd)
+    try:
+        cpoker.save_preflop_table(path, threads=2, matchups=matchups)
+        assert cpoker.load_preflop_table(path)
+    finally:
+        os.remove(path)
+    for (h1, h2), ev in zip(matchups, expected):
+        assert cpoker.preflop_equity(h1, h2) == ev
+        # the same class with the suits relabeled and the hands swapped
+        relabel = lambda hand: [c & ~3 | (c + 1) & 3 for c in hand]
+        assert_close(cpoker.preflop_equity(relabel(h2), relabel(h1)), 1 - ev, 1e-12)
+        assert cpoker.full_enumeration([h1, h2])[0] == ev
+    for bad in [lambda: cpoker.preflop_equity([0, 5], [44, 45]),
+                lambda: cpoker.save_preflop_table(path, matchups=[([0, 5], [5, 6])])]:
+        assert_raises(ValueError, bad)
+    exact = cpoker.range_equity([{(0, 5): 1}, {(44, 45): 1}])[0]
+    assert_close(cpoker.full_enumeration([[0, 5], [44, 45]])[0], exact, 1e-12)
+
+
 def main():
     for name, f in globals().items():
         if name.startswith('test'):
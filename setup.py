@@ -14,16 +14,41 @@ if not os.path.exists(os.path.join("src", "cpokertables.h")):
     poker_lite.write_ctables(os.path.join("src", "cpokertables.h"))
 
 sources = [
+    'src/abstraction.c',
+    'src/best5.c',
     'src/build_table.c',
+    'src/compact_table.c',
     'src/cpokermod.c',
     'src/deal.c',
+    'src/isomorphism.c',
+    'src/low.c',
+    'src/omaha.c',
     'src/poker_heavy.c',
-    'src/poker_lite.c'
+    'src/poker_lite.c',
+    'src/preflop.c',
+    'src/rank_keys.c',
+    'src/short_deck.c',
+    'src/stats.c',
+    'src/table_file.c',
+    'src/tasks.c'
 ]
 
+# POKYR_COMPACT_RANKS=1 builds dohand against the 160KB hashed rank
+# table rather than the 15MB direct one
+define_macros = []
+if os.environ.get("POKYR_COMPACT_RANKS", "0") != "0":
+    define_macros.append(('COMPACT_RANKS', '1'))
+# POKYR_STATS=1 builds in the counters cpoker.stats reads
+if os.environ.get("POKYR_STATS", "0") != "0":
+    define_macros.append(('COLLECT_STATS', '1'))
+
 module = Extension(
     'poker.cpoker',
-    sources=sources
+    sources=sources,
+    define_macros=define_macros,
+    libraries=['m'],
+    extra_compile_args=['-pthread'],
+    extra_link_args=['-pthread']
 )
 
 long_description = "README at https://github.com/cleverpiggy/pokyr"
@@ -0,0 +1,752 @@
+// Copyright 2013 Allen Boyd Cunningham
+
+// This file is part of pokyr.
+
+//     pokyr is free software: you can redistribute it and/or modify
+//     it under the terms of the GNU General Public License as published by
+//     the Free Software Foundation, either version 3 of the License, or
+//     (at your option) any later version.
+//     pokyr is distributed in the hope that it will be useful,
+//     but WITHOUT ANY WARRANTY; without even the implied warranty of
+//     MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//     GNU General Public License for more details.
+
+//     You should have received a copy of the GNU General Public License
+//     along with pokyr.  If not, see <http://www.gnu.org/licenses/>.
+
+
+#include "poker_heavy.h"
+
+#include <math.h>
+#include <pthread.h>
+#include <string.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+//the card abstraction pipeline: save_histograms writes the equity
+//histogram of every hand on every board class of a street,
+//cluster_histograms buckets them with k-means and writes a bucket
+//table, and bucket_lookup finds any hand and board's bucket in it.
+//
+//Two boards are in the same class when relabeling suits turns one into
+//the other.  A class is named by the board with the smallest colex
+//index over the 24 relabelings, so walking the boards in colex order
+//meets each class's own board first.  Every board keeps its class and a
+//relabeling that takes it to the class's board.  A class's hands are
+//the combos its board leaves, in GET_INDEX order, and a hand relabeled
+//with its board lands on one whose histogram is the same.
+
+static const uint8_t Perms[24][4] = {
+    {0,1,2,3}, {0,1,3,2}, {0,2,1,3}, {0,2,3,1}, {0,3,1,2}, {0,3,2,1},
+    {1,0,2,3}, {1,0,3,2}, {1,2,0,3}, {1,2,3,0}, {1,3,0,2}, {1,3,2,0},
+    {2,0,1,3}, {2,0,3,1}, {2,1,0,3}, {2,1,3,0}, {2,3,0,1}, {2,3,1,0},
+    {3,0,1,2}, {3,0,2,1}, {3,1,0,2}, {3,1,2,0}, {3,2,0,1}, {3,2,1,0}
+};
+
+typedef struct{
+    int nclasses;
+    uint32_t *boards;       //each class's board, 6 bits a card, lowest first
+    uint32_t *weights;      //the boards in each class
+    uint32_t *classes;      //class << 5 | relabeling, by colex index
+}street;
+
+static street *Streets[3];
+static pthread_mutex_t Streets_Lock = PTHREAD_MUTEX_INITIALIZER;
+static uint32_t Choose[53][6];
+
+#define COLEX(c, n) (Choose[(c)[0]][1] + Choose[(c)[1]][2] + Choose[(c)[2]][3] + \
+                     ((n) > 3 ? Choose[(c)[3]][4] : 0) + ((n) > 4 ? Choose[(c)[4]][5] : 0))
+
+
+//relabel the suits of n cards by perm and sort them
+static void relabel(const uint32_t cards[], int n, const uint8_t perm[4], uint32_t out[]){
+    int i, j;
+    uint32_t c;
+
+    for (i = 0; i < n; i++){
+        c = (cards[i] & ~3u) | perm[cards[i] & 3];
+        for (j = i; j > 0 && out[j - 1] > c; j--)
+            out[j] = out[j - 1];
+        out[j] = c;
+    }
+}
+
+
+static street *build_street(int nboard){
+    uint32_t cards[5], canon[5], total, index, best, colex, class;
+    int i, p, bestperm = 0;
+    street *s;
+
+    //set before the first street is published, so readers see it
+    for (i = 0; !Choose[52][0] && i < 53; i++){
+        Choose[i][0] = 1;
+        for (p = 1; p < 6; p++)
+            Choose[i][p] = i ? Choose[i - 1][p - 1] + Choose[i - 1][p] : 0;
+    }
+    total = Choose[52][nboard];
+    if ( (s = (street *) calloc(1, sizeof(street))) == NULL )
+        return NULL;
+    s->classes = (uint32_t *) malloc(total * sizeof(uint32_t));
+    s->boards = (uint32_t *) malloc(total * sizeof(uint32_t));
+    s->weights = (uint32_t *) calloc(total, sizeof(uint32_t));
+    if (!s->classes || !s->boards || !s->weights){
+        free(s->classes);
+        free(s->boards);
+        free(s->weights);
+        free(s);
+        return NULL;
+    }
+
+    for (i = 0; i < nboard; i++)
+        cards[i] = i;
+    for (index = 0; index < total; index++){
+        best = total;
+        for (p = 0; p < 24; p++){
+            relabel(cards, nboard, Perms[p], canon);
+            if ( (colex = COLEX(canon, nboard)) < best ){
+                best = colex;
+                bestperm = p;
+            }
+        }
+        if (best == index){
+            class = s->nclasses++;
+            for (i = 0, s->boards[class] = 0; i < nboard; i++)
+                s->boards[class] |= cards[i] << (6 * i);
+        }
+        else
+            class = s->classes[best] >> 5;
+        s->classes[index] = class << 5 | bestperm;
+        s->weights[class]++;
+
+        //the next board in colex order
+        for (i = 0; i < nboard - 1 && cards[i] + 1 == cards[i + 1]; i++)
+            cards[i] = i;
+        cards[i]++;
+    }
+    s->boards = (uint32_t *) realloc(s->boards, s->nclasses * sizeof(uint32_t));
+    s->weights = (uint32_t *) realloc(s->weights, s->nclasses * sizeof(uint32_t));
+    return s;
+}
+
+
+static street *get_street(int nboard){
+    street *s;
+
+    if (nboard < 3 || nboard > 5)
+        return NULL;
+    if ( (s = __atomic_load_n(&Streets[nboard - 3], __ATOMIC_ACQUIRE)) != NULL )
+        return s;
+    pthread_mutex_lock(&Streets_Lock);
+    if ( (s = Streets[nboard - 3]) == NULL && (s = build_street(nboard)) != NULL )
+        __atomic_store_n(&Streets[nboard - 3], s, __ATOMIC_RELEASE);
+    pthread_mutex_unlock(&Streets_Lock);
+    return s;
+}
+
+
+//the number of board classes of nboard cards, with each class's board
+//(6 bits a card, lowest first) and count of boards
+int board_classes(int nboard, const uint32_t **boards, const uint32_t **weights){
+    street *s;
+
+    if ( (s = get_street(nboard)) == NULL )
+        return FAIL;
+    if (boards)
+        *boards = s->boards;
+    if (weights)
+        *weights = s->weights;
+    return s->nclasses;
+}
+
+
+//the class of a board of nboard cards, relabeling hand (if given) the
+//same way onto the class's board
+//Return FAIL for bad or duplicate cards
+int board_class(const uint32_t board[], int nboard, uint32_t hand[2]){
+    static const uint8_t same[4] = {0, 1, 2, 3};
+    uint32_t cards[5], entry;
+    const uint8_t *perm;
+    street *s;
+    int i;
+
+    if ( (s = get_street(nboard)) == NULL )
+        return FAIL;
+    for (i = 0; i < nboard; i++){
+        if (board[i] > 51)
+            return FAIL;
+    }
+    relabel(board, nboard, same, cards);
+    for (i = 1; i < nboard; i++){
+        if (cards[i] == cards[i - 1])
+            return FAIL;
+    }
+    entry = s->classes[COLEX(cards, nboard)];
+    if (hand){
+        perm = Perms[entry & 31];
+        hand[0] = (hand[0] & ~3u) | perm[hand[0] & 3];
+        hand[1] = (hand[1] & ~3u) | perm[hand[1] & 3];
+    }
+    return (int) (entry >> 5);
+}
+
+
+//where hand falls among the combos a board (6 bits a card) leaves, or
+//FAIL if it uses a board card
+static int combo_slot(const uint32_t hand[2], uint32_t board, int nboard){
+    uint32_t lo = (hand[0] < hand[1]) ? hand[0] : hand[1], hi = hand[0] ^ hand[1] ^ lo;
+    uint32_t c, lows = 0, highs = 0;
+    int i, n = 52 - nboard;
+
+    for (i = 0; i < nboard; i++){
+        c = (board >> (6 * i)) & 63;
+        if (c == lo || c == hi)
+            return FAIL;
+        lows += c < lo;
+        highs += c < hi;
+    }
+    //the hand's cards numbered among the cards the board leaves
+    lo -= lows;
+    hi -= highs;
+    return lo * n - lo * (lo + 1) / 2 + hi - lo - 1;
+}
+
+
+static void unpack_board(uint32_t packed, int nboard, uint32_t board[5]){
+    int i;
+
+    for (i = 0; i < nboard; i++)
+        board[i] = (packed >> (6 * i)) & 63;
+}
+
+
+//the histogram file save_histograms writes
+//
+//file layout:
+//    histogram_header
+//    each class's histograms from first on: ncombos of nbins uint16_t,
+//        counts of runouts, or on the river a single HS * scale
+
+#define HISTOGRAM_MAGIC "POKYRHST"
+#define HISTOGRAM_VERSION 1
+#define HISTOGRAM_CHUNK 64
+#define RIVER_SCALE 65535
+
+typedef struct{
+    char magic[8];
+    uint32_t version;
+    uint32_t header_size;
+    uint32_t nboard;
+    uint32_t nbins;
+    uint32_t scale;         //what a histogram's bins add up to
+    uint32_t first;
+    uint32_t nclasses;
+    uint32_t ncombos;
+    uint64_t checksum;      //over each class's histograms in turn
+}histogram_header;
+
+typedef struct{
+    const street *s;
+    histogram_header header;
+    int start;              //the chunk's first class
+    uint16_t *out;
+}histogram_job;
+
+
+static void histogram_task(void *shared, void *local, int task){
+    const histogram_job *job = (const histogram_job *) shared;
+    const histogram_header *h = &job->header;
+    uint16_t *out = job->out + (size_t) task * h->ncombos * h->nbins;
+    uint32_t board[5], packed = job->s->boards[job->start + task], *hist = (uint32_t *) local;
+    strength *strengths = (strength *) local;
+    uint64_t dead = 0;
+    int i, j, k, n;
+
+    unpack_board(packed, h->nboard, board);
+    for (i = 0; i < (int) h->nboard; i++)
+        dead |= CARD_BIT(board[i]);
+    if (h->nboard == 5)
+        hand_strengths(board, 5, NULL, strengths, 1);
+    else
+        equity_histograms(board, h->nboard, h->nbins, hist, 1);
+
+    for (i = 0, k = 0; i < 52; i++){
+        for (j = i + 1; j < 52; j++, k++){
+            if ( dead & (CARD_BIT(i) | CARD_BIT(j)) )
+                continue;
+            if (h->nboard == 5)
+                *out++ = (uint16_t) lround(strengths[k].ehs * RIVER_SCALE);
+            else{
+                for (n = 0; n < (int) h->nbins; n++)
+                    *out++ = (uint16_t) hist[k * h->nbins + n];
+            }
+        }
+    }
+}
+
+
+//write the equity histograms of the hands on count board classes of
+//nboard cards, from first on (count 0 for all of the rest), to path
+//Flop and turn histograms have nbins even bins of river HS counting
+//the runouts, river ones a single bin with the HS.
+//nthreads workers share the classes (see run_tasks)
+//Return the classes written, or FAIL
+int save_histograms(const char *path, int nboard, int nbins, int first, int count, int nthreads){
+    histogram_job job;
+    histogram_header *h = &job.header;
+    size_t localsize, chunksize;
+    void *locals = NULL;
+    char *tmp = NULL;
+    FILE *f = NULL;
+    int i, n, nclasses;
+    bool ok = false;
+
+    if ( (nclasses = board_classes(nboard, NULL, NULL)) == FAIL )
+        return FAIL;
+    if (nbins <= 0 || nbins > MAX_BINS || first < 0 || first > nclasses || count < 0)
+        return FAIL;
+    if (!count || count > nclasses - first)
+        count = nclasses - first;
+
+    job.s = get_street(nboard);
+    memset(h, 0, sizeof(*h));
+    memcpy(h->magic, HISTOGRAM_MAGIC, 8);
+    h->version = HISTOGRAM_VERSION;
+    h->header_size = sizeof(histogram_header);
+    h->nboard = nboard;
+    h->nbins = (nboard == 5) ? 1 : nbins;
+    h->scale = (nboard == 5) ? RIVER_SCALE : Choose[50 - nboard][5 - nboard];
+    h->first = first;
+    h->nclasses = count;
+    h->ncombos = Choose[52 - nboard][2];
+    h->checksum = CHECKSUM_SEED;
+
+    nthreads = task_threads(nthreads, HISTOGRAM_CHUNK);
+    localsize = NUM_STARTING_HANDS * (size_t) nbins * sizeof(uint32_t);
+    if (localsize < NUM_STARTING_HANDS * sizeof(strength))
+        localsize = NUM_STARTING_HANDS * sizeof(strength);
+    chunksize = (size_t) h->ncombos * h->nbins;
+    locals = malloc(nthreads * localsize);
+    job.out = (uint16_t *) malloc(HISTOGRAM_CHUNK * chunksize * sizeof(uint16_t));
+    tmp = (char *) malloc(strlen(path) + 32);
+    if (!locals || !job.out || !tmp)
+        goto done;
+    sprintf(tmp, "%s.%ld.tmp", path, (long) getpid());
+    if ( (f = fopen(tmp, "wb")) == NULL )
+        goto done;
+
+    //the header goes in again once the checksum is known
+    ok = fwrite(h, sizeof(*h), 1, f) == 1;
+    for (job.start = first; ok && job.start < first + count; job.start += n){
+        n = first + count - job.start;
+        n = (n < HISTOGRAM_CHUNK) ? n : HISTOGRAM_CHUNK;
+        run_tasks(histogram_task, &job, locals, localsize, n, nthreads);
+        for (i = 0; i < n; i++)
+            h->checksum = checksum(job.out + i * chunksize, chunksize * sizeof(uint16_t), h->checksum);
+        ok = fwrite(job.out, sizeof(uint16_t), n * chunksize, f) == n * chunksize;
+    }
+    ok = ok && fseek(f, 0, SEEK_SET) == 0 && fwrite(h, sizeof(*h), 1, f) == 1;
+    ok = (fclose(f) == 0) && ok;
+    if ( !ok || rename(tmp, path) != 0 ){
+        remove(tmp);
+        ok = false;
+    }
+
+  done:
+    free(tmp);
+    free(job.out);
+    free(locals);
+    return ok ? count : FAIL;
+}
+
+
+//map a file of size bytes or more at least header bytes long
+//Return its mapping, or NULL
+static void *map_file(const char *path, size_t header, size_t *size){
+    struct stat st;
+    void *map;
+    int fd;
+
+    if ( (fd = open(path, O_RDONLY)) < 0 )
+        return NULL;
+    if ( fstat(fd, &st) != 0 || (size_t) st.st_size < header ){
+        close(fd);
+        return NULL;
+    }
+    *size = st.st_size;
+    map = mmap(NULL, *size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    return (map == MAP_FAILED) ? NULL : map;
+}
+
+
+//k-means over the histograms, each weighing as many boards as its class
+//has.  Counts add up exactly as integers, so each worker keeps its own
+//sums and the centers don't depend on the threads; the distances are
+//kept per task and added in order.
+
+#define KMEANS_TASKS 256
+#define KMEANS_SAMPLE 64    //points per bucket for seeding
+
+typedef struct{
+    const histogram_header *h;
+    const uint16_t *data;
+    const uint32_t *weights;    //by class
+    int k, nbins, metric;
+    double *centers;            //k of nbins, cumulative for METRIC_EMD
+    uint16_t *assignments;
+    size_t npoints;
+    double distances[KMEANS_TASKS];
+    uint64_t changes[KMEANS_TASKS];
+}kmeans_job;
+
+typedef struct{
+    uint64_t *sums;             //k of nbins weighted counts
+    uint64_t *weights;          //k
+}kmeans_sums;
+
+
+//a point as the metric sees it
+static void point_features(const kmeans_job *job, size_t point, double *x){
+    const uint16_t *counts = job->data + point * job->nbins;
+    double scale = 1.0 / job->h->scale, total = 0.0;
+    int i;
+
+    for (i = 0; i < job->nbins; i++){
+        x[i] = counts[i] * scale;
+        if (job->metric == METRIC_EMD)
+            x[i] = (total += x[i]);
+    }
+}
+
+
+//the square of the L2 distance, or the earth mover's distance between
+//two cumulative histograms
+static double distance(const double *x, const double *y, int nbins, int metric){
+    double d = 0.0;
+    int i;
+
+    if (metric == METRIC_EMD){
+        for (i = 0; i < nbins; i++)
+            d += fabs(x[i] - y[i]);
+        return d;
+    }
+    for (i = 0; i < nbins; i++)
+        d += (x[i] - y[i]) * (x[i] - y[i]);
+    return d;
+}
+
+
+static int nearest(const kmeans_job *job, const double *x, double *best){
+    double d;
+    int c, closest = 0;
+
+    *best = INFINITY;
+    for (c = 0; c < job->k; c++){
+        if ( (d = distance(x, job->centers + c * job->nbins, job->nbins, job->metric)) < *best ){
+            *best = d;
+            closest = c;
+        }
+    }
+    return closest;
+}
+
+
+static void kmeans_task(void *shared, void *local, int task){
+    kmeans_job *job = (kmeans_job *) shared;
+    kmeans_sums *sums = (kmeans_sums *) local;
+    size_t point = job->npoints * task / KMEANS_TASKS, end = job->npoints * (task + 1) / KMEANS_TASKS;
+    const uint16_t *counts;
+    double x[MAX_BINS], d, total = 0.0;
+    uint64_t weight, changes = 0;
+    int i, c;
+
+    for (; point < end; point++){
+        point_features(job, point, x);
+        c = nearest(job, x, &d);
+        weight = job->weights[point / job->h->ncombos];
+        total += d * weight;
+        changes += c != job->assignments[point];
+        job->assignments[point] = (uint16_t) c;
+        counts = job->data + point * job->nbins;
+        for (i = 0; i < job->nbins; i++)
+            sums->sums[c * job->nbins + i] += counts[i] * weight;
+        sums->weights[c] += weight;
+    }
+    job->distances[task] = total;
+    job->changes[task] = changes;
+}
+
+
+//choose the first centers by k-means++ over a weighted sample
+static void seed_centers(kmeans_job *job, uint64_t seed){
+    size_t nsample = (size_t) job->k * KMEANS_SAMPLE, i, j, *sample;
+    double *x, *nearests, total, pick, d;
+    deck rng;
+    int c;
+
+    if (nsample > job->npoints)
+        nsample = job->npoints;
+    sample = (size_t *) malloc(nsample * sizeof(size_t));
+    x = (double *) malloc(nsample * job->nbins * sizeof(double));
+    nearests = (double *) malloc(nsample * sizeof(double));
+    initdeck(&rng, NULL, seed);
+    if (!sample || !x || !nearests){
+        //fall back on spreading the centers over the points
+        for (c = 0; c < job->k; c++)
+            point_features(job, job->npoints * c / job->k, job->centers + c * job->nbins);
+        goto done;
+    }
+
+    for (i = 0; i < nsample; i++){
+        sample[i] = (nsample == job->npoints) ? i : (size_t) (random_unit(&rng) * job->npoints);
+        point_features(job, sample[i], x + i * job->nbins);
+        nearests[i] = INFINITY;
+    }
+    j = (size_t) (random_unit(&rng) * nsample);
+    for (c = 0; c < job->k; c++){
+        memcpy(job->centers + c * job->nbins, x + j * job->nbins, job->nbins * sizeof(double));
+        for (i = 0, total = 0.0; i < nsample; i++){
+            //distance is already squared for L2
+            d = distance(x + i * job->nbins, job->centers + c * job->nbins, job->nbins, job->metric);
+            if (job->metric == METRIC_EMD)
+                d *= d;
+            if (d < nearests[i])
+                nearests[i] = d;
+            total += nearests[i] * job->weights[sample[i] / job->h->ncombos];
+        }
+        //the next center is a sample point picked by its weighted
+        //squared distance from the centers so far
+        pick = random_unit(&rng) * total;
+        for (j = 0; j < nsample - 1; j++){
+            pick -= nearests[j] * job->weights[sample[j] / job->h->ncombos];
+            if (pick < 0.0)
+                break;
+        }
+    }
+
+  done:
+    free(sample);
+    free(x);
+    free(nearests);
+}
+
+
+//the bucket table cluster_histograms writes
+//
+//file layout:
+//    bucket_header
+//    each class's buckets from first on: ncombos uint16_t
+
+#define BUCKET_MAGIC "POKYRBKT"
+#define BUCKET_VERSION 1
+
+typedef struct{
+    char magic[8];
+    uint32_t version;
+    uint32_t header_size;
+    uint32_t nboard;
+    uint32_t nbuckets;
+    uint32_t first;
+    uint32_t nclasses;
+    uint32_t ncombos;
+    uint32_t metric;
+    uint64_t checksum;
+}bucket_header;
+
+
+//cluster the histograms save_histograms wrote to hist_path into k
+//buckets by METRIC_L2 or METRIC_EMD, running Lloyd's iterations until
+//no hand changes bucket or iterations have run, and write the bucket
+//of every hand to bucket_path.  seed picks the starting centers.
+//nthreads workers share the hands (see run_tasks)
+//Return the mean distance (squared for L2) of the hands from their centers, or -1.0
+double cluster_histograms(const char *hist_path, const char *bucket_path, int k, int metric,
+                          int iterations, uint64_t seed, int nthreads){
+    const histogram_header *h;
+    bucket_header header;
+    kmeans_job job;
+    kmeans_sums *sums = NULL;
+    uint64_t hsum, weight, total, changes, count, cumulative;
+    size_t size, i, chunksize;
+    double result = -1.0, distances;
+    const uint32_t *weights = NULL;
+    void *map;
+    char *tmp = NULL;
+    FILE *f;
+    int c, n, t, iteration;
+    bool ok;
+
+    if (k <= 0 || k > 65535 || (metric != METRIC_L2 && metric != METRIC_EMD))
+        return -1.0;
+    if ( (map = map_file(hist_path, sizeof(histogram_header), &size)) == NULL )
+        return -1.0;
+    h = (const histogram_header *) map;
+    memset(&job, 0, sizeof(job));
+    job.h = h;
+    job.data = (const uint16_t *) (h + 1);
+    job.npoints = (size_t) h->nclasses * h->ncombos;
+    chunksize = (size_t) h->ncombos * h->nbins;
+    if ( memcmp(h->magic, HISTOGRAM_MAGIC, 8) || h->version != HISTOGRAM_VERSION ||
+         h->header_size != sizeof(histogram_header) || h->nbins > MAX_BINS ||
+         board_classes(h->nboard, NULL, &weights) < (int) (h->first + h->nclasses) ||
+         h->ncombos != Choose[52 - h->nboard][2] ||
+         size != sizeof(histogram_header) + job.npoints * h->nbins * sizeof(uint16_t) ||
+         job.npoints < (size_t) k )
+        goto done;
+    for (i = 0, hsum = CHECKSUM_SEED; i < h->nclasses; i++)
+        hsum = checksum(job.data + i * chunksize, chunksize * sizeof(uint16_t), hsum);
+    if (hsum != h->checksum)
+        goto done;
+
+    job.weights = weights + h->first;
+    for (i = 0, total = 0; i < h->nclasses; i++)
+        total += (uint64_t) job.weights[i] * h->ncombos;
+    job.k = k;
+    job.nbins = h->nbins;
+    job.metric = metric;
+    job.centers = (double *) malloc((size_t) k * job.nbins * sizeof(double));
+    job.assignments = (uint16_t *) malloc(job.npoints * sizeof(uint16_t));
+    nthreads = task_threads(nthreads, KMEANS_TASKS);
+    if ( !job.centers || !job.assignments || (sums = (kmeans_sums *) calloc(nthreads, sizeof(kmeans_sums))) == NULL )
+        goto done;
+    for (t = 0; t < nthreads; t++){
+        sums[t].sums = (uint64_t *) malloc((size_t) k * job.nbins * sizeof(uint64_t));
+        sums[t].weights = (uint64_t *) malloc(k * sizeof(uint64_t));
+        if (!sums[t].sums || !sums[t].weights)
+            goto done;
+    }
+    memset(job.assignments, 0xff, job.npoints * sizeof(uint16_t));
+    seed_centers(&job, seed);
+
+    for (iteration = 0; iteration < iterations; iteration++){
+        for (t = 0; t < nthreads; t++){
+            memset(sums[t].sums, 0, (size_t) k * job.nbins * sizeof(uint64_t));
+            memset(sums[t].weights, 0, k * sizeof(uint64_t));
+        }
+        run_tasks(kmeans_task, &job, sums, sizeof(kmeans_sums), KMEANS_TASKS, nthreads);
+
+        for (t = 0, changes = 0; t < KMEANS_TASKS; t++)
+            changes += job.changes[t];
+        if (!changes)
+            break;
+        //move each center to the mean of its hands, leaving empty ones
+        for (c = 0; c < k; c++){
+            for (t = 0, weight = 0; t < nthreads; t++)
+                weight += sums[t].weights[c];
+            if (!weight)
+                continue;
+            for (n = 0, cumulative = 0; n < job.nbins; n++){
+                for (t = 0, count = 0; t < nthreads; t++)
+                    count += sums[t].sums[c * job.nbins + n];
+                cumulative = (metric == METRIC_EMD) ? cumulative + count : count;
+                job.centers[c * job.nbins + n] = (double) cumulative / ((double) weight * h->scale);
+            }
+        }
+    }
+
+    //the distances and buckets of the final centers
+    run_tasks(kmeans_task, &job, sums, sizeof(kmeans_sums), KMEANS_TASKS, nthreads);
+    for (t = 0, distances = 0.0; t < KMEANS_TASKS; t++)
+        distances += job.distances[t];
+    result = distances / total;
+
+    memset(&header, 0, sizeof(header));
+    memcpy(header.magic, BUCKET_MAGIC, 8);
+    header.version = BUCKET_VERSION;
+    header.header_size = sizeof(bucket_header);
+    header.nboard = h->nboard;
+    header.nbuckets = k;
+    header.first = h->first;
+    header.nclasses = h->nclasses;
+    header.ncombos = h->ncombos;
+    header.metric = metric;
+    header.checksum = checksum(job.assignments, job.npoints * sizeof(uint16_t), CHECKSUM_SEED);
+
+    if ( (tmp = (char *) malloc(strlen(bucket_path) + 32)) == NULL ){
+        result = -1.0;
+        goto done;
+    }
+    sprintf(tmp, "%s.%ld.tmp", bucket_path, (long) getpid());
+    ok = (f = fopen(tmp, "wb")) != NULL;
+    ok = ok && fwrite(&header, sizeof(header), 1, f) == 1 &&
+         fwrite(job.assignments, sizeof(uint16_t), job.npoints, f) == job.npoints;
+    ok = f && (fclose(f) == 0) && ok;
+    if ( !ok || rename(tmp, bucket_path) != 0 ){
+        remove(tmp);
+        result = -1.0;
+    }
+
+  done:
+    for (t = 0; sums && t < nthreads; t++){
+        free(sums[t].sums);
+        free(sums[t].weights);
+    }
+    free(sums);
+    free(tmp);
+    free(job.centers);
+    free(job.assignments);
+    munmap(map, size);
+    return result;
+}
+
+
+//map the bucket table cluster_histograms wrote to path
+//Return FAIL if the file is missing, from another version or fails
+//its checksum
+int load_buckets(const char *path, bucket_table *table){
+    const bucket_header *h;
+    size_t size, npoints;
+    void *map;
+
+    if ( (map = map_file(path, sizeof(bucket_header), &size)) == NULL )
+        return FAIL;
+    h = (const bucket_header *) map;
+    npoints = (size_t) h->nclasses * h->ncombos;
+    if ( memcmp(h->magic, BUCKET_MAGIC, 8) || h->version != BUCKET_VERSION ||
+         h->header_size != sizeof(bucket_header) ||
+         board_classes(h->nboard, NULL, NULL) < (int) (h->first + h->nclasses) ||
+         h->ncombos != Choose[52 - h->nboard][2] ||
+         size != sizeof(bucket_header) + npoints * sizeof(uint16_t) ||
+         checksum(h + 1, npoints * sizeof(uint16_t), CHECKSUM_SEED) != h->checksum ){
+        munmap(map, size);
+        return FAIL;
+    }
+    table->nboard = h->nboard;
+    table->nbuckets = h->nbuckets;
+    table->first = h->first;
+    table->nclasses = h->nclasses;
+    table->ncombos = h->ncombos;
+    table->buckets = (const uint16_t *) (h + 1);
+    table->map = map;
+    table->mapsize = size;
+    return SUCCESS;
+}
+
+
+void free_buckets(bucket_table *table){
+    if (table->map)
+        munmap(table->map, table->mapsize);
+    table->map = NULL;
+    table->buckets = NULL;
+}
+
+
+//the bucket of hand on a board of table->nboard cards
+//Return FAIL for bad or duplicate cards or a board the table doesn't cover
+int bucket_lookup(const bucket_table *table, const uint32_t hand[2], const uint32_t board[]){
+    uint32_t relabeled[2] = {hand[0], hand[1]};
+    int class, slot;
+
+    if (hand[0] > 51 || hand[1] > 51 || hand[0] == hand[1])
+        return FAIL;
+    if ( (class = board_class(board, table->nboard, relabeled)) == FAIL )
+        return FAIL;
+    if ( (uint32_t) class < table->first || (uint32_t) class >= table->first + table->nclasses )
+        return FAIL;
+    slot = combo_slot(relabeled, Streets[table->nboard - 3]->boards[class], table->nboard);
+    if (slot == FAIL)
+        return FAIL;
+    return table->buckets[(size_t) (class - table->first) * table->ncombos + slot];
+}
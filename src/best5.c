@@ -0,0 +1,312 @@
+// Copyright 2013 Allen Boyd Cunningham
+
+// This file is part of pokyr.
+
+//     pokyr is free software: you can redistribute it and/or modify
+//     it under the terms of the GNU General Public License as published by
+//     the Free Software Foundation, either version 3 of the License, or
+//     (at your option) any later version.
+//     pokyr is distributed in the hope that it will be useful,
+//     but WITHOUT ANY WARRANTY; without even the implied warranty of
+//     MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//     GNU General Public License for more details.
+
+//     You should have received a copy of the GNU General Public License
+//     along with pokyr.  If not, see <http://www.gnu.org/licenses/>.
+
+
+#include "poker_heavy.h"
+
+#include <pthread.h>
+#include <string.h>
+
+//best5_rank ranks a hand of 5 or more cards by its best 5 on a scale of
+//its own: the NUM_BEST5_RANKS distinct 5 card hands in order, from 1.
+//The 7 card Rank_Table can't be used for fewer cards, and its scale
+//skips the 5 card hands no 7 cards play (like 7-5-4-3-2 offsuit).
+//
+//Like the 7 card tables, each rank combination of 5 or 6 cards is
+//ranked once, and looked up by its specialK sum, here through a
+//perfect hash (see compact_table.c), while flushes are looked up by the
+//rank bits of the suit they're in.  So a 5 or 6 card hand is one
+//lookup.  Bigger hands go through best5_value.
+
+//rank combinations of 5 and 6 cards, no more than 4 of a rank
+#define NUM_FIVE_COMBOS 6175
+#define NUM_SIX_COMBOS 18395
+
+//DECK = [r | (s << SUITSHIFT) for r in SPECIALKS for s in (0, 1, 8, 57)]
+static const uint32_t Deck[52] = DECK;
+extern const uint64_t Bits[52];
+
+uint16_t Five_Displace[COMPACT_BUCKETS];
+uint16_t Five_Compact[COMPACT_SLOTS];
+uint16_t Six_Displace[COMPACT_BUCKETS];
+uint16_t Six_Compact[COMPACT_SLOTS];
+//by the rank bits of 5 or more cards of a suit
+uint16_t Best_Flush[CARD_MASK + 1];
+
+//for 5 and 6 cards, the Bits shift of the suit a suit sum has a flush
+//in, or FAIL
+static int8_t Flush_Shift[2][400];
+//every best5_value in order
+static uint32_t Best5_Values[NUM_BEST5_RANKS];
+
+static bool Best5_Ready = false;
+static pthread_once_t Best5_Once = PTHREAD_ONCE_INIT;
+
+#define HASH_LOOKUP(displace, compact, key) compact[COMPACT_SLOT(key) ^ displace[COMPACT_BUCKET(key)]]
+
+
+//a value that orders hands of 5 or more cards by their best 5
+//categories go in bits 26 up, then up to two paired ranks 4 bits
+//each, then a bit per kicker rank
+uint32_t best5_value(const uint32_t cards[], int n){
+    int counts[13] = {0}, suits[4] = {0};
+    uint32_t suitbits[4] = {0, 0, 0, 0}, rankbits = 0, kickers, bits, value;
+    int i, r, flush = -1, quads = -1, trips = -1, pair1 = -1, pair2 = -1, high, nkickers;
+
+    for (i = 0; i < n; i++){
+        r = 12 - (int) (cards[i] >> 2);     //2 is 0 and A is 12
+        counts[r]++;
+        suitbits[cards[i] & 3] |= 1u << r;
+        rankbits |= 1u << r;
+        if (++suits[cards[i] & 3] == 5)
+            flush = cards[i] & 3;
+    }
+
+    //the high card of the best straight in bits, or -1
+    #define STRAIGHT_HIGH(bits, high) \
+        for (high = 12; high >= 4 && ((bits) >> (high - 4) & 0x1f) != 0x1f; high--); \
+        if (high < 4) \
+            high = (((bits) & 0x100f) == 0x100f) ? 3 : -1;
+
+    if (flush != -1){
+        STRAIGHT_HIGH(suitbits[flush], high)
+        if (high != -1)
+            return 8u << 26 | high;
+    }
+    for (r = 12; r >= 0; r--){
+        if (counts[r] == 4 && quads == -1)
+            quads = r;
+        else if (counts[r] == 3 && trips == -1)
+            trips = r;
+        else if (counts[r] >= 2 && pair1 == -1)
+            pair1 = r;
+        else if (counts[r] >= 2 && pair2 == -1)
+            pair2 = r;
+    }
+    if (quads != -1){
+        for (r = 12; r == quads || !counts[r]; r--);
+        return 7u << 26 | quads << 22 | 1u << r;
+    }
+    if (trips != -1){
+        //a second set of trips plays as the pair
+        for (r = 12; r >= 0 && (r == trips || counts[r] < 2); r--);
+        if (r >= 0)
+            return 6u << 26 | trips << 22 | r << 18;
+    }
+    if (flush != -1){
+        for (bits = suitbits[flush]; __builtin_popcount(bits) > 5; bits &= bits - 1);
+        return 5u << 26 | bits;
+    }
+    STRAIGHT_HIGH(rankbits, high)
+    #undef STRAIGHT_HIGH
+    if (high != -1)
+        return 4u << 26 | high;
+
+    if (trips != -1){
+        kickers = rankbits & ~(1u << trips);
+        nkickers = 2;
+        value = 3u << 26 | trips << 22;
+    }
+    else if (pair2 != -1){
+        kickers = rankbits & ~(1u << pair1) & ~(1u << pair2);
+        nkickers = 1;
+        value = 2u << 26 | pair1 << 22 | pair2 << 18;
+    }
+    else if (pair1 != -1){
+        kickers = rankbits & ~(1u << pair1);
+        nkickers = 3;
+        value = 1u << 26 | pair1 << 22;
+    }
+    else{
+        kickers = rankbits;
+        nkickers = 5;
+        value = 0;
+    }
+    while (__builtin_popcount(kickers) > nkickers)
+        kickers &= kickers - 1;
+    return value | kickers;
+}
+
+
+static int compare_values(const void *a, const void *b){
+    uint32_t x = *(const uint32_t *) a, y = *(const uint32_t *) b;
+    return (x > y) - (x < y);
+}
+
+
+//the rank of a best5_value
+static uint16_t value_rank(uint32_t value){
+    const uint32_t *found = (const uint32_t *) bsearch(&value, Best5_Values, NUM_BEST5_RANKS,
+                                                       sizeof(uint32_t), compare_values);
+    return (uint16_t) (found - Best5_Values + 1);
+}
+
+
+//append the specialK sum and best5_value of every rank combination of
+//n cards to keys and values, with cards[0..k) chosen and same of them
+//of rank r
+static int walk_combos(uint32_t *keys, uint32_t *values, int count, uint32_t cards[], int k,
+                       int n, uint32_t r, int same){
+    static const uint32_t specialks[13] = SPECIALKS;
+    int i;
+
+    if (k == n){
+        for (i = 0, keys[count] = 0; i < n; i++)
+            keys[count] += specialks[cards[i] >> 2];
+        values[count] = best5_value(cards, n);
+        return count + 1;
+    }
+    for (; r < 13; r++, same = 0){
+        if (same == 4)
+            continue;
+        //the suits go round, so the cards never flush
+        cards[k] = r << 2 | (k & 3);
+        count = walk_combos(keys, values, count, cards, k + 1, n, r, same + 1);
+    }
+    return count;
+}
+
+
+//rank the rank combinations of n cards into a displace and compact pair
+static int build_combos(int n, uint32_t *keys, uint32_t *values, uint16_t *ranks,
+                        uint16_t displace[COMPACT_BUCKETS], uint16_t compact[COMPACT_SLOTS]){
+    uint32_t cards[6];
+    int i, count = walk_combos(keys, values, 0, cards, 0, n, 0, 0);
+
+    for (i = 0; i < count; i++)
+        ranks[i] = value_rank(values[i]);
+    return build_compact_hash(keys, ranks, count, displace, compact);
+}
+
+
+//the cards of the ranks in mask, all of one suit
+static int flush_cards(uint32_t mask, uint32_t cards[13]){
+    int r, n = 0;
+
+    for (r = 0; r < 13; r++){
+        if (mask >> (12 - r) & 1)
+            cards[n++] = (uint32_t) r << 2;
+    }
+    return n;
+}
+
+
+static void build_best5(void){
+    uint32_t *keys, *values, cards[13], mask;
+    uint16_t *ranks;
+    int i, n, a, b, c, counts[4], nvalues = 0;
+
+    keys = (uint32_t *) malloc(NUM_SIX_COMBOS * sizeof(uint32_t));
+    values = (uint32_t *) malloc(NUM_SIX_COMBOS * sizeof(uint32_t));
+    ranks = (uint16_t *) malloc(NUM_SIX_COMBOS * sizeof(uint16_t));
+    if (!keys || !values || !ranks)
+        goto done;
+
+    //the scale: every 5 card flush and rank combination, which are all
+    //different hands
+    for (mask = 0; mask <= CARD_MASK; mask++){
+        if (__builtin_popcount(mask) == 5)
+            Best5_Values[nvalues++] = best5_value(cards, flush_cards(mask, cards));
+    }
+    nvalues += walk_combos(keys, Best5_Values + nvalues, 0, cards, 0, 5, 0, 0);
+    if (nvalues != NUM_BEST5_RANKS)
+        goto done;
+    qsort(Best5_Values, NUM_BEST5_RANKS, sizeof(uint32_t), compare_values);
+
+    if (build_combos(5, keys, values, ranks, Five_Displace, Five_Compact) == FAIL ||
+        build_combos(6, keys, values, ranks, Six_Displace, Six_Compact) == FAIL)
+        goto done;
+    for (mask = 0; mask <= CARD_MASK; mask++){
+        if (__builtin_popcount(mask) >= 5)
+            Best_Flush[mask] = value_rank(best5_value(cards, flush_cards(mask, cards)));
+    }
+
+    //suit sums count the cards of suits 1-3 in base 8 (with a carry for
+    //the 57s), and suit 0 has the rest
+    for (n = 5; n <= 6; n++){
+        memset(Flush_Shift[n - 5], FAIL, sizeof(Flush_Shift[0]));
+        for (a = 0; a <= n; a++){
+            for (b = 0; a + b <= n; b++){
+                for (c = 0; a + b + c <= n; c++){
+                    counts[0] = n - a - b - c;
+                    counts[1] = a;
+                    counts[2] = b;
+                    counts[3] = c;
+                    for (i = 0; i < 4; i++){
+                        if (counts[i] >= 5)
+                            Flush_Shift[n - 5][a + 8 * b + 57 * c] = (int8_t) (13 * i);
+                    }
+                }
+            }
+        }
+    }
+    Best5_Ready = true;
+
+done:
+    free(keys);
+    free(values);
+    free(ranks);
+}
+
+
+//build the tables the first time
+//Return false if there wasn't memory for them
+bool init_best5(void){
+    pthread_once(&Best5_Once, build_best5);
+    return Best5_Ready;
+}
+
+
+//the rank of the best 5 of n (5 or more) cards, or FAIL for bad or
+//duplicate cards
+int best5_rank(const uint32_t cards[], int n){
+    uint64_t mask = 0, bits = 0;
+    uint32_t key = 0;
+    int i, shift;
+
+    if (n < 5 || n > 52 || !init_best5())
+        return FAIL;
+    for (i = 0; i < n; i++){
+        if (cards[i] > 51 || (mask & CARD_BIT(cards[i])))
+            return FAIL;
+        mask |= CARD_BIT(cards[i]);
+        key += Deck[cards[i]];
+        bits += Bits[cards[i]];
+    }
+    if (n > 6)
+        return value_rank(best5_value(cards, n));
+
+    if ( (shift = Flush_Shift[n - 5][key >> SUITSHIFT]) != FAIL )
+        return Best_Flush[(bits >> shift) & CARD_MASK];
+    if (n == 5)
+        return HASH_LOOKUP(Five_Displace, Five_Compact, key & RANKMASK);
+    return HASH_LOOKUP(Six_Displace, Six_Compact, key & RANKMASK);
+}
+
+
+//rank n hands of ncards cards each into out
+//Return FAIL, with the hands before the bad one ranked, for bad or
+//duplicate cards
+int best5_rank_batch(const uint32_t *hands, int n, int ncards, uint16_t *out){
+    int i, rank;
+
+    for (i = 0; i < n; i++){
+        if ( (rank = best5_rank(hands + i * ncards, ncards)) == FAIL )
+            return FAIL;
+        out[i] = (uint16_t) rank;
+    }
+    return SUCCESS;
+}
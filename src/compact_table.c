@@ -0,0 +1,147 @@
+// Copyright 2013 Allen Boyd Cunningham
+
+// This file is part of pokyr.
+
+//     pokyr is free software: you can redistribute it and/or modify
+//     it under the terms of the GNU General Public License as published by
+//     the Free Software Foundation, either version 3 of the License, or
+//     (at your option) any later version.
+//     pokyr is distributed in the hope that it will be useful,
+//     but WITHOUT ANY WARRANTY; without even the implied warranty of
+//     MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//     GNU General Public License for more details.
+
+//     You should have received a copy of the GNU General Public License
+//     along with pokyr.  If not, see <http://www.gnu.org/licenses/>.
+
+
+#include "poker_heavy.h"
+
+#include <string.h>
+
+//a minimal-ish perfect hash over the NUM_RANK_COMBOS specialK sums
+//that index Rank_Table, so the values fit in 160KB rather than 15MB
+//
+//each key falls in a bucket by one multiplicative hash and in a slot
+//by another.  Buckets are placed largest first, each getting the
+//smallest displacement that xors all its slots onto free ones.
+//Only the sums of real hands are ever looked up, so slots are not
+//checked against their keys.
+
+//one spare entry each so 32 bit vector gathers can't read past the end
+uint16_t Rank_Displace[COMPACT_BUCKETS + 1];
+uint16_t Rank_Compact[COMPACT_SLOTS + 1];
+
+
+//append the specialK sum of every 7 card rank combination to keys
+static int walk_keys(uint32_t *keys, int n, int rank, int left, uint32_t sum, int count){
+    static const uint32_t specialks[13] = SPECIALKS;
+
+    if (!left){
+        keys[n] = sum;
+        return n + 1;
+    }
+    for (; rank < 13; rank++, count = 0){
+        if (count == 4)
+            continue;
+        n = walk_keys(keys, n, rank, left - 1, sum + specialks[rank], count + 1);
+    }
+    return n;
+}
+
+
+//place nkeys keys with values in a displace and compact table pair
+//looked up the way COMPACT_INDEX looks up Rank_Compact
+//Return FAIL if there wasn't memory or a bucket wouldn't fit
+int build_compact_hash(const uint32_t *keys, const uint16_t *values, int nkeys,
+                       uint16_t displace[COMPACT_BUCKETS], uint16_t compact[COMPACT_SLOTS]){
+    uint32_t d, slot;
+    int *start, *fill, *bucketkeys;
+    uint8_t *used;
+    int i, j, b, size, maxsize = 0, result = SUCCESS;
+
+    bucketkeys = (int *) malloc(nkeys * sizeof(int));
+    start = (int *) calloc(COMPACT_BUCKETS + 1, sizeof(int));
+    fill = (int *) calloc(COMPACT_BUCKETS, sizeof(int));
+    used = (uint8_t *) calloc(COMPACT_SLOTS, 1);
+
+    if (!bucketkeys || !start || !fill || !used){
+        result = FAIL;
+        goto done;
+    }
+
+    //group the keys by bucket
+    for (i = 0; i < nkeys; i++)
+        start[COMPACT_BUCKET(keys[i]) + 1]++;
+    for (b = 0; b < COMPACT_BUCKETS; b++){
+        if (start[b + 1] > maxsize)
+            maxsize = start[b + 1];
+        start[b + 1] += start[b];
+    }
+    for (i = 0; i < nkeys; i++){
+        b = COMPACT_BUCKET(keys[i]);
+        bucketkeys[start[b] + fill[b]++] = i;
+    }
+
+    for (size = maxsize; size > 0; size--){
+        for (b = 0; b < COMPACT_BUCKETS; b++){
+            if (start[b + 1] - start[b] != size)
+                continue;
+
+            for (d = 0; d < COMPACT_SLOTS; d++){
+                for (i = start[b]; i < start[b + 1]; i++){
+                    slot = COMPACT_SLOT(keys[bucketkeys[i]]) ^ d;
+                    if (used[slot])
+                        break;
+                    for (j = start[b]; j < i; j++){
+                        if ((COMPACT_SLOT(keys[bucketkeys[j]]) ^ d) == slot)
+                            break;
+                    }
+                    if (j < i)
+                        break;
+                }
+                if (i == start[b + 1])
+                    break;
+            }
+            if (d == COMPACT_SLOTS){
+                result = FAIL;
+                goto done;
+            }
+
+            displace[b] = (uint16_t) d;
+            for (i = start[b]; i < start[b + 1]; i++){
+                slot = COMPACT_SLOT(keys[bucketkeys[i]]) ^ d;
+                used[slot] = 1;
+                compact[slot] = values[bucketkeys[i]];
+            }
+        }
+    }
+
+done:
+    free(bucketkeys);
+    free(start);
+    free(fill);
+    free(used);
+    return result;
+}
+
+
+//fill Rank_Displace and Rank_Compact from a populated rank table
+int build_compact_table(const uint16_t ranktable[RANK_TABLE_SIZE]){
+    uint32_t *keys;
+    uint16_t *values;
+    int i, nkeys, result = FAIL;
+
+    keys = (uint32_t *) malloc(NUM_RANK_COMBOS * sizeof(uint32_t));
+    values = (uint16_t *) malloc(NUM_RANK_COMBOS * sizeof(uint16_t));
+
+    if (keys && values){
+        nkeys = walk_keys(keys, 0, 0, 7, 0, 0);
+        for (i = 0; i < nkeys; i++)
+            values[i] = ranktable[keys[i]];
+        result = build_compact_hash(keys, values, nkeys, Rank_Displace, Rank_Compact);
+    }
+    free(keys);
+    free(values);
+    return result;
+}
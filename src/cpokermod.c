@@ -17,6 +17,10 @@
 
 #include "poker_heavy.h"
 #include "Python.h"
+#include "pythread.h"
+
+#include <errno.h>
+#include <pthread.h>
 
 
 #if PY_MAJOR_VERSION >= 3
@@ -26,34 +30,334 @@
 #endif
 
 
-static int convert_cards(PyObject *pycard_list, uint32_t *cards, int ncards){
-    int i;
-    PyObject * pycard;
+//batch entry points read cards straight out of any C contiguous buffer
+//of integers (bytes, array.array, numpy arrays...) a chunk at a time
+
+#define BATCH_CHUNK 1024
+
+//the struct module type code of a native buffer, or 0
+static char buffer_format(const Py_buffer *view){
+    const char *format = view->format ? view->format : "B";
+
+    if (*format == '@' || *format == '=')
+        format++;
+    if (!format[0] || format[1])
+        return 0;
+    return format[0];
+}
+
+//get a view of pycards as rows of width cards, or of a 2 dimensional
+//buffer's rows when width is 0
+static int get_card_buffer(PyObject *pycards, Py_buffer *view, int width, Py_ssize_t *nrows){
+    char format;
+
+    if ( PyObject_GetBuffer(pycards, view, PyBUF_C_CONTIGUOUS | PyBUF_FORMAT) == FAIL )
+        return FAIL;
+    if (width == 0 && view->ndim == 2)
+        width = (int) view->shape[1];
+
+    format = buffer_format(view);
+    if ( !format || strchr("bBhHiIlLqQ", format) == NULL || view->itemsize > 8 ){
+        PyErr_Format(PyExc_TypeError, "cards must be integers, got buffer format '%s'",
+            view->format);
+        PyBuffer_Release(view);
+        return FAIL;
+    }
+
+    if (width <= 0){
+        PyErr_SetString(PyExc_ValueError, "cards must be shaped (N, cards per hand)");
+        PyBuffer_Release(view);
+        return FAIL;
+    }
+    if ( (view->ndim == 2 && view->shape[1] != width) ||
+         view->ndim > 2 || (view->len / view->itemsize) % width ){
+        PyErr_Format(PyExc_ValueError, "cards must come in rows of %i", width);
+        PyBuffer_Release(view);
+        return FAIL;
+    }
+    *nrows = view->len / view->itemsize / width;
+    return SUCCESS;
+}
+
+
+#define READ_CARDS(type) { \
+        const type *src = (const type *) view->buf + start; \
+        for (i = 0; i < n; i++){ \
+            if ( src[i] < 0 || src[i] >= 52 ) \
+                break; \
+            cards[i] = (uint32_t) src[i]; \
+        } \
+        break; }
+
+//copy n cards starting at item start of view into cards
+static int read_cards(const Py_buffer *view, Py_ssize_t start, Py_ssize_t n, uint32_t *cards){
+    Py_ssize_t i = 0;
+    char format = buffer_format(view);
+
+    switch (view->itemsize){
+        case 1: if (format == 'b') READ_CARDS(int8_t) else READ_CARDS(uint8_t)
+        case 2: if (format == 'h') READ_CARDS(int16_t) else READ_CARDS(uint16_t)
+        case 4: if (strchr("il", format)) READ_CARDS(int32_t) else READ_CARDS(uint32_t)
+        case 8: if (strchr("lq", format)) READ_CARDS(int64_t) else READ_CARDS(uint64_t)
+    }
 
-    if ( !PyList_Check(pycard_list) ){
-        PyErr_SetString(PyExc_TypeError, "Hands and boards must be lists");
+    if (i < n){
+        PyErr_SetString(PyExc_ValueError, "cards must be between 0 and 51");
         return FAIL;
     }
+    return SUCCESS;
+}
+
+
+//cards come as any sequence of ints (a list is quickest) or any buffer
+//of integers (bytes, array.array, numpy arrays...)
+static int convert_cards(PyObject *pycards, uint32_t *cards, int ncards){
+    PyObject *seq, *pycard;
+    Py_buffer view;
+    Py_ssize_t n;
+    long card;
+    int i, result;
+
+    if ( PyObject_CheckBuffer(pycards) ){
+        if (get_card_buffer(pycards, &view, 1, &n) == FAIL)
+            return FAIL;
+        if (n != ncards){
+            PyErr_Format(PyExc_TypeError, "got %i cards, expected %i", (int) n, ncards);
+            PyBuffer_Release(&view);
+            return FAIL;
+        }
+        result = read_cards(&view, 0, n, cards);
+        PyBuffer_Release(&view);
+        return result;
+    }
 
-    if ( PyList_GET_SIZE(pycard_list) != ncards ){
+    if ( (seq = PySequence_Fast(pycards, "Hands and boards must be sequences of cards")) == NULL )
+        return FAIL;
+
+    if ( PySequence_Fast_GET_SIZE(seq) != ncards ){
         PyErr_Format(PyExc_TypeError, "got %i cards, expected %i",
-            (int) PyList_GET_SIZE(pycard_list), ncards);
+            (int) PySequence_Fast_GET_SIZE(seq), ncards);
+        Py_DECREF(seq);
         return FAIL;
     }
 
     for (i = 0; i < ncards; i++){
-        pycard = PyList_GET_ITEM(pycard_list, i);
-        if (!PyInt_Check(pycard)){
+        pycard = PySequence_Fast_GET_ITEM(seq, i);
+        //numpy's integer scalars aren't ints but do have __index__
+        if ( PyInt_Check(pycard) )
+            card = PyInt_AsLong(pycard);
+        else if ( PyIndex_Check(pycard) )
+            card = (long) PyNumber_AsSsize_t(pycard, NULL);
+        else{
             PyErr_SetString(PyExc_TypeError, "cards must be ints");
+            Py_DECREF(seq);
+            return FAIL;
+        }
+        if (card == -1 && PyErr_Occurred()){
+            Py_DECREF(seq);
             return FAIL;
         }
-        cards[i] = (uint32_t) PyInt_AsLong( pycard );
+        if (card < 0 || card > 51){
+            PyErr_SetString(PyExc_ValueError, "cards must be between 0 and 51");
+            Py_DECREF(seq);
+            return FAIL;
+        }
+        cards[i] = (uint32_t) card;
     }
 
+    Py_DECREF(seq);
     return 1;
 }
 
 
+//the number of cards in a sequence or buffer, or FAIL
+static int count_cards(PyObject *pycards){
+    Py_buffer view;
+    Py_ssize_t n;
+
+    if ( PyObject_CheckBuffer(pycards) ){
+        if (PyObject_GetBuffer(pycards, &view, PyBUF_C_CONTIGUOUS | PyBUF_FORMAT) == FAIL)
+            return FAIL;
+        n = view.itemsize ? view.len / view.itemsize : 0;
+        PyBuffer_Release(&view);
+        return (int) n;
+    }
+    return (int) PySequence_Size(pycards);
+}
+
+
+//fill holes with hands of nhole cards each, or of 4 or 5 (the same for
+//every hand) when nhole is 0, and set nhole.  The hands are a sequence
+//of hands or a buffer of rows of cards, shaped (N, nhole) when nhole is 0.
+//Return the number of hands, from minhands to MAX_HANDS, or FAIL
+static int convert_hands(PyObject *pyhands, uint32_t *holes, int *nhole, int minhands,
+                         const char *name){
+    PyObject *seq;
+    Py_buffer view;
+    Py_ssize_t n;
+    int i, nhands, result;
+
+    if ( PyObject_CheckBuffer(pyhands) ){
+        if (get_card_buffer(pyhands, &view, *nhole, &n) == FAIL)
+            return FAIL;
+        result = SUCCESS;
+        if (*nhole == 0 && ( (*nhole = (int) view.shape[1]) < 4 || *nhole > MAX_HOLE )){
+            PyErr_SetString(PyExc_ValueError, "Omaha hands must be 4 or 5 cards");
+            result = FAIL;
+        }
+        else if (n < minhands){
+            PyErr_Format(PyExc_TypeError, "%s requires a list of hands", name);
+            result = FAIL;
+        }
+        else if (n > MAX_HANDS){
+            PyErr_SetString(PyExc_ValueError, "too many hands");
+            result = FAIL;
+        }
+        else
+            result = read_cards(&view, 0, n * *nhole, holes);
+        PyBuffer_Release(&view);
+        return (result == FAIL) ? FAIL : (int) n;
+    }
+
+    if ( (seq = PySequence_Fast(pyhands, "")) == NULL ||
+         (nhands = (int) PySequence_Fast_GET_SIZE(seq)) < minhands ){
+        PyErr_Format(PyExc_TypeError, "%s requires a list of hands", name);
+        Py_XDECREF(seq);
+        return FAIL;
+    }
+    result = SUCCESS;
+    if (nhands > MAX_HANDS){
+        PyErr_SetString(PyExc_ValueError, "too many hands");
+        result = FAIL;
+    }
+    else if (*nhole == 0 &&
+             ( (*nhole = count_cards(PySequence_Fast_GET_ITEM(seq, 0))) < 4 || *nhole > MAX_HOLE )){
+        PyErr_Clear();
+        PyErr_SetString(PyExc_ValueError, "Omaha hands must be lists of 4 or 5 cards");
+        result = FAIL;
+    }
+    for (i = 0; i < nhands && result != FAIL; i++)
+        result = convert_cards(PySequence_Fast_GET_ITEM(seq, i), holes + i * *nhole, *nhole);
+    Py_DECREF(seq);
+    return (result == FAIL) ? FAIL : nhands;
+}
+
+
+//read an integer from 0 to 2**64 - 1 into value
+//Return FAIL with OverflowError set if obj is out of that range, rather
+//than taking it modulo 2**64
+static int read_uint64(PyObject *obj, unsigned long long *value){
+    PyObject *number;
+
+    if ( (number = PyNumber_Index(obj)) == NULL )
+        return FAIL;
+    #if PY_MAJOR_VERSION < 3
+    if (PyInt_Check(number)){
+        obj = number;
+        number = PyNumber_Long(obj);
+        Py_DECREF(obj);
+        if (number == NULL)
+            return FAIL;
+    }
+    #endif
+    *value = PyLong_AsUnsignedLongLong(number);
+    Py_DECREF(number);
+    return (*value == (unsigned long long) -1 && PyErr_Occurred()) ? FAIL : SUCCESS;
+}
+
+
+//the cheap per hand entry points are fast calls, which get their
+//arguments as an array and keyword names as a tuple rather than building
+//an argument tuple to parse (pythons before 3.7 go through call_fast)
+typedef PyObject *(*fast_fn)(PyObject *self, PyObject *const *args, Py_ssize_t nargs,
+                             PyObject *kwnames);
+
+#define MAX_FAST_ARGS 4
+
+static int name_is(PyObject *key, const char *name){
+#if PY_MAJOR_VERSION >= 3
+    return PyUnicode_Check(key) && PyUnicode_CompareWithASCIIString(key, name) == 0;
+#else
+    return PyString_Check(key) && strcmp(PyString_AS_STRING(key), name) == 0;
+#endif
+}
+
+//fill parsed with a fast call's arguments in kwlist's order, NULL for
+//ones not given, the first nrequired of which must be
+static int parse_fast(const char *fname, PyObject *const *args, Py_ssize_t nargs, PyObject *kwnames,
+                      const char *const kwlist[], int nrequired, PyObject *parsed[]){
+    Py_ssize_t i, nkw = kwnames ? PyTuple_GET_SIZE(kwnames) : 0;
+    int j, max = 0;
+
+    while (kwlist[max])
+        max++;
+    if (nargs > max){
+        PyErr_Format(PyExc_TypeError, "%s() takes at most %i arguments (%zd given)",
+            fname, max, nargs);
+        return FAIL;
+    }
+    for (j = 0; j < max; j++)
+        parsed[j] = (j < nargs) ? args[j] : NULL;
+
+    for (i = 0; i < nkw; i++){
+        for (j = 0; j < max && !name_is(PyTuple_GET_ITEM(kwnames, i), kwlist[j]); j++)
+            ;
+        if (j == max || parsed[j]){
+            PyErr_Format(PyExc_TypeError, "%s() got an unexpected or repeated keyword argument",
+                fname);
+            return FAIL;
+        }
+        parsed[j] = args[nargs + i];
+    }
+
+    for (j = 0; j < nrequired; j++){
+        if (parsed[j] == NULL){
+            PyErr_Format(PyExc_TypeError, "%s() missing required argument '%s'", fname, kwlist[j]);
+            return FAIL;
+        }
+    }
+    return SUCCESS;
+}
+
+#if PY_VERSION_HEX >= 0x03070000
+#define FAST_METHOD(name, fn, doc) \
+    { name, (PyCFunction) (void (*)(void)) fn, METH_FASTCALL | METH_KEYWORDS, doc }
+#define FAST_WRAPPER(fn)
+#else
+//call fn with a tuple's and dict's arguments
+static PyObject *call_fast(fast_fn fn, PyObject *self, PyObject *args, PyObject *kwargs){
+    PyObject *stack[MAX_FAST_ARGS], *kwnames = NULL, *key, *value, *result;
+    Py_ssize_t nargs = PyTuple_GET_SIZE(args), n, pos = 0;
+
+    if (nargs + (kwargs ? PyDict_Size(kwargs) : 0) > MAX_FAST_ARGS){
+        PyErr_SetString(PyExc_TypeError, "too many arguments");
+        return NULL;
+    }
+    for (n = 0; n < nargs; n++)
+        stack[n] = PyTuple_GET_ITEM(args, n);
+    if (kwargs && PyDict_Size(kwargs)){
+        if ( (kwnames = PyTuple_New(PyDict_Size(kwargs))) == NULL )
+            return NULL;
+        while (PyDict_Next(kwargs, &pos, &key, &value)){
+            Py_INCREF(key);
+            PyTuple_SET_ITEM(kwnames, n - nargs, key);
+            stack[n++] = value;
+        }
+    }
+    result = fn(self, stack, nargs, kwnames);
+    Py_XDECREF(kwnames);
+    return result;
+}
+
+#define FAST_METHOD(name, fn, doc) \
+    { name, (PyCFunction) fn##_tuple, METH_VARARGS | METH_KEYWORDS, doc }
+#define FAST_WRAPPER(fn) \
+    static PyObject *fn##_tuple(PyObject *self, PyObject *args, PyObject *kwargs){ \
+        return call_fast(fn, self, args, kwargs); \
+    }
+#endif
+
+
 #define SET_LIST_BY_TYPE(typefunc, list, array, len) \
     PyObject * item; \
     for (i = 0; i < len; i++){ \
@@ -83,6 +387,50 @@ static PyObject *buildListFromArray( void *array, int len, char dtype){
 }
 
 
+//return a new reference to out, checked to hold n values of the array
+//module's typecode ('H', 'Q', 'i' or 'd'), or to a new array.array of
+//length n when out is None
+static PyObject *get_output(PyObject *out, Py_ssize_t n, Py_buffer *view, char typecode){
+    Py_ssize_t size = (typecode == 'H') ? 2 : (typecode == 'i') ? 4 : 8;
+    const char *formats = (typecode == 'H') ? "H" : (typecode == 'Q') ? "LQ" :
+                          (typecode == 'i') ? "il" : "d";
+    const char *name = (typecode == 'H') ? "uint16" : (typecode == 'Q') ? "uint64" :
+                       (typecode == 'i') ? "int32" : "float64";
+    PyObject *module, *array;
+    char format;
+
+    if (out == NULL || out == Py_None){
+        if ( (module = PyImport_ImportModule("array")) == NULL )
+            return NULL;
+        array = PyObject_CallMethod(module, "array", "C[i]", typecode, 0);
+        Py_DECREF(module);
+        if (array == NULL)
+            return NULL;
+        out = PySequence_Repeat(array, n);
+        Py_DECREF(array);
+        if (out == NULL)
+            return NULL;
+    }
+    else{
+        Py_INCREF(out);
+    }
+
+    if ( PyObject_GetBuffer(out, view, PyBUF_WRITABLE | PyBUF_C_CONTIGUOUS | PyBUF_FORMAT) == FAIL ){
+        Py_DECREF(out);
+        return NULL;
+    }
+    format = buffer_format(view);
+    if ( view->itemsize != size || !format || !strchr(formats, format) || view->len / size < n ){
+        PyErr_Format(PyExc_ValueError, "out must be a %s buffer with room for %zd values",
+            name, n);
+        PyBuffer_Release(view);
+        Py_DECREF(out);
+        return NULL;
+    }
+    return out;
+}
+
+
 const char handvalue_doc[] =
 "handvalue(hand) -> long\n\n"
 "Return a numeric value for a seven card hand.\n"
@@ -91,16 +439,269 @@ const char handvalue_doc[] =
 "You are guarenteed higher values for better hands and\n"
 "the same value for tied hands.\n";
 
-static PyObject *cpoker_handvalue(PyObject *self, PyObject *args){
+static PyObject *cpoker_handvalue(PyObject *self, PyObject *const *args, Py_ssize_t nargs, PyObject *kwnames){
+    static const char *const kwlist[] = {"hand", NULL};
     PyObject *pyhand;
     uint32_t chand[7];
-    if ( ! PyArg_ParseTuple(args, "O", &pyhand ) )
+    uint64_t value;
+    STATS_START(start);
+    if ( parse_fast("handvalue", args, nargs, kwnames, kwlist, 1, &pyhand) == FAIL )
         return NULL;
 
     if (convert_cards(pyhand, chand, 7) == FAIL){
         return NULL;
     }
-    return (PyObject*) PyLong_FromLongLong(handvalue(chand));
+    value = handvalue(chand);
+    STATS_CALL(STAT_HANDVALUE, start, 1);
+    return (PyObject*) PyLong_FromLongLong(value);
+}
+
+
+const char handranks_doc[] =
+"handranks(hands, [out]) -> array\n\n"
+"Return the strength of each of many seven card hands.\n"
+"hands -> buffer of integer cards (bytes, array.array, numpy...)\n"
+"    holding N rows of 7 cards, either flat or shaped (N, 7)\n"
+"out -> optional writable uint16 buffer to hold the N results.\n"
+"    A new array.array('H') is returned if it is not supplied.\n\n"
+"Higher values are better hands and tied hands get equal values.\n"
+"Raises ValueError if any hand holds a duplicate card.\n";
+
+static PyObject *cpoker_handranks(PyObject *self, PyObject *args, PyObject *kwargs){
+    static char *kwlist[] = {"hands", "out", NULL};
+    PyObject *pyhands, *pyout = NULL, *out;
+    Py_buffer hands, outview;
+    Py_ssize_t n, start, chunk;
+    uint32_t cards[BATCH_CHUNK * 7];
+    int result;
+    STATS_START(called);
+
+    if (!PyArg_ParseTupleAndKeywords(args, kwargs, "O|O", kwlist, &pyhands, &pyout))
+        return NULL;
+
+    if (get_card_buffer(pyhands, &hands, 7, &n) == FAIL)
+        return NULL;
+
+    if ( (out = get_output(pyout, n, &outview, 'H')) == NULL ){
+        PyBuffer_Release(&hands);
+        return NULL;
+    }
+
+    for (start = 0; start < n; start += chunk){
+        chunk = (n - start < BATCH_CHUNK) ? n - start : BATCH_CHUNK;
+        if (read_cards(&hands, start * 7, chunk * 7, cards) == FAIL){
+            Py_CLEAR(out);
+            break;
+        }
+        Py_BEGIN_ALLOW_THREADS
+        result = rank_batch(cards, (int) chunk, (uint16_t *) outview.buf + start);
+        Py_END_ALLOW_THREADS
+        if (result == FAIL){
+            PyErr_SetString(PyExc_ValueError, "duplicate cards");
+            Py_CLEAR(out);
+            break;
+        }
+    }
+
+    PyBuffer_Release(&outview);
+    PyBuffer_Release(&hands);
+    if (out)
+        STATS_CALL(STAT_HANDRANKS, called, (uint64_t) n);
+    return out;
+}
+
+
+const char holdem_handranks_doc[] =
+"holdem_handranks(holes, boards, [out]) -> array\n\n"
+"Return the strength of each of many holdem hands.\n"
+"holes -> buffer of N rows of 2 hole cards\n"
+"boards -> buffer of N rows of 5 board cards\n"
+"out -> as for handranks\n\n"
+"The results are those handranks gives for the same seven cards.\n";
+
+static PyObject *cpoker_holdem_handranks(PyObject *self, PyObject *args, PyObject *kwargs){
+    static char *kwlist[] = {"holes", "boards", "out", NULL};
+    PyObject *pyholes, *pyboards, *pyout = NULL, *out;
+    Py_buffer holes, boards, outview;
+    Py_ssize_t n, nboards, start, chunk;
+    uint32_t holecards[BATCH_CHUNK * 2], boardcards[BATCH_CHUNK * 5];
+    int result;
+    STATS_START(called);
+
+    if (!PyArg_ParseTupleAndKeywords(args, kwargs, "OO|O", kwlist, &pyholes, &pyboards, &pyout))
+        return NULL;
+
+    if (get_card_buffer(pyholes, &holes, 2, &n) == FAIL)
+        return NULL;
+    if (get_card_buffer(pyboards, &boards, 5, &nboards) == FAIL){
+        PyBuffer_Release(&holes);
+        return NULL;
+    }
+    if (n != nboards){
+        PyErr_Format(PyExc_ValueError, "got %zd hole card rows and %zd boards", n, nboards);
+        PyBuffer_Release(&holes);
+        PyBuffer_Release(&boards);
+        return NULL;
+    }
+
+    if ( (out = get_output(pyout, n, &outview, 'H')) == NULL ){
+        PyBuffer_Release(&holes);
+        PyBuffer_Release(&boards);
+        return NULL;
+    }
+
+    for (start = 0; start < n; start += chunk){
+        chunk = (n - start < BATCH_CHUNK) ? n - start : BATCH_CHUNK;
+        if (read_cards(&holes, start * 2, chunk * 2, holecards) == FAIL ||
+            read_cards(&boards, start * 5, chunk * 5, boardcards) == FAIL){
+            Py_CLEAR(out);
+            break;
+        }
+        Py_BEGIN_ALLOW_THREADS
+        result = holdem_rank_batch(holecards, boardcards, (int) chunk, (uint16_t *) outview.buf + start);
+        Py_END_ALLOW_THREADS
+        if (result == FAIL){
+            PyErr_SetString(PyExc_ValueError, "duplicate cards");
+            Py_CLEAR(out);
+            break;
+        }
+    }
+
+    PyBuffer_Release(&outview);
+    PyBuffer_Release(&holes);
+    PyBuffer_Release(&boards);
+    if (out)
+        STATS_CALL(STAT_HOLDEM_HANDRANKS, called, (uint64_t) n);
+    return out;
+}
+
+
+const char best5_rank_doc[] =
+"best5_rank(cards) -> int\n\n"
+"Return the strength of the best 5 of 5 or more cards, from 1 for\n"
+"7-5-4-3-2 to 7462 for a royal flush.  Higher values are better hands\n"
+"and tied hands get equal values.  5 and 6 cards are one table lookup.\n"
+"The scale is not the one handranks uses.\n";
+
+static PyObject *cpoker_best5_rank(PyObject *self, PyObject *const *args, Py_ssize_t nargs, PyObject *kwnames){
+    static const char *const kwlist[] = {"cards", NULL};
+    PyObject *pycards;
+    uint32_t cards[52];
+    int n, rank;
+    STATS_START(start);
+
+    if (parse_fast("best5_rank", args, nargs, kwnames, kwlist, 1, &pycards) == FAIL)
+        return NULL;
+    if ( (n = count_cards(pycards)) < 5 || n > 52 ){
+        PyErr_SetString(PyExc_ValueError, "cards must be a list of 5 or more cards");
+        return NULL;
+    }
+    if (convert_cards(pycards, cards, n) == FAIL)
+        return NULL;
+    if ( (rank = best5_rank(cards, n)) == FAIL ){
+        PyErr_SetString(PyExc_ValueError, "bad or duplicate cards");
+        return NULL;
+    }
+    STATS_CALL(STAT_BEST5_RANK, start, 1);
+    return PyInt_FromLong(rank);
+}
+
+
+const char best5_ranks_doc[] =
+"best5_ranks(hands, ncards, [out]) -> array\n\n"
+"Return the best5_rank of each of many hands.\n"
+"hands -> buffer of integer cards holding N rows of ncards (5-7) cards\n"
+"out -> as for handranks\n";
+
+//rank the rows of 5-7 cards in a buffer with batch, like best5_rank_batch
+static PyObject *rank_rows(PyObject *args, PyObject *kwargs,
+                           int (*batch)(const uint32_t *, int, int, uint16_t *), int entry){
+    static char *kwlist[] = {"hands", "ncards", "out", NULL};
+    PyObject *pyhands, *pyout = NULL, *out;
+    Py_buffer hands, outview;
+    Py_ssize_t n, start, chunk;
+    uint32_t cards[BATCH_CHUNK * 7];
+    int ncards, result;
+    STATS_START(called);
+
+    if (!PyArg_ParseTupleAndKeywords(args, kwargs, "Oi|O", kwlist, &pyhands, &ncards, &pyout))
+        return NULL;
+    if (ncards < 5 || ncards > 7){
+        PyErr_SetString(PyExc_ValueError, "ncards must be 5, 6 or 7");
+        return NULL;
+    }
+
+    if (get_card_buffer(pyhands, &hands, ncards, &n) == FAIL)
+        return NULL;
+
+    if ( (out = get_output(pyout, n, &outview, 'H')) == NULL ){
+        PyBuffer_Release(&hands);
+        return NULL;
+    }
+
+    for (start = 0; start < n; start += chunk){
+        chunk = (n - start < BATCH_CHUNK) ? n - start : BATCH_CHUNK;
+        if (read_cards(&hands, start * ncards, chunk * ncards, cards) == FAIL){
+            Py_CLEAR(out);
+            break;
+        }
+        Py_BEGIN_ALLOW_THREADS
+        result = batch(cards, (int) chunk, ncards, (uint16_t *) outview.buf + start);
+        Py_END_ALLOW_THREADS
+        if (result == FAIL){
+            PyErr_SetString(PyExc_ValueError, "duplicate cards");
+            Py_CLEAR(out);
+            break;
+        }
+    }
+
+    PyBuffer_Release(&outview);
+    PyBuffer_Release(&hands);
+    if (out)
+        STATS_CALL(entry, called, (uint64_t) n);
+    return out;
+}
+
+static PyObject *cpoker_best5_ranks(PyObject *self, PyObject *args, PyObject *kwargs){
+    return rank_rows(args, kwargs, best5_rank_batch, STAT_BEST5_RANKS);
+}
+
+
+const char low_rank_doc[] =
+"low_rank(cards) -> int\n\n"
+"Return the ace to five low, 8 or better, of 5 to 7 cards: 0 for no\n"
+"low, otherwise from 1 for 8-7-6-5-4 to 56 for 5-4-3-2-A.\n";
+
+static PyObject *cpoker_low_rank(PyObject *self, PyObject *const *args, Py_ssize_t nargs, PyObject *kwnames){
+    static const char *const kwlist[] = {"cards", NULL};
+    PyObject *pycards;
+    uint32_t cards[7];
+    int n, low;
+    STATS_START(start);
+
+    if (parse_fast("low_rank", args, nargs, kwnames, kwlist, 1, &pycards) == FAIL)
+        return NULL;
+    if ( (n = count_cards(pycards)) < 5 || n > 7 ){
+        PyErr_SetString(PyExc_ValueError, "cards must be a list of 5 to 7 cards");
+        return NULL;
+    }
+    if (convert_cards(pycards, cards, n) == FAIL)
+        return NULL;
+    if ( (low = low_rank(cards, n)) == FAIL ){
+        PyErr_SetString(PyExc_ValueError, "bad or duplicate cards");
+        return NULL;
+    }
+    STATS_CALL(STAT_LOW_RANK, start, 1);
+    return PyInt_FromLong(low);
+}
+
+
+const char low_ranks_doc[] =
+"low_ranks(hands, ncards, [out]) -> array\n\n"
+"Return the low_rank of each of many hands, as best5_ranks.\n";
+
+static PyObject *cpoker_low_ranks(PyObject *self, PyObject *args, PyObject *kwargs){
+    return rank_rows(args, kwargs, low_rank_batch, STAT_LOW_RANKS);
 }
 
 
@@ -111,57 +712,68 @@ const char holdem2p_doc[] =
 "1 -> hand2 wins\n"
 "2 -> tie\n";
 
-static PyObject *cpoker_holdem2p(PyObject *self, PyObject *args){
-    PyObject *pyh1, *pyh2, *pyboard;
+static PyObject *cpoker_holdem2p(PyObject *self, PyObject *const *args, Py_ssize_t nargs, PyObject *kwnames){
+    static const char *const kwlist[] = {"hand1", "hand2", "board", NULL};
+    PyObject *parsed[3];
     uint32_t ch1[2], ch2[2], cboard[5];
-    if ( ! PyArg_ParseTuple(args, "OOO", &pyh1, &pyh2, &pyboard ) )
+    int winner;
+    STATS_START(start);
+    if ( parse_fast("holdem2p", args, nargs, kwnames, kwlist, 3, parsed) == FAIL )
         return NULL;
 
-    if (convert_cards(pyboard, cboard, 5) == FAIL){
+    if (convert_cards(parsed[2], cboard, 5) == FAIL){
         return NULL;
     }
-    if (convert_cards(pyh1, ch1, 2) == FAIL){
+    if (convert_cards(parsed[0], ch1, 2) == FAIL){
         return NULL;
     }
-    if (convert_cards(pyh2, ch2, 2) == FAIL){
+    if (convert_cards(parsed[1], ch2, 2) == FAIL){
         return NULL;
     }
-    return (PyObject*) PyInt_FromLong(holdem2p(ch1, ch2, cboard));
+    winner = holdem2p(ch1, ch2, cboard);
+    STATS_CALL(STAT_HOLDEM2P, start, 2);
+    return (PyObject*) PyInt_FromLong(winner);
 }
 
 
 const char multi_holdem_doc[] =
-"multi_holdem(hands, board) -> list\n\n"
+"multi_holdem(hands, board, out=None) -> list\n\n"
 "Return the indices of all hands tied for the win.\n"
-"hands -> list of hands\n"
-"board -> five card board\n";
+"hands -> sequence of hands, or a buffer of integer cards shaped (N, 2)\n"
+"board -> five card board\n"
+"out -> optional writable int32 buffer with room for every hand.\n"
+"    The winners go at its front and their number is returned.\n";
 
 
-static PyObject *cpoker_multi_holdem(PyObject *self, PyObject *args){
-    PyObject *pyhands, *pyboard;
+static PyObject *cpoker_multi_holdem(PyObject *self, PyObject *const *args, Py_ssize_t nargs, PyObject *kwnames){
+    static const char *const kwlist[] = {"hands", "board", "out", NULL};
+    PyObject *parsed[3], *out;
+    Py_buffer outview;
     uint32_t chands[MAX_HANDS][2], cboard[5];
     int winners[MAX_HANDS] = {-1,-1,-1,-1,-1};
-    int nhands, nwinners, i;
+    int nhands, nwinners, nhole = 2;
+    STATS_START(start);
 
-    if ( ! PyArg_ParseTuple(args, "OO", &pyhands, &pyboard ) )
+    if ( parse_fast("multi_holdem", args, nargs, kwnames, kwlist, 2, parsed) == FAIL )
         return NULL;
 
-    if ( (nhands = (int) PyList_Size(pyhands)) == FAIL ){
-        PyErr_SetString(PyExc_TypeError, "multi_holdem requires a list of hands");
+    if ( (nhands = convert_hands(parsed[0], chands[0], &nhole, 1, "multi_holdem")) == FAIL )
         return NULL;
-    }
-
-    for (i = 0; i < nhands; i++){
-        if (convert_cards(PyList_GetItem(pyhands, i), chands[i], 2) == FAIL){
-            return NULL;
-        }
-    }
 
-    if (convert_cards(pyboard, cboard, 5) == FAIL){
+    if (convert_cards(parsed[1], cboard, 5) == FAIL){
         return NULL;
     }
     nwinners = multi_holdem(chands, nhands, cboard, winners);
-    return (PyObject*) buildListFromArray(winners, nwinners, 'i');
+    STATS_CALL(STAT_MULTI_HOLDEM, start, nhands);
+    if (parsed[2] == NULL || parsed[2] == Py_None)
+        return (PyObject*) buildListFromArray(winners, nwinners, 'i');
+
+    if ( (out = get_output(parsed[2], nhands, &outview, 'i')) == NULL )
+        return NULL;
+    memcpy(outview.buf, winners, nwinners * sizeof(int));
+    PyBuffer_Release(&outview);
+    Py_DECREF(out);
+    return PyInt_FromLong(nwinners);
 }
 
 
@@ -171,34 +783,43 @@ const char rivervalue_doc[] =
 "vs all 990 opposing hand combinations;\n\n"
 "Optionally, supplying True for optimistic returns\n"
 "(wins + ties) / total.\n"
+"hand and board may be any sequences or buffers of integer cards.\n"
 "This is a convenience function as the result can\n"
 "easily be derived from riverties().\n";
 
-static PyObject * cpoker_rivervalue ( PyObject * self, PyObject * args )
+static PyObject * cpoker_rivervalue ( PyObject *self, PyObject *const *args, Py_ssize_t nargs,
+                                      PyObject *kwnames )
 {
-    PyObject *pyhand, *pyboard;
+    static const char *const kwlist[] = {"hand", "board", "optimistic", NULL};
+    PyObject *parsed[3];
     uint32_t hand[2], board[5];
     int optimistic = 0;
     double tie_bonus;
     struct rivervalue value;
     static const double nmatches = 990;
+    STATS_START(start);
 
-    if (!PyArg_ParseTuple(args, "OO|i", &pyhand, &pyboard, &optimistic))
+    if (parse_fast("rivervalue", args, nargs, kwnames, kwlist, 2, parsed) == FAIL)
+        return NULL;
+    if (parsed[2] && (optimistic = PyObject_IsTrue(parsed[2])) == FAIL)
         return NULL;
 
-    if (convert_cards(pyhand, hand, 2) == FAIL){
+    if (convert_cards(parsed[0], hand, 2) == FAIL){
         return NULL;
     }
 
-    if (convert_cards(pyboard, board, 5) == FAIL){
+    if (convert_cards(parsed[1], board, 5) == FAIL){
         return NULL;
     }
 
+    Py_BEGIN_ALLOW_THREADS
     value = rivervalue(hand, board);
+    Py_END_ALLOW_THREADS
     if ( value.wins == FAIL ){
         PyErr_SetString(PyExc_ValueError, "duplicate cards");
         return NULL;
     }
+    STATS_CALL(STAT_RIVERVALUE, start, 1);
     tie_bonus = (optimistic) ? value.ties : (value.ties / 2.0);
     return (PyObject *) PyFloat_FromDouble( (value.wins + tie_bonus) / nmatches );
 }
@@ -208,65 +829,78 @@ const char riverties_doc[] =
 "Return the tuple <number of wins>, <number of ties>\n"
 "vs all 990 opposing hand combinations\n";
 
-static PyObject * cpoker_riverties ( PyObject * self, PyObject * args )
+static PyObject * cpoker_riverties ( PyObject *self, PyObject *const *args, Py_ssize_t nargs,
+                                     PyObject *kwnames )
 {
-    PyObject *pyhand, *pyboard;
+    static const char *const kwlist[] = {"hand", "board", NULL};
+    PyObject *parsed[2];
     uint32_t hand[2], board[5];
     struct rivervalue value;
+    STATS_START(start);
 
-    if (!PyArg_ParseTuple(args, "OO", &pyhand, &pyboard))
+    if (parse_fast("riverties", args, nargs, kwnames, kwlist, 2, parsed) == FAIL)
         return NULL;
 
-    if (convert_cards(pyhand, hand, 2) == FAIL){
+    if (convert_cards(parsed[0], hand, 2) == FAIL){
         return NULL;
     }
 
-    if (convert_cards(pyboard, board, 5) == FAIL){
+    if (convert_cards(parsed[1], board, 5) == FAIL){
         return NULL;
     }
 
+    Py_BEGIN_ALLOW_THREADS
     value = rivervalue(hand, board);
+    Py_END_ALLOW_THREADS
     if ( value.wins == FAIL ){
         PyErr_SetString(PyExc_ValueError, "duplicate cards");
         return NULL;
     }
+    STATS_CALL(STAT_RIVERTIES, start, 1);
     return (PyObject *) Py_BuildValue( "ii", value.wins, value.ties );
 }
 
 
 const char full_enumeration_doc[] =
-"full_enumeration(hands, [board]) -> list\n\n"
+"full_enumeration(hands, [board], threads=1, out=None) -> list\n\n"
 "Return a list of evs for each respective hand.\n\n"
 "This is accomplished by counting wins and ties for\n"
 "each hand on every possible board runnout.\n"
 "Ties are rewarded 1.0/ntied the score of a win.\n"
-"This is optimized for 2 players, ie. 3 players is around 3xslower.\n";
-
-int full_enumeration(uint32_t hands[MAX_HANDS][2], int nhands, uint32_t board[5], int nboard, double results[]);
-
+"This is optimized for 2 players, ie. 3 players is around 3xslower.\n"
+"hands -> sequence of hands, or a buffer of integer cards shaped (N, 2)\n"
+"threads -> number of threads to share the work, 0 for one per cpu.\n"
+"    The results are the same for any number of threads.\n"
+"out -> optional writable float64 buffer to hold the evs, which is\n"
+"    returned in place of a list.\n";
 
 //change to allow board and use a list for hands
-static PyObject * cpoker_full_enumeration ( PyObject * self, PyObject * args )
+static PyObject * cpoker_full_enumeration ( PyObject * self, PyObject * args, PyObject *kwargs )
 {
-    PyObject *pyhands, *pyboard = NULL;
+    static char *kwlist[] = {"hands", "board", "threads", "out", NULL};
+    PyObject *pyhands, *pyboard = NULL, *pyout = Py_None, *out = NULL;
+    Py_buffer outview;
     uint32_t hands[MAX_HANDS][2], board[5];
-    double results[MAX_HANDS];
-    int i, nhands, nboard = 0;
+    uint64_t counts[3];
+    double results[MAX_HANDS], total;
+    int nhands, nhole = 2, nboard = 0, nthreads = 1, result = SUCCESS;
+    STATS_START(start);
 
-    if (!PyArg_ParseTuple(args, "O|O", &pyhands, &pyboard))
+    if (!PyArg_ParseTupleAndKeywords(args, kwargs, "O|OiO", kwlist, &pyhands, &pyboard, &nthreads,
+                                     &pyout))
         return NULL;
 
-    if ( (nhands = (int) PyList_Size(pyhands)) <= 1 ){ // this also happens if 'pyhands' is not a list
-        PyErr_SetString(PyExc_TypeError, "full_enumeration requires a list of hands");
+    if (nthreads < 0){
+        PyErr_SetString(PyExc_ValueError, "threads must not be negative");
         return NULL;
     }
+    if (pyboard == Py_None)
+        pyboard = NULL;
 
-    if (nhands > MAX_HANDS){
-        PyErr_SetString(PyExc_ValueError, "too many hands");
+    if ( (nhands = convert_hands(pyhands, hands[0], &nhole, 2, "full_enumeration")) == FAIL )
         return NULL;
-    }
 
-    if ( pyboard && ( (nboard = (int) PyList_Size(pyboard)) > 4 || nboard == FAIL ) ){
+    if ( pyboard && ( (nboard = count_cards(pyboard)) > 4 || nboard == FAIL ) ){
         PyErr_SetString(PyExc_ValueError, "board must be a list of 0-4 cards");
         return NULL;
     }
@@ -275,28 +909,95 @@ static PyObject * cpoker_full_enumeration ( PyObject * self, PyObject * args )
         return NULL;
     }
 
-    for (i = 0; i < nhands; i++){
-        if (convert_cards(PyList_GetItem(pyhands, i), hands[i], 2) == FAIL){
-            return NULL;
+    if ( pyout != Py_None && (out = get_output(pyout, nhands, &outview, 'd')) == NULL )
+        return NULL;
+
+    Py_BEGIN_ALLOW_THREADS
+    if (nhands == 2 && !nboard){
+        if ( (results[0] = enum2p(hands[0], hands[1], nthreads)) == FAIL )
+            result = FAIL;
+        results[1] = 1.0 - results[0];
+    }
+    else if (nhands == 2 && nboard >= 3){
+        if ( (result = headsup_board_counts(hands[0], hands[1], board, nboard, counts)) != FAIL ){
+            total = (double) (counts[0] + counts[1] + counts[2]);
+            results[0] = (counts[0] + 0.5 * (double) counts[2]) / total;
+            results[1] = (counts[1] + 0.5 * (double) counts[2]) / total;
         }
     }
-    if (nhands == 2 && !nboard){
-        if ( (results[0] = enum2p(hands[0], hands[1])) == FAIL ){
-            PyErr_SetString(PyExc_ValueError, "duplicate cards");
+    else
+        result = full_enumeration(hands, nhands, board, nboard, results, nthreads);
+    Py_END_ALLOW_THREADS
+
+    if (result == FAIL){
+        PyErr_SetString(PyExc_ValueError, "duplicate cards");
+        if (out){
+            PyBuffer_Release(&outview);
+            Py_DECREF(out);
+        }
+        return NULL;
+    }
+    STATS_CALL(STAT_FULL_ENUMERATION, start, nhands);
+    if (out == NULL)
+        return (PyObject *) buildListFromArray( results, nhands, 'd');
+    memcpy(outview.buf, results, nhands * sizeof(double));
+    PyBuffer_Release(&outview);
+    return out;
+}
+
+
+const char headsup_counts_doc[] =
+"headsup_counts(hand1, hand2, [board], threads=1) -> tuple\n\n"
+"Return the exact (hand1 wins, hand2 wins, ties) over every runout\n"
+"of a board of 0, 3 or 4 cards, which full_enumeration's evs for two\n"
+"hands come from.  Preflop counts come from the preflop table when one\n"
+"is loaded, and threads share them otherwise.\n";
+
+static PyObject *cpoker_headsup_counts(PyObject *self, PyObject *args, PyObject *kwargs){
+    static char *kwlist[] = {"hand1", "hand2", "board", "threads", NULL};
+    PyObject *pyh1, *pyh2, *pyboard = Py_None;
+    uint32_t h1[2], h2[2], board[5];
+    uint64_t counts[3];
+    int nboard = 0, nthreads = 1, result;
+    STATS_START(start);
+
+    if (!PyArg_ParseTupleAndKeywords(args, kwargs, "OO|Oi", kwlist, &pyh1, &pyh2, &pyboard, &nthreads))
+        return NULL;
+    if (nthreads < 0){
+        PyErr_SetString(PyExc_ValueError, "threads must not be negative");
+        return NULL;
+    }
+    if (convert_cards(pyh1, h1, 2) == FAIL || convert_cards(pyh2, h2, 2) == FAIL)
+        return NULL;
+    if (pyboard != Py_None){
+        nboard = count_cards(pyboard);
+        if (nboard != 0 && nboard != 3 && nboard != 4){
+            PyErr_SetString(PyExc_ValueError, "board must be a list of 0, 3 or 4 cards");
             return NULL;
         }
-        results[1] = 1.0 - results[0];
+        if (convert_cards(pyboard, board, nboard) == FAIL)
+            return NULL;
     }
-    else if ( full_enumeration(hands, nhands, board, nboard, results) == FAIL ){
+
+    Py_BEGIN_ALLOW_THREADS
+    if (nboard)
+        result = headsup_board_counts(h1, h2, board, nboard, counts);
+    else if ( (result = preflop_lookup(h1, h2, counts)) == FAIL )
+        result = headsup_counts(h1, h2, counts, nthreads);
+    Py_END_ALLOW_THREADS
+    if (result == FAIL){
         PyErr_SetString(PyExc_ValueError, "duplicate cards");
         return NULL;
     }
-    return (PyObject *) buildListFromArray( results, nhands, 'd');
+    STATS_CALL(STAT_HEADSUP_COUNTS, start, 2);
+    return Py_BuildValue("(KKK)", (unsigned long long) counts[0], (unsigned long long) counts[1],
+                         (unsigned long long) counts[2]);
 }
 
 
 const char monte_carlo_doc[] =
-"monte_carlo(hands, [n]) -> list\n\n"
+"monte_carlo(hands, [n], seed=None, threads=1, board=None, dead=None,\n"
+"            target_se=None, out=None) -> list\n\n"
 "Return a list of evs for each respective hand.\n\n"
 "This is accomplished by counting wins and ties\n"
 "for each on many random deals.\n"
@@ -304,47 +1005,472 @@ const char monte_carlo_doc[] =
 "You can optionally supply the number of deals which\n"
 "defaults to 100000.  Be aware that choosing a number\n"
 "much higher than that will not result in much time\n"
-"saved over full_enumeration.\n"
-"No board option is provided as in that case\n"
-"full_enumeration will always be the better option.\n";
-
+"saved over full_enumeration when there are few hands.\n"
+"seed -> an integer (0 to 2**64 - 1) to repeat the same deals, or None\n"
+"    for new ones.\n"
+"threads -> number of threads to share the deals, 0 for one per cpu.\n"
+"    A seed gives the same results for any number of threads.\n"
+"board -> a list of 0-4 board cards to deal the rest to.\n"
+"dead -> a list of cards that can't be dealt.\n"
+"target_se -> stop once the standard error of every ev is at most\n"
+"    this, with n as the most deals.  Then the return value is\n"
+"    (evs, standard errors, deals made).\n"
+"out -> optional writable float64 buffer to hold the evs, which is\n"
+"    returned in place of a list.\n"
+"Hands and cards may be any sequences or buffers of integer cards.\n";
 
 #define DEFAULT_RUNS 100000
 
-static PyObject *cpoker_monte_carlo ( PyObject * self, PyObject * args )
-{
-
-    PyObject *pyhands;
-    uint32_t hands[MAX_HANDS][2];
-    double results[MAX_HANDS];
-    int i, nhands, runs = DEFAULT_RUNS;
-
-    if (!PyArg_ParseTuple(args, "O|i", &pyhands, &runs))
+//game -> GAME_HOLDEM, GAME_OMAHA or GAME_SHORT
+static PyObject *simulate_hands(PyObject *args, PyObject *kwargs, int game){
+    static char *kwlist[] = {"hands", "n", "seed", "threads", "board", "dead", "target_se", "out", NULL};
+    static const char *names[] = {"monte_carlo", "omaha_monte_carlo", "short_monte_carlo"};
+    PyObject *pyhands, *pyseed = Py_None, *pyboard = Py_None, *pydead = Py_None, *pytarget = Py_None;
+    PyObject *pyout = Py_None, *out = NULL, *evs;
+    Py_buffer outview;
+    uint32_t holes[MAX_HANDS * MAX_HOLE], board[5], dead[52];
+    double results[MAX_HANDS], stderrs[MAX_HANDS], target_se = 0.0;
+    unsigned long long seed;
+    int nhands, nhole = (game == GAME_OMAHA) ? 0 : 2, nboard = 0, ndead = 0, runs = DEFAULT_RUNS, nthreads = 1, result;
+    STATS_START(start);
+
+    if (!PyArg_ParseTupleAndKeywords(args, kwargs, "O|iOiOOOO", kwlist, &pyhands, &runs, &pyseed,
+                                     &nthreads, &pyboard, &pydead, &pytarget, &pyout))
         return NULL;
 
-    if ( (nhands = (int) PyList_Size(pyhands)) <= 1 ){ // this also happens if 'pyhands' is not a list
-        PyErr_SetString(PyExc_TypeError, "monte_carlo requires a list of hands");
+    if (runs <= 0){
+        PyErr_SetString(PyExc_ValueError, "n must be positive");
         return NULL;
     }
-
-    if (nhands > MAX_HANDS){
-        PyErr_SetString(PyExc_ValueError, "too many hands");
+    if (nthreads < 0){
+        PyErr_SetString(PyExc_ValueError, "threads must not be negative");
         return NULL;
     }
-
-    for (i = 0; i < nhands; i++){
-        if (convert_cards(PyList_GetItem(pyhands, i), hands[i], 2) == FAIL){
+    if (pytarget != Py_None){
+        target_se = PyFloat_AsDouble(pytarget);
+        if (target_se == -1.0 && PyErr_Occurred())
+            return NULL;
+        if (target_se <= 0.0){
+            PyErr_SetString(PyExc_ValueError, "target_se must be positive");
             return NULL;
         }
     }
-
-    if ( monte_carlo(hands, nhands, runs, results) == FAIL ){
-        PyErr_SetString(PyExc_ValueError, "duplicate cards");
+    if (pyseed == Py_None)
+        seed = random_seed();
+    else if (read_uint64(pyseed, &seed) == FAIL)
         return NULL;
-    }
-    return (PyObject *) buildListFromArray( results, nhands, 'd');
-}
-
+
+    if ( (nhands = convert_hands(pyhands, holes, &nhole, 2, names[game])) == FAIL )
+        return NULL;
+
+    if (pyboard != Py_None){
+        if ( (nboard = count_cards(pyboard)) > 4 || nboard == FAIL ){
+            PyErr_SetString(PyExc_ValueError, "board must be a list of 0-4 cards");
+            return NULL;
+        }
+        if (convert_cards(pyboard, board, nboard) == FAIL)
+            return NULL;
+    }
+
+    if (pydead != Py_None){
+        if ( (ndead = count_cards(pydead)) > 52 || ndead == FAIL ){
+            PyErr_SetString(PyExc_ValueError, "dead must be a list of cards");
+            return NULL;
+        }
+        if (convert_cards(pydead, dead, ndead) == FAIL)
+            return NULL;
+    }
+
+    if ( pyout != Py_None && (out = get_output(pyout, nhands, &outview, 'd')) == NULL )
+        return NULL;
+
+    Py_BEGIN_ALLOW_THREADS
+    if (game == GAME_OMAHA)
+        result = omaha_monte_carlo(holes, nhole, nhands, board, nboard, dead, ndead, runs, target_se,
+                                   results, stderrs, seed, nthreads);
+    else if (game == GAME_SHORT)
+        result = short_monte_carlo((uint32_t (*)[2]) holes, nhands, board, nboard, dead, ndead, runs,
+                                   target_se, results, stderrs, seed, nthreads);
+    else
+        result = monte_carlo((uint32_t (*)[2]) holes, nhands, board, nboard, dead, ndead, runs,
+                             target_se, results, stderrs, seed, nthreads);
+    Py_END_ALLOW_THREADS
+    if (result == FAIL){
+        PyErr_SetString(PyExc_ValueError, "duplicate cards or too few cards left to deal");
+        if (out){
+            PyBuffer_Release(&outview);
+            Py_DECREF(out);
+        }
+        return NULL;
+    }
+    STATS_CALL((game == GAME_OMAHA) ? STAT_OMAHA_MONTE_CARLO :
+               (game == GAME_SHORT) ? STAT_SHORT_MONTE_CARLO : STAT_MONTE_CARLO,
+               start, nhands);
+    if (out){
+        memcpy(outview.buf, results, nhands * sizeof(double));
+        PyBuffer_Release(&outview);
+        evs = out;
+    }
+    else
+        evs = buildListFromArray(results, nhands, 'd');
+    if (pytarget == Py_None)
+        return evs;
+    return Py_BuildValue("(NNi)", evs, buildListFromArray(stderrs, nhands, 'd'), result);
+}
+
+static PyObject *cpoker_monte_carlo ( PyObject * self, PyObject * args, PyObject *kwargs )
+{
+    return simulate_hands(args, kwargs, GAME_HOLDEM);
+}
+
+
+const char omaha_rank_doc[] =
+"omaha_rank(hand, board) -> int\n\n"
+"Return the strength of an Omaha hand of 4 or 5 cards on a board of\n"
+"3-5 cards, playing exactly 2 hole cards and 3 board cards.\n"
+"The value is on the best5_rank scale.\n";
+
+static PyObject *cpoker_omaha_rank(PyObject *self, PyObject *const *args, Py_ssize_t nargs, PyObject *kwnames){
+    static const char *const kwlist[] = {"hand", "board", NULL};
+    PyObject *parsed[2], *pyhand, *pyboard;
+    uint32_t hand[MAX_HOLE], board[5];
+    int nhole, nboard, rank;
+    STATS_START(start);
+
+    if (parse_fast("omaha_rank", args, nargs, kwnames, kwlist, 2, parsed) == FAIL)
+        return NULL;
+    pyhand = parsed[0];
+    pyboard = parsed[1];
+    if ( (nhole = count_cards(pyhand)) < 4 || nhole > MAX_HOLE ){
+        PyErr_SetString(PyExc_ValueError, "Omaha hands must be lists of 4 or 5 cards");
+        return NULL;
+    }
+    if ( (nboard = count_cards(pyboard)) < 3 || nboard > 5 ){
+        PyErr_SetString(PyExc_ValueError, "board must be a list of 3-5 cards");
+        return NULL;
+    }
+    if (convert_cards(pyhand, hand, nhole) == FAIL || convert_cards(pyboard, board, nboard) == FAIL)
+        return NULL;
+    if ( (rank = omaha_rank(hand, nhole, board, nboard)) == FAIL ){
+        PyErr_SetString(PyExc_ValueError, "bad or duplicate cards");
+        return NULL;
+    }
+    STATS_CALL(STAT_OMAHA_RANK, start, 1);
+    return PyInt_FromLong(rank);
+}
+
+
+const char multi_omaha_doc[] =
+"multi_omaha(hands, board) -> list\n\n"
+"Return the indices of all Omaha hands tied for the win.\n"
+"hands -> list of hands of 4 or 5 cards each\n"
+"board -> five card board\n";
+
+static PyObject *cpoker_multi_omaha(PyObject *self, PyObject *args){
+    PyObject *pyhands, *pyboard;
+    uint32_t holes[MAX_HANDS * MAX_HOLE], board[5];
+    int winners[MAX_HANDS];
+    bool dead[52];
+    int nhands, nhole = 0, nwinners;
+    STATS_START(start);
+
+    if (!PyArg_ParseTuple(args, "OO", &pyhands, &pyboard))
+        return NULL;
+    if ( (nhands = convert_hands(pyhands, holes, &nhole, 2, "multi_omaha")) == FAIL )
+        return NULL;
+    if (convert_cards(pyboard, board, 5) == FAIL)
+        return NULL;
+    if (set_dead(holes, nhands * nhole, board, 5, dead) == FAIL ||
+        (nwinners = multi_omaha(holes, nhole, nhands, board, winners)) == FAIL){
+        PyErr_SetString(PyExc_ValueError, "bad or duplicate cards");
+        return NULL;
+    }
+    STATS_CALL(STAT_MULTI_OMAHA, start, nhands);
+    return (PyObject *) buildListFromArray(winners, nwinners, 'i');
+}
+
+
+const char omaha_enumeration_doc[] =
+"omaha_enumeration(hands, [board], threads=1) -> list\n\n"
+"Return a list of evs for each respective Omaha hand of 4 or 5\n"
+"cards, counted over every board runout like full_enumeration.\n"
+"board -> a list of 0-5 board cards.\n"
+"threads -> number of threads to share the work, 0 for one per cpu.\n"
+"    The results are the same for any number of threads.\n";
+
+static PyObject *cpoker_omaha_enumeration(PyObject *self, PyObject *args, PyObject *kwargs){
+    static char *kwlist[] = {"hands", "board", "threads", NULL};
+    PyObject *pyhands, *pyboard = Py_None;
+    uint32_t holes[MAX_HANDS * MAX_HOLE], board[5];
+    double results[MAX_HANDS];
+    int nhands, nhole = 0, nboard = 0, nthreads = 1, result;
+    STATS_START(start);
+
+    if (!PyArg_ParseTupleAndKeywords(args, kwargs, "O|Oi", kwlist, &pyhands, &pyboard, &nthreads))
+        return NULL;
+    if (nthreads < 0){
+        PyErr_SetString(PyExc_ValueError, "threads must not be negative");
+        return NULL;
+    }
+    if ( (nhands = convert_hands(pyhands, holes, &nhole, 2, "omaha_enumeration")) == FAIL )
+        return NULL;
+    if (pyboard != Py_None){
+        if ( (nboard = count_cards(pyboard)) > 5 || nboard == FAIL ){
+            PyErr_SetString(PyExc_ValueError, "board must be a list of 0-5 cards");
+            return NULL;
+        }
+        if (convert_cards(pyboard, board, nboard) == FAIL)
+            return NULL;
+    }
+
+    Py_BEGIN_ALLOW_THREADS
+    result = omaha_enumeration(holes, nhole, nhands, board, nboard, results, nthreads);
+    Py_END_ALLOW_THREADS
+    if (result == FAIL){
+        PyErr_SetString(PyExc_ValueError, "duplicate cards or too many hands");
+        return NULL;
+    }
+    STATS_CALL(STAT_OMAHA_ENUMERATION, start, nhands);
+    return (PyObject *) buildListFromArray(results, nhands, 'd');
+}
+
+
+const char omaha_monte_carlo_doc[] =
+"omaha_monte_carlo(hands, [n], seed=None, threads=1, board=None, dead=None,\n"
+"                  target_se=None, out=None) -> list\n\n"
+"monte_carlo for Omaha hands of 4 or 5 cards.\n";
+
+static PyObject *cpoker_omaha_monte_carlo(PyObject *self, PyObject *args, PyObject *kwargs){
+    return simulate_hands(args, kwargs, GAME_OMAHA);
+}
+
+const char omaha_low_doc[] =
+"omaha_low(hand, board) -> int\n\n"
+"Return the 8 or better low (see low_rank) of an Omaha hand of 4 or 5\n"
+"cards on a board of 3-5 cards, playing 2 hole and 3 board cards.\n";
+
+static PyObject *cpoker_omaha_low(PyObject *self, PyObject *args){
+    PyObject *pyhand, *pyboard;
+    uint32_t hand[MAX_HOLE], board[5];
+    int nhole, nboard, low;
+    STATS_START(start);
+
+    if (!PyArg_ParseTuple(args, "OO", &pyhand, &pyboard))
+        return NULL;
+    if ( (nhole = count_cards(pyhand)) < 4 || nhole > MAX_HOLE ){
+        PyErr_SetString(PyExc_ValueError, "Omaha hands must be lists of 4 or 5 cards");
+        return NULL;
+    }
+    if ( (nboard = count_cards(pyboard)) < 3 || nboard > 5 ){
+        PyErr_SetString(PyExc_ValueError, "board must be a list of 3-5 cards");
+        return NULL;
+    }
+    if (convert_cards(pyhand, hand, nhole) == FAIL || convert_cards(pyboard, board, nboard) == FAIL)
+        return NULL;
+    if ( (low = omaha_low(hand, nhole, board, nboard)) == FAIL ){
+        PyErr_SetString(PyExc_ValueError, "bad or duplicate cards");
+        return NULL;
+    }
+    STATS_CALL(STAT_OMAHA_LOW, start, 1);
+    return PyInt_FromLong(low);
+}
+
+
+const char multi_omaha_hilo_doc[] =
+"multi_omaha_hilo(hands, board) -> (list, list)\n\n"
+"Return the indices of the Omaha hands tied for the high half and of\n"
+"those tied for the 8 or better low half, which is empty when no hand\n"
+"has a low.\n";
+
+static PyObject *cpoker_multi_omaha_hilo(PyObject *self, PyObject *args){
+    PyObject *pyhands, *pyboard;
+    uint32_t holes[MAX_HANDS * MAX_HOLE], board[5];
+    int hiwinners[MAX_HANDS], lowinners[MAX_HANDS];
+    bool dead[52];
+    int nhands, nhole = 0, nhi, nlow;
+    STATS_START(start);
+
+    if (!PyArg_ParseTuple(args, "OO", &pyhands, &pyboard))
+        return NULL;
+    if ( (nhands = convert_hands(pyhands, holes, &nhole, 2, "multi_omaha_hilo")) == FAIL )
+        return NULL;
+    if (convert_cards(pyboard, board, 5) == FAIL)
+        return NULL;
+    if (set_dead(holes, nhands * nhole, board, 5, dead) == FAIL ||
+        (nhi = multi_omaha_hilo(holes, nhole, nhands, board, hiwinners, lowinners, &nlow)) == FAIL){
+        PyErr_SetString(PyExc_ValueError, "bad or duplicate cards");
+        return NULL;
+    }
+    STATS_CALL(STAT_MULTI_OMAHA_HILO, start, nhands);
+    return Py_BuildValue("(NN)", buildListFromArray(hiwinners, nhi, 'i'),
+                         buildListFromArray(lowinners, nlow, 'i'));
+}
+
+
+const char omaha_hilo_enumeration_doc[] =
+"omaha_hilo_enumeration(hands, [board], threads=1) -> list\n\n"
+"Return an (ev, hi, lo, scoop) tuple for each Omaha hi/lo 8 or better\n"
+"hand, counted over every board runout in one pass:\n"
+"ev -> its share of the pot, the high taking all of it with no low\n"
+"hi, lo -> its share of the high and of the low half (0 with no low)\n"
+"scoop -> how often it takes the whole pot alone\n"
+"board and threads are as for omaha_enumeration.\n";
+
+static PyObject *cpoker_omaha_hilo_enumeration(PyObject *self, PyObject *args, PyObject *kwargs){
+    static char *kwlist[] = {"hands", "board", "threads", NULL};
+    PyObject *pyhands, *pyboard = Py_None, *list, *item;
+    uint32_t holes[MAX_HANDS * MAX_HOLE], board[5];
+    hilo results[MAX_HANDS];
+    int i, nhands, nhole = 0, nboard = 0, nthreads = 1, result;
+    STATS_START(start);
+
+    if (!PyArg_ParseTupleAndKeywords(args, kwargs, "O|Oi", kwlist, &pyhands, &pyboard, &nthreads))
+        return NULL;
+    if (nthreads < 0){
+        PyErr_SetString(PyExc_ValueError, "threads must not be negative");
+        return NULL;
+    }
+    if ( (nhands = convert_hands(pyhands, holes, &nhole, 2, "omaha_hilo_enumeration")) == FAIL )
+        return NULL;
+    if (pyboard != Py_None){
+        if ( (nboard = count_cards(pyboard)) > 5 || nboard == FAIL ){
+            PyErr_SetString(PyExc_ValueError, "board must be a list of 0-5 cards");
+            return NULL;
+        }
+        if (convert_cards(pyboard, board, nboard) == FAIL)
+            return NULL;
+    }
+
+    Py_BEGIN_ALLOW_THREADS
+    result = omaha_hilo_enumeration(holes, nhole, nhands, board, nboard, results, nthreads);
+    Py_END_ALLOW_THREADS
+    if (result == FAIL){
+        PyErr_SetString(PyExc_ValueError, "duplicate cards or too many hands");
+        return NULL;
+    }
+    STATS_CALL(STAT_OMAHA_HILO_ENUMERATION, start, nhands);
+    if ( (list = PyList_New(nhands)) == NULL )
+        return NULL;
+    for (i = 0; i < nhands; i++){
+        if ( (item = Py_BuildValue("(dddd)", results[i].ev, results[i].hi, results[i].lo,
+                                   results[i].scoop)) == NULL ){
+            Py_DECREF(list);
+            return NULL;
+        }
+        PyList_SET_ITEM(list, i, item);
+    }
+    return list;
+}
+
+const char short_rank_doc[] =
+"short_rank(cards) -> int\n\n"
+"Return the strength of 7 short deck (6+) cards, 0-35 (ace to six),\n"
+"where A-6-7-8-9 is a straight and a flush beats a full house.\n"
+"Higher values are better hands and tied hands get equal values.\n";
+
+static PyObject *cpoker_short_rank(PyObject *self, PyObject *const *args, Py_ssize_t nargs, PyObject *kwnames){
+    static const char *const kwlist[] = {"cards", NULL};
+    PyObject *pycards;
+    uint32_t cards[7];
+    int rank;
+    STATS_START(start);
+
+    if (parse_fast("short_rank", args, nargs, kwnames, kwlist, 1, &pycards) == FAIL)
+        return NULL;
+    if (convert_cards(pycards, cards, 7) == FAIL)
+        return NULL;
+    if ( (rank = short_rank(cards)) == FAIL ){
+        PyErr_SetString(PyExc_ValueError, "bad or duplicate cards");
+        return NULL;
+    }
+    STATS_CALL(STAT_SHORT_RANK, start, 1);
+    return PyInt_FromLong(rank);
+}
+
+
+const char short_rivervalue_doc[] =
+"short_rivervalue(hand, board, [optimistic]) -> float\n\n"
+"rivervalue for short deck hold'em, against the 406 hands the\n"
+"short deck leaves.\n";
+
+static PyObject *cpoker_short_rivervalue(PyObject *self, PyObject *args){
+    PyObject *pyhand, *pyboard;
+    uint32_t hand[2], board[5];
+    int optimistic = 0;
+    double tie_bonus;
+    struct rivervalue value;
+    static const double nmatches = 406;
+    STATS_START(start);
+
+    if (!PyArg_ParseTuple(args, "OO|i", &pyhand, &pyboard, &optimistic))
+        return NULL;
+    if (convert_cards(pyhand, hand, 2) == FAIL || convert_cards(pyboard, board, 5) == FAIL)
+        return NULL;
+
+    Py_BEGIN_ALLOW_THREADS
+    value = short_rivervalue(hand, board);
+    Py_END_ALLOW_THREADS
+    if (value.wins == FAIL){
+        PyErr_SetString(PyExc_ValueError, "duplicate cards or cards not in a short deck");
+        return NULL;
+    }
+    STATS_CALL(STAT_SHORT_RIVERVALUE, start, 1);
+    tie_bonus = (optimistic) ? value.ties : (value.ties / 2.0);
+    return (PyObject *) PyFloat_FromDouble( (value.wins + tie_bonus) / nmatches );
+}
+
+
+const char short_enumeration_doc[] =
+"short_enumeration(hands, [board], threads=1) -> list\n\n"
+"full_enumeration for short deck hold'em.\n"
+"board -> a list of 0-5 board cards.\n";
+
+static PyObject *cpoker_short_enumeration(PyObject *self, PyObject *args, PyObject *kwargs){
+    static char *kwlist[] = {"hands", "board", "threads", NULL};
+    PyObject *pyhands, *pyboard = Py_None;
+    uint32_t holes[MAX_HANDS * 2], board[5];
+    double results[MAX_HANDS];
+    int nhands, nhole = 2, nboard = 0, nthreads = 1, result;
+    STATS_START(start);
+
+    if (!PyArg_ParseTupleAndKeywords(args, kwargs, "O|Oi", kwlist, &pyhands, &pyboard, &nthreads))
+        return NULL;
+    if (nthreads < 0){
+        PyErr_SetString(PyExc_ValueError, "threads must not be negative");
+        return NULL;
+    }
+    if ( (nhands = convert_hands(pyhands, holes, &nhole, 2, "short_enumeration")) == FAIL )
+        return NULL;
+    if (pyboard != Py_None){
+        if ( (nboard = count_cards(pyboard)) > 5 || nboard == FAIL ){
+            PyErr_SetString(PyExc_ValueError, "board must be a list of 0-5 cards");
+            return NULL;
+        }
+        if (convert_cards(pyboard, board, nboard) == FAIL)
+            return NULL;
+    }
+
+    Py_BEGIN_ALLOW_THREADS
+    result = short_enumeration((uint32_t (*)[2]) holes, nhands, board, nboard, results, nthreads);
+    Py_END_ALLOW_THREADS
+    if (result == FAIL){
+        PyErr_SetString(PyExc_ValueError, "duplicate cards, cards not in a short deck or too many hands");
+        return NULL;
+    }
+    STATS_CALL(STAT_SHORT_ENUMERATION, start, nhands);
+    return (PyObject *) buildListFromArray(results, nhands, 'd');
+}
+
+
+const char short_monte_carlo_doc[] =
+"short_monte_carlo(hands, [n], seed=None, threads=1, board=None, dead=None,\n"
+"                  target_se=None, out=None) -> list\n\n"
+"monte_carlo for short deck hold'em.\n";
+
+static PyObject *cpoker_short_monte_carlo(PyObject *self, PyObject *args, PyObject *kwargs){
+    return simulate_hands(args, kwargs, GAME_SHORT);
+}
+
 
 
 int GET_INDEX(uint32_t c1, uint32_t c2){
@@ -355,10 +1481,661 @@ int GET_INDEX(uint32_t c1, uint32_t c2){
         c2 = c1 ^ c2;
         c1 = c1 ^ c2;
     }
-    return c1 * 52 - c1 * (c1 + 1) / 2 + c2 - c1 - 1;
+    return c1 * 52 - c1 * (c1 + 1) / 2 + c2 - c1 - 1;
+}
+
+
+
+//fill weights from a list of NUM_STARTING_HANDS weights in GET_INDEX
+//order or a dict of some card tuples to weights
+static int convert_range(PyObject *pyrange, double weights[NUM_STARTING_HANDS]){
+    PyObject *key, *value;
+    Py_ssize_t pos = 0;
+    int i, c1, c2;
+    double w;
+
+    if (PyList_Check(pyrange)){
+        if (PyList_GET_SIZE(pyrange) != NUM_STARTING_HANDS){
+            PyErr_SetString(PyExc_ValueError, "range lists must contain 1326 weights (one for each starting hand)");
+            return FAIL;
+        }
+        for (i = 0; i < NUM_STARTING_HANDS; i++){
+            w = PyFloat_AsDouble(PyList_GET_ITEM(pyrange, i));
+            if (w == -1.0 && PyErr_Occurred())
+                return FAIL;
+            if (w < 0.0){
+                PyErr_SetString(PyExc_ValueError, "range weights must not be negative");
+                return FAIL;
+            }
+            weights[i] = w;
+        }
+        return SUCCESS;
+    }
+
+    if (!PyDict_Check(pyrange)){
+        PyErr_SetString(PyExc_TypeError, "ranges must be lists or dicts");
+        return FAIL;
+    }
+    for (i = 0; i < NUM_STARTING_HANDS; i++)
+        weights[i] = 0.0;
+    while (PyDict_Next(pyrange, &pos, &key, &value)){
+        if ( !PyTuple_Check(key) ){
+            PyErr_SetString(PyExc_ValueError, "dictionary keys must be card tuples");
+            return FAIL;
+        }
+        if ( !PyArg_ParseTuple(key, "ii", &c1, &c2) )
+            return FAIL;
+        if (c1 < 0 || c2 < 0 || c1 > 51 || c2 > 51 || c1 == c2){
+            PyErr_SetString(PyExc_ValueError, "dictionary keys must be tuples of unmatching cards (0-51)");
+            return FAIL;
+        }
+        w = PyFloat_AsDouble(value);
+        if (w == -1.0 && PyErr_Occurred())
+            return FAIL;
+        if (w < 0.0){
+            PyErr_SetString(PyExc_ValueError, "range weights must not be negative");
+            return FAIL;
+        }
+        weights[GET_INDEX(c1, c2)] = w;
+    }
+    return SUCCESS;
+}
+
+
+const char range_equity_doc[] =
+"range_equity(ranges, [board], threads=1) -> list\n\n"
+"Return the exact equity of each range against the others.\n\n"
+"Every set of combos, one from each range, that shares no cards\n"
+"with the others or the board counts by the product of their\n"
+"weights over every board runnout.\n"
+"ranges -> 2 to 22 ranges, each a list of 1326 weights ordered as in\n"
+"    river_distribution or a dict of card tuples to weights\n"
+"    (missing combos weigh 0).\n"
+"board -> up to 5 cards\n"
+"threads -> number of threads to share the work, 0 for one per cpu.\n"
+"    The results are the same for any number of threads.\n"
+"Two ranges are fast on any street.  With more the work grows with\n"
+"the product of the range sizes, and is refused past a couple\n"
+"million sets of combos.\n";
+
+static PyObject *cpoker_range_equity(PyObject *self, PyObject *args, PyObject *kwargs){
+    static char *kwlist[] = {"ranges", "board", "threads", NULL};
+    PyObject *pyranges, *pyboard = NULL;
+    uint32_t board[5];
+    double (*weights)[NUM_STARTING_HANDS];
+    const double *ranges[MAX_HANDS];
+    double results[MAX_HANDS];
+    int i, nranges, nboard = 0, nthreads = 1, result;
+    STATS_START(start);
+
+    if (!PyArg_ParseTupleAndKeywords(args, kwargs, "O|Oi", kwlist, &pyranges, &pyboard, &nthreads))
+        return NULL;
+
+    if (nthreads < 0){
+        PyErr_SetString(PyExc_ValueError, "threads must not be negative");
+        return NULL;
+    }
+    if (pyboard == Py_None)
+        pyboard = NULL;
+
+    if ( !PyList_Check(pyranges) || (nranges = (int) PyList_GET_SIZE(pyranges)) < 2 ){
+        PyErr_SetString(PyExc_TypeError, "range_equity requires a list of at least 2 ranges");
+        return NULL;
+    }
+    if (nranges > MAX_HANDS){
+        PyErr_SetString(PyExc_ValueError, "too many ranges");
+        return NULL;
+    }
+
+    if ( pyboard && ( (nboard = count_cards(pyboard)) > 5 || nboard == FAIL ) ){
+        PyErr_SetString(PyExc_ValueError, "board must be a list of 0-5 cards");
+        return NULL;
+    }
+    if ( pyboard && convert_cards(pyboard, board, nboard) == FAIL )
+        return NULL;
+
+    if ( (weights = PyMem_Malloc(nranges * sizeof(weights[0]))) == NULL )
+        return PyErr_NoMemory();
+    for (i = 0; i < nranges; i++){
+        if (convert_range(PyList_GET_ITEM(pyranges, i), weights[i]) == FAIL){
+            PyMem_Free(weights);
+            return NULL;
+        }
+        ranges[i] = weights[i];
+    }
+
+    Py_BEGIN_ALLOW_THREADS
+    result = range_equity(ranges, nranges, board, nboard, results, nthreads);
+    Py_END_ALLOW_THREADS
+    PyMem_Free(weights);
+
+    if (result == FAIL){
+        PyErr_SetString(PyExc_ValueError, "duplicate board cards, ranges that can't meet "
+                        "or too many sets of combos");
+        return NULL;
+    }
+    STATS_CALL(STAT_RANGE_EQUITY, start, nranges);
+    return (PyObject *) buildListFromArray( results, nranges, 'd');
+}
+
+
+//a strength as the tuple hand_strength returns
+static PyObject *build_strength(const strength *r){
+    return Py_BuildValue("(ddddd)", r->hs, r->ehs, r->ehs2, r->ppot, r->npot);
+}
+
+
+const char hand_strength_doc[] =
+"hand_strength(hand, board, threads=1) -> (hs, ehs, ehs2, ppot, npot)\n\n"
+"Rate a hand against every other hand on a board of 3-5 cards.\n\n"
+"hs -> the share of opponents the hand beats now, ties counting half\n"
+"ehs, ehs2 -> the mean and mean square of the river hs over every runout\n"
+"ppot, npot -> the chance of getting ahead when behind and of falling\n"
+"    behind when ahead (Billings et al)\n";
+
+static PyObject *cpoker_hand_strength(PyObject *self, PyObject *args, PyObject *kwargs){
+    static char *kwlist[] = {"hand", "board", "threads", NULL};
+    PyObject *pyhand, *pyboard;
+    uint32_t hand[2], board[5];
+    int nboard, nthreads = 1, result;
+    strength r;
+    STATS_START(start);
+
+    if (!PyArg_ParseTupleAndKeywords(args, kwargs, "OO|i", kwlist, &pyhand, &pyboard, &nthreads))
+        return NULL;
+    if (nthreads < 0){
+        PyErr_SetString(PyExc_ValueError, "threads must not be negative");
+        return NULL;
+    }
+    if ( (nboard = count_cards(pyboard)) < 3 || nboard > 5 ){
+        PyErr_SetString(PyExc_ValueError, "board must be a list of 3-5 cards");
+        return NULL;
+    }
+    if (convert_cards(pyhand, hand, 2) == FAIL || convert_cards(pyboard, board, nboard) == FAIL)
+        return NULL;
+
+    Py_BEGIN_ALLOW_THREADS
+    result = hand_strengths(board, nboard, hand, &r, nthreads);
+    Py_END_ALLOW_THREADS
+    if (result == FAIL){
+        PyErr_SetString(PyExc_ValueError, "duplicate cards or out of memory");
+        return NULL;
+    }
+    STATS_CALL(STAT_HAND_STRENGTH, start, 1);
+    return build_strength(&r);
+}
+
+
+const char hand_strengths_doc[] =
+"hand_strengths(board, threads=1) -> list\n\n"
+"Return hand_strength of all 1326 hands on board, ordered as in\n"
+"river_distribution, with None for hands that use a board card.\n"
+"Each runout is ranked once for all of the hands.\n";
+
+static PyObject *cpoker_hand_strengths(PyObject *self, PyObject *args, PyObject *kwargs){
+    static char *kwlist[] = {"board", "threads", NULL};
+    PyObject *pyboard, *pylist, *item;
+    uint32_t board[5];
+    int i, nboard, nthreads = 1, result;
+    strength *results;
+    STATS_START(start);
+
+    if (!PyArg_ParseTupleAndKeywords(args, kwargs, "O|i", kwlist, &pyboard, &nthreads))
+        return NULL;
+    if (nthreads < 0){
+        PyErr_SetString(PyExc_ValueError, "threads must not be negative");
+        return NULL;
+    }
+    if ( (nboard = count_cards(pyboard)) < 3 || nboard > 5 ){
+        PyErr_SetString(PyExc_ValueError, "board must be a list of 3-5 cards");
+        return NULL;
+    }
+    if (convert_cards(pyboard, board, nboard) == FAIL)
+        return NULL;
+    if ( (results = PyMem_Malloc(NUM_STARTING_HANDS * sizeof(strength))) == NULL )
+        return PyErr_NoMemory();
+
+    Py_BEGIN_ALLOW_THREADS
+    result = hand_strengths(board, nboard, NULL, results, nthreads);
+    Py_END_ALLOW_THREADS
+    if (result == FAIL){
+        PyMem_Free(results);
+        PyErr_SetString(PyExc_ValueError, "duplicate cards or out of memory");
+        return NULL;
+    }
+    STATS_CALL(STAT_HAND_STRENGTHS, start, (52 - nboard) * (51 - nboard) / 2);
+
+    if ( (pylist = PyList_New(NUM_STARTING_HANDS)) == NULL ){
+        PyMem_Free(results);
+        return NULL;
+    }
+    for (i = 0; i < NUM_STARTING_HANDS; i++){
+        if (isnan(results[i].ehs)){
+            Py_INCREF(Py_None);
+            item = Py_None;
+        }
+        else if ( (item = build_strength(&results[i])) == NULL ){
+            Py_DECREF(pylist);
+            PyMem_Free(results);
+            return NULL;
+        }
+        PyList_SET_ITEM(pylist, i, item);
+    }
+    PyMem_Free(results);
+    return pylist;
+}
+
+const char equity_histograms_doc[] =
+"equity_histograms(board, bins=50, threads=1) -> list\n\n"
+"Return for each of the 1326 hands, ordered as in river_distribution,\n"
+"how many runouts of the board (3-5 cards) leave its river HS in each\n"
+"of bins (at most 1024) even bins from 0 to 1, or None for hands that\n"
+"use a board card.\n";
+
+static PyObject *cpoker_equity_histograms(PyObject *self, PyObject *args, PyObject *kwargs){
+    static char *kwlist[] = {"board", "bins", "threads", NULL};
+    PyObject *pyboard, *pylist, *item;
+    uint32_t board[5], *hist;
+    int i, j, nboard, nbins = 50, nthreads = 1, result;
+    long total;
+    STATS_START(start);
+
+    if (!PyArg_ParseTupleAndKeywords(args, kwargs, "O|ii", kwlist, &pyboard, &nbins, &nthreads))
+        return NULL;
+    if (nthreads < 0 || nbins <= 0 || nbins > MAX_BINS){
+        PyErr_SetString(PyExc_ValueError, "bins must be 1-1024 and threads not negative");
+        return NULL;
+    }
+    if ( (nboard = count_cards(pyboard)) < 3 || nboard > 5 ){
+        PyErr_SetString(PyExc_ValueError, "board must be a list of 3-5 cards");
+        return NULL;
+    }
+    if (convert_cards(pyboard, board, nboard) == FAIL)
+        return NULL;
+    if ( (hist = PyMem_Malloc((size_t) NUM_STARTING_HANDS * nbins * sizeof(uint32_t))) == NULL )
+        return PyErr_NoMemory();
+
+    Py_BEGIN_ALLOW_THREADS
+    result = equity_histograms(board, nboard, nbins, hist, nthreads);
+    Py_END_ALLOW_THREADS
+    if (result == FAIL){
+        PyMem_Free(hist);
+        PyErr_SetString(PyExc_ValueError, "bad or duplicate cards or out of memory");
+        return NULL;
+    }
+    STATS_CALL(STAT_EQUITY_HISTOGRAMS, start, (52 - nboard) * (51 - nboard) / 2);
+
+    if ( (pylist = PyList_New(NUM_STARTING_HANDS)) == NULL ){
+        PyMem_Free(hist);
+        return NULL;
+    }
+    for (i = 0; i < NUM_STARTING_HANDS; i++){
+        for (j = 0, total = 0; j < nbins; j++)
+            total += hist[i * nbins + j];
+        if (!total){
+            Py_INCREF(Py_None);
+            item = Py_None;
+        }
+        else if ( (item = PyList_New(nbins)) != NULL ){
+            for (j = 0; j < nbins; j++)
+                PyList_SET_ITEM(item, j, PyInt_FromLong(hist[i * nbins + j]));
+        }
+        else{
+            Py_DECREF(pylist);
+            PyMem_Free(hist);
+            return NULL;
+        }
+        PyList_SET_ITEM(pylist, i, item);
+    }
+    PyMem_Free(hist);
+    return pylist;
+}
+
+
+const char board_classes_doc[] =
+"board_classes(street) -> int\n\n"
+"Return the number of board classes of street (3, 4 or 5) cards, where\n"
+"boards that differ only by suits are in the same class.\n";
+
+static PyObject *cpoker_board_classes(PyObject *self, PyObject *args){
+    int nboard, nclasses;
+
+    if (!PyArg_ParseTuple(args, "i", &nboard))
+        return NULL;
+    Py_BEGIN_ALLOW_THREADS
+    nclasses = board_classes(nboard, NULL, NULL);
+    Py_END_ALLOW_THREADS
+    if (nclasses == FAIL){
+        PyErr_SetString(PyExc_ValueError, "street must be 3, 4 or 5 board cards");
+        return NULL;
+    }
+    return PyInt_FromLong(nclasses);
+}
+
+
+const char board_class_doc[] =
+"board_class(board) -> int\n\n"
+"Return the class of a board of 3-5 cards (see board_classes).\n";
+
+static PyObject *cpoker_board_class(PyObject *self, PyObject *args){
+    PyObject *pyboard;
+    uint32_t board[5];
+    int nboard, class;
+
+    if (!PyArg_ParseTuple(args, "O", &pyboard))
+        return NULL;
+    if ( (nboard = count_cards(pyboard)) < 3 || nboard > 5 ){
+        PyErr_SetString(PyExc_ValueError, "board must be a list of 3-5 cards");
+        return NULL;
+    }
+    if (convert_cards(pyboard, board, nboard) == FAIL)
+        return NULL;
+    Py_BEGIN_ALLOW_THREADS
+    class = board_class(board, nboard, NULL);
+    Py_END_ALLOW_THREADS
+    if (class == FAIL){
+        PyErr_SetString(PyExc_ValueError, "bad or duplicate cards");
+        return NULL;
+    }
+    return PyInt_FromLong(class);
+}
+
+
+const char iso_size_doc[] =
+"iso_size(street) -> int\n\n"
+"Return the number of hole card and board combinations of street (0, 3,\n"
+"4 or 5 board cards) up to suits, which iso_index numbers from 0.\n";
+
+static PyObject *cpoker_iso_size(PyObject *self, PyObject *args){
+    uint64_t size;
+    int nboard;
+
+    if (!PyArg_ParseTuple(args, "i", &nboard))
+        return NULL;
+    Py_BEGIN_ALLOW_THREADS
+    size = iso_size(nboard);
+    Py_END_ALLOW_THREADS
+    if (size == 0){
+        PyErr_SetString(PyExc_ValueError, "street must be 0, 3, 4 or 5 board cards");
+        return NULL;
+    }
+    return PyLong_FromUnsignedLongLong(size);
+}
+
+
+const char iso_index_doc[] =
+"iso_index(hand, board) -> int\n\n"
+"Return the index of hand and board (0 or 3-5 cards) among those of its\n"
+"street up to suits.  Hands that differ only by relabeling suits, or by\n"
+"the order of the hole cards or of the board, get the same index.\n";
+
+static PyObject *cpoker_iso_index(PyObject *self, PyObject *args){
+    PyObject *pyhand, *pyboard;
+    uint32_t cards[7];
+    uint64_t index;
+    int nboard;
+
+    if (!PyArg_ParseTuple(args, "OO", &pyhand, &pyboard))
+        return NULL;
+    if (convert_cards(pyhand, cards, 2) == FAIL)
+        return NULL;
+    if ( (nboard = count_cards(pyboard)) > 5 ){
+        PyErr_SetString(PyExc_ValueError, "board must be a list of 0 or 3-5 cards");
+        return NULL;
+    }
+    if (nboard == FAIL || convert_cards(pyboard, cards + 2, nboard) == FAIL)
+        return NULL;
+    Py_BEGIN_ALLOW_THREADS
+    index = iso_index(cards, nboard);
+    Py_END_ALLOW_THREADS
+    if (index == ISO_FAIL){
+        PyErr_SetString(PyExc_ValueError, "bad or duplicate cards, or a board of 1 or 2 cards");
+        return NULL;
+    }
+    return PyLong_FromUnsignedLongLong(index);
+}
+
+
+const char iso_unindex_doc[] =
+"iso_unindex(index, street) -> (hand, board)\n\n"
+"Return a hand and board of street (0, 3, 4 or 5 board cards) with\n"
+"index, each in card order.\n";
+
+static PyObject *cpoker_iso_unindex(PyObject *self, PyObject *args){
+    unsigned long long index;
+    uint32_t cards[7];
+    int nboard, result, i;
+    PyObject *pyindex, *pyhand, *pyboard;
+
+    if (!PyArg_ParseTuple(args, "Oi", &pyindex, &nboard) || read_uint64(pyindex, &index) == FAIL)
+        return NULL;
+    Py_BEGIN_ALLOW_THREADS
+    result = iso_unindex((uint64_t) index, nboard, cards);
+    Py_END_ALLOW_THREADS
+    if (result == FAIL){
+        PyErr_SetString(PyExc_ValueError, "street must be 0, 3, 4 or 5 board cards, "
+            "with index less than its iso_size");
+        return NULL;
+    }
+    pyhand = PyList_New(2);
+    pyboard = PyList_New(nboard);
+    if (!pyhand || !pyboard){
+        Py_XDECREF(pyhand);
+        Py_XDECREF(pyboard);
+        return NULL;
+    }
+    for (i = 0; i < 2; i++)
+        PyList_SET_ITEM(pyhand, i, PyInt_FromLong(cards[i]));
+    for (i = 0; i < nboard; i++)
+        PyList_SET_ITEM(pyboard, i, PyInt_FromLong(cards[2 + i]));
+    return Py_BuildValue("(NN)", pyhand, pyboard);
+}
+
+
+const char iso_indices_doc[] =
+"iso_indices(hands, street, [out]) -> array\n\n"
+"Return the iso_index of each of many hands.\n"
+"hands -> buffer of integer cards holding N rows of 2 hole cards\n"
+"    followed by street (0, 3, 4 or 5) board cards\n"
+"out -> optional writable uint64 buffer to hold the N results.\n"
+"    A new array.array('Q') is returned if it is not supplied.\n\n"
+"Raises ValueError if any hand holds a duplicate card.\n";
+
+static PyObject *cpoker_iso_indices(PyObject *self, PyObject *args, PyObject *kwargs){
+    static char *kwlist[] = {"hands", "street", "out", NULL};
+    PyObject *pyhands, *pyout = NULL, *out;
+    Py_buffer hands, outview;
+    Py_ssize_t n, start, chunk;
+    uint32_t cards[BATCH_CHUNK * 7];
+    int nboard, width, result;
+
+    if (!PyArg_ParseTupleAndKeywords(args, kwargs, "Oi|O", kwlist, &pyhands, &nboard, &pyout))
+        return NULL;
+    if (iso_size(nboard) == 0){
+        PyErr_SetString(PyExc_ValueError, "street must be 0, 3, 4 or 5 board cards");
+        return NULL;
+    }
+    width = 2 + nboard;
+
+    if (get_card_buffer(pyhands, &hands, width, &n) == FAIL)
+        return NULL;
+
+    if ( (out = get_output(pyout, n, &outview, 'Q')) == NULL ){
+        PyBuffer_Release(&hands);
+        return NULL;
+    }
+
+    for (start = 0; start < n; start += chunk){
+        chunk = (n - start < BATCH_CHUNK) ? n - start : BATCH_CHUNK;
+        if (read_cards(&hands, start * width, chunk * width, cards) == FAIL){
+            Py_CLEAR(out);
+            break;
+        }
+        Py_BEGIN_ALLOW_THREADS
+        result = iso_index_batch(cards, (int) chunk, nboard, (uint64_t *) outview.buf + start);
+        Py_END_ALLOW_THREADS
+        if (result == FAIL){
+            PyErr_SetString(PyExc_ValueError, "duplicate cards");
+            Py_CLEAR(out);
+            break;
+        }
+    }
+
+    PyBuffer_Release(&outview);
+    PyBuffer_Release(&hands);
+    return out;
+}
+
+
+const char save_histograms_doc[] =
+"save_histograms(path, street, bins=50, first=0, count=0, threads=0) -> int\n\n"
+"Write the equity histogram of every hand on board classes of street\n"
+"(3, 4 or 5) cards to path, and return how many classes it covers.\n"
+"Flop and turn histograms count the runouts in each of bins bins of\n"
+"river HS as equity_histograms does.  On the river the HS itself is kept.\n"
+"first, count -> the classes to cover (see board_classes), count 0 for\n"
+"    all from first, so big streets can be split over processes\n"
+"threads -> number of threads to share the classes, 0 for one per cpu.\n";
+
+static PyObject *cpoker_save_histograms(PyObject *self, PyObject *args, PyObject *kwargs){
+    static char *kwlist[] = {"path", "street", "bins", "first", "count", "threads", NULL};
+    const char *path;
+    int nboard, nbins = 50, first = 0, count = 0, nthreads = 0, nclasses, result;
+
+    if (!PyArg_ParseTupleAndKeywords(args, kwargs, "si|iiii", kwlist, &path, &nboard, &nbins,
+                                     &first, &count, &nthreads))
+        return NULL;
+    if (nboard < 3 || nboard > 5 || nbins <= 0 || nbins > MAX_BINS || first < 0 || count < 0 || nthreads < 0){
+        PyErr_SetString(PyExc_ValueError, "street must be 3-5, bins 1-1024 and the rest not negative");
+        return NULL;
+    }
+    if ( (nclasses = board_classes(nboard, NULL, NULL)) == FAIL )
+        return PyErr_NoMemory();
+    if (first > nclasses){
+        PyErr_Format(PyExc_ValueError, "first is past the %i board classes", nclasses);
+        return NULL;
+    }
+
+    Py_BEGIN_ALLOW_THREADS
+    result = save_histograms(path, nboard, nbins, first, count, nthreads);
+    Py_END_ALLOW_THREADS
+    if (result == FAIL){
+        PyErr_SetFromErrnoWithFilename(PyExc_IOError, path);
+        return NULL;
+    }
+    return PyInt_FromLong(result);
+}
+
+
+const char cluster_histograms_doc[] =
+"cluster_histograms(histograms, buckets, k, metric='emd', iterations=50,\n"
+"                   seed=None, threads=0) -> float\n\n"
+"Cluster the hands in the histogram file save_histograms wrote into k\n"
+"buckets with k-means, write the bucket table to the path buckets for\n"
+"BucketTable, and return the mean distance (squared distance for l2)\n"
+"of the hands from their bucket's center.  Each hand weighs as many\n"
+"boards as its class has.\n"
+"metric -> 'emd' (earth mover's distance) or 'l2'\n"
+"iterations -> the most rounds to run before the buckets settle\n"
+"seed -> an integer (0 to 2**64 - 1), picking the starting centers\n"
+"threads -> number of threads to share the hands, 0 for one per cpu.\n"
+"    The buckets are the same for any number of threads.\n";
+
+static PyObject *cpoker_cluster_histograms(PyObject *self, PyObject *args, PyObject *kwargs){
+    static char *kwlist[] = {"histograms", "buckets", "k", "metric", "iterations", "seed", "threads", NULL};
+    const char *hist_path, *bucket_path, *pymetric = "emd";
+    PyObject *pyseed = Py_None;
+    int k, metric, iterations = 50, nthreads = 0;
+    unsigned long long seed;
+    double result;
+
+    if (!PyArg_ParseTupleAndKeywords(args, kwargs, "ssi|siOi", kwlist, &hist_path, &bucket_path, &k,
+                                     &pymetric, &iterations, &pyseed, &nthreads))
+        return NULL;
+    if (!strcmp(pymetric, "emd"))
+        metric = METRIC_EMD;
+    else if (!strcmp(pymetric, "l2"))
+        metric = METRIC_L2;
+    else{
+        PyErr_SetString(PyExc_ValueError, "metric must be 'emd' or 'l2'");
+        return NULL;
+    }
+    if (k <= 0 || k > 65535 || iterations < 0 || nthreads < 0){
+        PyErr_SetString(PyExc_ValueError, "k must be 1-65535 and the rest not negative");
+        return NULL;
+    }
+    if (pyseed == Py_None)
+        seed = random_seed();
+    else if (read_uint64(pyseed, &seed) == FAIL)
+        return NULL;
+
+    Py_BEGIN_ALLOW_THREADS
+    result = cluster_histograms(hist_path, bucket_path, k, metric, iterations, seed, nthreads);
+    Py_END_ALLOW_THREADS
+    if (result < 0.0){
+        PyErr_SetString(PyExc_IOError, "couldn't read the histograms (missing, corrupt or "
+                        "fewer hands than k) or write the buckets");
+        return NULL;
+    }
+    return PyFloat_FromDouble(result);
+}
+
+
+//the hand_values river_distribution was last given, which calls
+//evaluating with them hold references to, so that they can run
+//without the lock while a later call replaces them
+typedef struct{
+    int refs;
+    int maxvalue;
+    dictEntry dict[NUM_STARTING_HANDS];
+}saved_values;
+
+static void release_values(saved_values *values){
+    if (values && __atomic_sub_fetch(&values->refs, 1, __ATOMIC_ACQ_REL) == 0)
+        free(values);
+}
+
+
+//river_distribution keeps the last hand_values it was given here,
+//one per module object, with a lock to swap them under
+typedef struct{
+    saved_values *values;
+    //a reference to the hand_values object values was set from
+    //to check if the same object is continuously used
+    PyObject *oldvalues;
+    PyThread_type_lock lock;
+    PyObject *grouping_type;
+    PyObject *buckets_type;
+}module_state;
+
+
+static module_state *get_state(PyObject *module){
+    #if PY_MAJOR_VERSION >= 3
+    return (module_state *) PyModule_GetState(module);
+    #else
+    static module_state state;
+    (void) module;
+    return &state;
+    #endif
 }
 
-#define MAX_PREFLOP_GROUPS 32
+
+//a hand's group from hand_values, 0-1325 since there are no more
+//groups than hands
+//Return FAIL with an exception set if value isn't one
+static int read_group(PyObject *value){
+    long group;
+    int overflow;
+
+    group = PyLong_AsLongAndOverflow(value, &overflow);
+    if (group == -1 && PyErr_Occurred())
+        return FAIL;
+    if (overflow || group < 0 || group >= NUM_STARTING_HANDS){
+        PyErr_SetString(PyExc_ValueError, "hand values must be integers from 0 to 1325");
+        return FAIL;
+    }
+    return (int) group;
+}
 
 
 //pyList is a list of values in appropriate order
@@ -378,7 +2155,8 @@ int setHandDictWithList(PyObject * pyList, dictEntry handDict[]){
         for (j = i + 1; j < 52; j++, dict++, index++){
             dict->hand[0] = i;
             dict->hand[1] = j;
-            dict->value = (int) PyInt_AsLong(PyList_GetItem(pyList, index));
+            if ( (dict->value = read_group(PyList_GetItem(pyList, index))) == FAIL )
+                return FAIL;
             if (dict->value > max)
                 max = dict->value;
         }
@@ -400,7 +2178,7 @@ int setHandDictWithList(PyObject * pyList, dictEntry handDict[]){
 
 //set handDict using values from pyDict
 //pyDict must include all two card hand combinations
-//with values <= MAX_PREFLOP_GROUPS
+//with values 0-1325
 int setHandDictWithDict(PyObject *pyDict, dictEntry handDict[]){
     PyObject *key, *value;
     Py_ssize_t pos = 0;
@@ -424,16 +2202,15 @@ int setHandDictWithDict(PyObject *pyDict, dictEntry handDict[]){
         }
         //if the pyDict is the right length and no GET_INDEX
         //is > NUM_STARTING_HANDS we will necessarily fill in handDict
-        if ( (index = GET_INDEX(c1, c2)) >= NUM_STARTING_HANDS ){
+        if ( c1 < 0 || c2 < 0 || c1 > 51 || c2 > 51 || c1 == c2 ){
             PyErr_SetString(PyExc_ValueError, "dictionary keys must be tuples of unmatching cards (0-51)");
             return FAIL;
         }
+        index = GET_INDEX(c1, c2);
         handDict[index].hand[0] = c1;
         handDict[index].hand[1] = c2;
-        if ( (handDict[index].value = (int) PyInt_AsLong(value)) == FAIL){
-            PyErr_SetString(PyExc_ValueError, "dictionary values must be integers");
+        if ( (handDict[index].value = read_group(value)) == FAIL )
             return FAIL;
-        }
         if (handDict[index].value > max)
             max = handDict[index].value;
 
@@ -456,18 +2233,316 @@ int set_dict ( PyObject *phand_values, dictEntry handDict[] )
     else{
         PyErr_SetString(PyExc_ValueError, "hand_values must be a list or dict");
     }
+    return max;
+}
 
-    if (max > MAX_PREFLOP_GROUPS){
-        PyErr_Format(PyExc_ValueError,
-            "preflop value too high.  got %i, needed <= %i",
-            max, MAX_PREFLOP_GROUPS);
-        return FAIL;
+
+//a HandGrouping holds a grouping of every preflop hand, set once and
+//never changed, so any thread can use one without locks
+typedef struct{
+    PyObject_HEAD
+    int ngroups;
+    dictEntry dict[NUM_STARTING_HANDS];
+}hand_grouping;
+
+
+const char grouping_doc[] =
+"HandGrouping(hand_values)\n\n"
+"A grouping of all 1326 preflop hands for river_distribution and ochs.\n\n"
+"hand_values -> a list or dict mapping every preflop hand to a group\n"
+"    as in river_distribution, with groups 0-1325.\n";
+
+#if PY_MAJOR_VERSION >= 3
+
+#ifndef Py_TPFLAGS_IMMUTABLETYPE
+#define Py_TPFLAGS_IMMUTABLETYPE 0
+#endif
+
+static PyObject *grouping_new(PyTypeObject *type, PyObject *args, PyObject *kwargs){
+    static char *kwlist[] = {"hand_values", NULL};
+    PyObject *phand_values;
+    hand_grouping *self;
+    int max;
+
+    if (!PyArg_ParseTupleAndKeywords(args, kwargs, "O", kwlist, &phand_values))
+        return NULL;
+    if ( (self = (hand_grouping *) type->tp_alloc(type, 0)) == NULL )
+        return NULL;
+    if ( (max = set_dict(phand_values, self->dict)) == FAIL ){
+        Py_DECREF(self);
+        return NULL;
     }
-    return max;
+    self->ngroups = max + 1;
+    return (PyObject *) self;
+}
+
+
+static void grouping_dealloc(PyObject *self){
+    PyTypeObject *type = Py_TYPE(self);
+
+    type->tp_free(self);
+    Py_DECREF(type);
+}
+
+
+static PyObject *grouping_ngroups(PyObject *self, void *closure){
+    (void) closure;
+    return PyLong_FromLong(((hand_grouping *) self)->ngroups);
+}
+
+
+//run ochs for the hands in pyhands (a list of hands, or one hand if
+//many is false) and build its results
+static PyObject *grouping_ochs_list(hand_grouping *self, PyObject *pyhands, PyObject *pyboard,
+                                    int nthreads, bool many){
+    PyObject *pylist = NULL, *row;
+    uint32_t (*hands)[2] = NULL, hand[2], board[5];
+    int h, nhands = 1, nboard, result;
+    double *results = NULL;
+
+    if (nthreads < 0){
+        PyErr_SetString(PyExc_ValueError, "threads must not be negative");
+        return NULL;
+    }
+    if ( (nboard = count_cards(pyboard)) < 3 || nboard > 5 ){
+        PyErr_SetString(PyExc_ValueError, "board must be a list of 3-5 cards");
+        return NULL;
+    }
+    if (convert_cards(pyboard, board, nboard) == FAIL)
+        return NULL;
+
+    if (many){
+        if ( !PyList_Check(pyhands) ){
+            PyErr_SetString(PyExc_TypeError, "ochs_many requires a list of hands");
+            return NULL;
+        }
+        nhands = (int) PyList_GET_SIZE(pyhands);
+    }
+    hands = PyMem_Malloc((nhands ? nhands : 1) * sizeof(hands[0]));
+    results = PyMem_Malloc(((size_t) nhands * self->ngroups + 1) * sizeof(double));
+    if (!hands || !results){
+        PyErr_NoMemory();
+        goto done;
+    }
+    for (h = 0; h < nhands; h++){
+        if (convert_cards(many ? PyList_GET_ITEM(pyhands, h) : pyhands, hand, 2) == FAIL)
+            goto done;
+        if (hand[0] > 51 || hand[1] > 51 || hand[0] == hand[1]){
+            PyErr_SetString(PyExc_ValueError, "hands must be 2 unmatching cards (0-51)");
+            goto done;
+        }
+        hands[h][0] = hand[0];
+        hands[h][1] = hand[1];
+    }
+    for (h = 0; !many && h < nboard; h++){
+        if (board[h] == hand[0] || board[h] == hand[1]){
+            PyErr_SetString(PyExc_ValueError, "duplicate cards");
+            goto done;
+        }
+    }
+
+    Py_BEGIN_ALLOW_THREADS
+    result = ochs(hands, nhands, board, nboard, self->dict, self->ngroups, results, nthreads);
+    Py_END_ALLOW_THREADS
+    if (result == FAIL){
+        PyErr_SetString(PyExc_ValueError, "bad or duplicate board cards or out of memory");
+        goto done;
+    }
+
+    if (!many){
+        pylist = buildListFromArray(results, self->ngroups, 'd');
+        goto done;
+    }
+    if ( (pylist = PyList_New(nhands)) == NULL )
+        goto done;
+    for (h = 0; h < nhands; h++){
+        if ( (row = buildListFromArray(results + (size_t) h * self->ngroups, self->ngroups, 'd')) == NULL ){
+            Py_CLEAR(pylist);
+            goto done;
+        }
+        PyList_SET_ITEM(pylist, h, row);
+    }
+
+  done:
+    PyMem_Free(hands);
+    PyMem_Free(results);
+    return pylist;
+}
+
+
+const char grouping_ochs_doc[] =
+"ochs(hand, board, threads=1) -> list\n\n"
+"Return hand's equity against each group on a board of 3-5 cards,\n"
+"over every runout (the opponent cluster hand strength).\n"
+"A group with no hands left to play against gets nan.\n"
+"threads -> number of threads to share the runouts, 0 for one per cpu.\n";
+
+static PyObject *grouping_ochs(PyObject *self, PyObject *args, PyObject *kwargs){
+    static char *kwlist[] = {"hand", "board", "threads", NULL};
+    PyObject *pyhand, *pyboard;
+    int nthreads = 1;
+
+    if (!PyArg_ParseTupleAndKeywords(args, kwargs, "OO|i", kwlist, &pyhand, &pyboard, &nthreads))
+        return NULL;
+    return grouping_ochs_list((hand_grouping *) self, pyhand, pyboard, nthreads, false);
+}
+
+
+const char grouping_ochs_many_doc[] =
+"ochs_many(hands, board, threads=1) -> list\n\n"
+"Return ochs of each hand, ranking each runout once for all of them.\n"
+"Hands that use a board card get nan for every group.\n";
+
+static PyObject *grouping_ochs_many(PyObject *self, PyObject *args, PyObject *kwargs){
+    static char *kwlist[] = {"hands", "board", "threads", NULL};
+    PyObject *pyhands, *pyboard;
+    int nthreads = 1;
+
+    if (!PyArg_ParseTupleAndKeywords(args, kwargs, "OO|i", kwlist, &pyhands, &pyboard, &nthreads))
+        return NULL;
+    return grouping_ochs_list((hand_grouping *) self, pyhands, pyboard, nthreads, true);
+}
+
+
+static PyMethodDef groupingMethods[] = {
+    { "ochs", (PyCFunction) grouping_ochs, METH_VARARGS | METH_KEYWORDS, grouping_ochs_doc },
+    { "ochs_many", (PyCFunction) grouping_ochs_many, METH_VARARGS | METH_KEYWORDS, grouping_ochs_many_doc },
+    { NULL, NULL }
+};
+
+static PyGetSetDef groupingGetSet[] = {
+    { "ngroups", grouping_ngroups, NULL, "the number of groups", NULL },
+    { NULL }
+};
+
+static PyType_Slot groupingSlots[] = {
+    {Py_tp_new, grouping_new},
+    {Py_tp_dealloc, grouping_dealloc},
+    {Py_tp_methods, groupingMethods},
+    {Py_tp_getset, groupingGetSet},
+    {Py_tp_doc, (void *) grouping_doc},
+    {0, NULL}
+};
+
+static PyType_Spec groupingSpec = {
+    "cpoker.HandGrouping",
+    sizeof(hand_grouping),
+    0,
+    Py_TPFLAGS_DEFAULT | Py_TPFLAGS_IMMUTABLETYPE,
+    groupingSlots
+};
+
+
+//a BucketTable maps a bucket table read-only, so any thread can look
+//buckets up in one without locks
+typedef struct{
+    PyObject_HEAD
+    bucket_table table;
+}py_buckets;
+
+
+const char buckets_doc[] =
+"BucketTable(path)\n\n"
+"The bucket table cluster_histograms wrote to path, mapped read-only.\n";
+
+static PyObject *buckets_new(PyTypeObject *type, PyObject *args, PyObject *kwargs){
+    static char *kwlist[] = {"path", NULL};
+    const char *path;
+    py_buckets *self;
+    int result;
+
+    if (!PyArg_ParseTupleAndKeywords(args, kwargs, "s", kwlist, &path))
+        return NULL;
+    if ( (self = (py_buckets *) type->tp_alloc(type, 0)) == NULL )
+        return NULL;
+    Py_BEGIN_ALLOW_THREADS
+    result = load_buckets(path, &self->table);
+    Py_END_ALLOW_THREADS
+    if (result == FAIL){
+        Py_DECREF(self);
+        PyErr_SetString(PyExc_IOError, "missing or corrupt bucket table");
+        return NULL;
+    }
+    return (PyObject *) self;
+}
+
+
+static void buckets_dealloc(PyObject *self){
+    PyTypeObject *type = Py_TYPE(self);
+
+    free_buckets(&((py_buckets *) self)->table);
+    type->tp_free(self);
+    Py_DECREF(type);
+}
+
+
+const char buckets_lookup_doc[] =
+"lookup(hand, board) -> int\n\n"
+"Return the bucket of hand on board, which has the table's street of cards.\n";
+
+static PyObject *buckets_lookup(PyObject *self, PyObject *args){
+    const bucket_table *table = &((py_buckets *) self)->table;
+    PyObject *pyhand, *pyboard;
+    uint32_t hand[2], board[5];
+    int bucket;
+
+    if (!PyArg_ParseTuple(args, "OO", &pyhand, &pyboard))
+        return NULL;
+    if (convert_cards(pyhand, hand, 2) == FAIL || convert_cards(pyboard, board, table->nboard) == FAIL)
+        return NULL;
+    if ( (bucket = bucket_lookup(table, hand, board)) == FAIL ){
+        PyErr_SetString(PyExc_ValueError, "bad or duplicate cards, or a board the table doesn't cover");
+        return NULL;
+    }
+    return PyInt_FromLong(bucket);
 }
 
+
+static PyObject *buckets_nbuckets(PyObject *self, void *closure){
+    (void) closure;
+    return PyLong_FromLong(((py_buckets *) self)->table.nbuckets);
+}
+
+
+static PyObject *buckets_street(PyObject *self, void *closure){
+    (void) closure;
+    return PyLong_FromLong(((py_buckets *) self)->table.nboard);
+}
+
+
+static PyMethodDef bucketsMethods[] = {
+    { "lookup", buckets_lookup, METH_VARARGS, buckets_lookup_doc },
+    { NULL, NULL }
+};
+
+static PyGetSetDef bucketsGetSet[] = {
+    { "nbuckets", buckets_nbuckets, NULL, "the number of buckets", NULL },
+    { "street", buckets_street, NULL, "the number of board cards", NULL },
+    { NULL }
+};
+
+static PyType_Slot bucketsSlots[] = {
+    {Py_tp_new, buckets_new},
+    {Py_tp_dealloc, buckets_dealloc},
+    {Py_tp_methods, bucketsMethods},
+    {Py_tp_getset, bucketsGetSet},
+    {Py_tp_doc, (void *) buckets_doc},
+    {0, NULL}
+};
+
+static PyType_Spec bucketsSpec = {
+    "cpoker.BucketTable",
+    sizeof(py_buckets),
+    0,
+    Py_TPFLAGS_DEFAULT | Py_TPFLAGS_IMMUTABLETYPE,
+    bucketsSlots
+};
+
+#endif
+
+
 const char river_distribution_doc[] =
-"river_distribution(hand, board, [hand_values]) -> list\n\n"
+"river_distribution(hand, board, [hand_values], out=None) -> list\n\n"
 "Return a histogram showing how your hand does against\n"
 "different groups of preflop hands.\n\n"
 "The preflop groups are set by hand_values, which is saved\n"
@@ -475,66 +2550,388 @@ const char river_distribution_doc[] =
 "change it.\n\n"
 "The histogram bars give you 2 points for each win and 1 point\n"
 "for each tie for all hands in that group\n"
-"hand, board -> lists of cards, 2 and 5\n"
-"hand_values -> either a dictionary or list mapping all preflop\n"
-"    hands to a hand group (such as the Sklansky hand ranks)\n"
+"hand, board -> sequences or buffers of cards, 2 and 5\n"
+"hand_values -> a HandGrouping, or either a dictionary or list\n"
+"    mapping all preflop hands to a hand group (such as the\n"
+"    Sklansky hand ranks)\n"
 "    Dictionary keys must be tuples of cards with the smallest\n"
 "    of the two cards first.\n"
 "    List items must be the values sorted by keys.\n"
 "    (ie list[0] is the numberic value you've assigned to the\n"
 "    hand represented by (0, 1) (aka AcAd).\n"
-"    Values must be contiguous integers starting from 0.\n";
+"    Values must be contiguous integers starting from 0.\n"
+"    A HandGrouping is used as is and not saved.\n"
+"out -> optional writable int32 buffer with room for every group,\n"
+"    which gets the histogram and is returned in place of a list.\n";
 
-static PyObject * cpoker_river_distribution(PyObject *self, PyObject *args){
+static PyObject * cpoker_river_distribution(PyObject *self, PyObject *args, PyObject *kwargs){
+    static char *kwlist[] = {"hand", "board", "hand_values", "out", NULL};
 
-    static dictEntry handDict[NUM_STARTING_HANDS];
-    static int maxDictValue = FAIL;
-    //save a reference to the phand_values object
-    //to check if the same object is continuously used
-    static PyObject *oldvalues = NULL;
+    module_state *state = get_state(self);
 
+    PyObject *pyhand, *pyboard, *pychart;
+    PyObject *phand_values = NULL, *pyout = Py_None;
+    Py_buffer outview;
+    saved_values *values;
+    hand_grouping *grouping = NULL;
+    uint32_t hand[2], board[5];
+    int *chart, maxvalue, result = SUCCESS;
+    STATS_START(start);
 
-    PyObject *pyhand, *pyboard;
-    PyObject *phand_values = NULL;
-    uint32_t hand[2], board[5], i;
-    int chart[MAX_PREFLOP_GROUPS];
+    if (!PyArg_ParseTupleAndKeywords(args, kwargs, "OO|OO", kwlist, &pyhand, &pyboard,
+                                     &phand_values, &pyout))
+        return NULL;
+    if (phand_values == Py_None)
+        phand_values = NULL;
+
+    if (convert_cards(pyhand, hand, 2) == FAIL){
+        return NULL;
+    }
 
-    if (!PyArg_ParseTuple(args, "OO|O", &pyhand, &pyboard, &phand_values))
+    if (convert_cards(pyboard, board, 5) == FAIL){
         return NULL;
+    }
+
+    if ( state->grouping_type && phand_values &&
+         PyObject_TypeCheck(phand_values, (PyTypeObject *) state->grouping_type) ){
+        grouping = (hand_grouping *) phand_values;
+        maxvalue = grouping->ngroups - 1;
+        if ( (chart = PyMem_Malloc((maxvalue + 1) * sizeof(int))) == NULL )
+            return PyErr_NoMemory();
+        memset(chart, 0, (maxvalue + 1) * sizeof(int));
+        Py_BEGIN_ALLOW_THREADS
+        result = river_distribution(hand, board, chart, grouping->dict);
+        Py_END_ALLOW_THREADS
+        goto build;
+    }
+
+    Py_BEGIN_ALLOW_THREADS
+    PyThread_acquire_lock(state->lock, WAIT_LOCK);
+    Py_END_ALLOW_THREADS
 
-    //make sure not to waste time resetting handDict if the same
+    //make sure not to waste time resetting the values if the same
     //phand_values is used multiple times
-    if ( phand_values && (phand_values != oldvalues) ){
-        if ( (maxDictValue = set_dict(phand_values, handDict)) == FAIL ){
+    if ( phand_values && (phand_values != state->oldvalues) ){
+        if ( (values = (saved_values *) calloc(1, sizeof(saved_values))) == NULL ){
+            PyThread_release_lock(state->lock);
+            return PyErr_NoMemory();
+        }
+        if ( (values->maxvalue = set_dict(phand_values, values->dict)) == FAIL ){
+            free(values);
+            Py_CLEAR(state->oldvalues);
+            release_values(state->values);
+            state->values = NULL;
+            PyThread_release_lock(state->lock);
             return NULL;
         }
-        Py_XDECREF(oldvalues);
+        values->refs = 1;
+        release_values(state->values);
+        state->values = values;
+        Py_XDECREF(state->oldvalues);
         Py_INCREF(phand_values);
-        oldvalues = phand_values;
+        state->oldvalues = phand_values;
     }
 
-    if (maxDictValue == FAIL){
+    if ( (values = state->values) == NULL ){
+        PyThread_release_lock(state->lock);
         PyErr_SetString(PyExc_ValueError, "no proper hand_values are set");
         return NULL;
     }
+    __atomic_add_fetch(&values->refs, 1, __ATOMIC_RELAXED);
+    PyThread_release_lock(state->lock);
 
-    if (convert_cards(pyhand, hand, 2) == FAIL){
+    maxvalue = values->maxvalue;
+    if ( (chart = PyMem_Malloc((maxvalue + 1) * sizeof(int))) == NULL ){
+        release_values(values);
+        return PyErr_NoMemory();
+    }
+    memset(chart, 0, (maxvalue + 1) * sizeof(int));
+
+    Py_BEGIN_ALLOW_THREADS
+    result = river_distribution(hand, board, chart, values->dict);
+    Py_END_ALLOW_THREADS
+    release_values(values);
+
+  build:
+    if (result == FAIL){
+        PyMem_Free(chart);
+        PyErr_SetString(PyExc_ValueError, "duplicate cards");
         return NULL;
     }
+    STATS_CALL(STAT_RIVER_DISTRIBUTION, start, 1);
 
-    if (convert_cards(pyboard, board, 5) == FAIL){
+    if (pyout == Py_None)
+        pychart = (PyObject *) buildListFromArray( chart, maxvalue + 1, 'i');
+    else if ( (pychart = get_output(pyout, maxvalue + 1, &outview, 'i')) != NULL ){
+        memcpy(outview.buf, chart, (maxvalue + 1) * sizeof(int));
+        PyBuffer_Release(&outview);
+    }
+    PyMem_Free(chart);
+    return pychart;
+}
+
+
+const char save_tables_doc[] =
+"save_tables(path)\n\n"
+"Write the rank and flush lookup tables to path.\n"
+"The file is versioned and checksummed.  Setting the environment\n"
+"variable POKYR_TABLE_FILE to its path makes later imports map it\n"
+"rather than rebuilding the tables (and writes it if it is missing\n"
+"or stale).\n";
+
+static PyObject * cpoker_save_tables(PyObject *self, PyObject *args){
+    const char *path;
+
+    if (!PyArg_ParseTuple(args, "s", &path))
+        return NULL;
+
+    if (save_tables(path) == FAIL){
+        PyErr_SetFromErrnoWithFilename(PyExc_IOError, path);
+        return NULL;
+    }
+    Py_RETURN_NONE;
+}
+
+
+const char load_tables_doc[] =
+"load_tables(path, [prefault], [hugepages]) -> bool\n\n"
+"Map the lookup tables saved by save_tables and use them in\n"
+"place of the current ones.  Return False, leaving the current\n"
+"tables alone, if the file is missing, stale or corrupt.  Other\n"
+"threads may be using the current tables, so they are never\n"
+"overwritten: a file holding different tables is refused too.\n"
+"Only the first file loaded is mapped, since its mapping can't be\n"
+"released while other threads may read it.  Later files are checked\n"
+"the same way but the tables stay where they are.\n\n"
+"prefault -> fault the whole table in now rather than on first use\n"
+"hugepages -> copy the table into memory backed by huge pages\n";
+
+static PyObject * cpoker_load_tables(PyObject *self, PyObject *args){
+    const char *path;
+    int prefault = 0, hugepages = 0;
+
+    if (!PyArg_ParseTuple(args, "s|ii", &path, &prefault, &hugepages))
         return NULL;
+
+    if (load_tables(path, (prefault ? TABLE_PREFAULT : 0) |
+                          (hugepages ? TABLE_HUGEPAGES : 0)) == FAIL){
+        Py_RETURN_FALSE;
     }
+    Py_RETURN_TRUE;
+}
 
-    for ( i = 0; i <= maxDictValue; i++)
-        chart[i] = 0;
 
-    if ( river_distribution(hand, board, chart, handDict) == FAIL ){
-        PyErr_SetString(PyExc_ValueError, "duplicate cards");
+const char save_preflop_table_doc[] =
+"save_preflop_table(path, threads=0, matchups=None)\n\n"
+"Enumerate every heads-up preflop matchup and write the results to\n"
+"path, one per class of matchups that are the same up to suits.\n"
+"This takes minutes, spread over threads (0 for one per cpu).\n"
+"load_preflop_table(path) or the environment variable\n"
+"POKYR_PREFLOP_FILE then make heads-up preflop enumerations lookups.\n"
+"matchups -> a list of (hand1, hand2) pairs to enumerate only the\n"
+"    classes of.  The others are left out of the table, and lookups\n"
+"    of them enumerate as if there were no table.\n";
+
+static PyObject * cpoker_save_preflop_table(PyObject *self, PyObject *args, PyObject *kwargs){
+    static char *kwlist[] = {"path", "threads", "matchups", NULL};
+    const char *path;
+    PyObject *pymatchups = Py_None, *seq = NULL, *pair, *hand;
+    uint32_t *matchups = NULL;
+    bool dead[52];
+    int i, j, nmatchups = 0, nthreads = 0, result;
+
+    if (!PyArg_ParseTupleAndKeywords(args, kwargs, "s|iO", kwlist, &path, &nthreads, &pymatchups))
+        return NULL;
+
+    if (nthreads < 0){
+        PyErr_SetString(PyExc_ValueError, "threads must not be negative");
+        return NULL;
+    }
+    if (pymatchups != Py_None){
+        if ( (seq = PySequence_Fast(pymatchups, "matchups must be a list of (hand1, hand2) pairs")) == NULL )
+            return NULL;
+        nmatchups = (int) PySequence_Fast_GET_SIZE(seq);
+        if ( (matchups = (uint32_t *) PyMem_Malloc((nmatchups + 1) * 4 * sizeof(uint32_t))) == NULL ){
+            Py_DECREF(seq);
+            return PyErr_NoMemory();
+        }
+        for (i = 0; i < nmatchups; i++){
+            pair = PySequence_Fast_GET_ITEM(seq, i);
+            if ( !PySequence_Check(pair) || PySequence_Size(pair) != 2 ){
+                PyErr_SetString(PyExc_TypeError, "matchups must be a list of (hand1, hand2) pairs");
+                goto failed;
+            }
+            for (j = 0; j < 2; j++){
+                hand = PySequence_GetItem(pair, j);
+                result = hand ? convert_cards(hand, matchups + 4 * i + 2 * j, 2) : FAIL;
+                Py_XDECREF(hand);
+                if (result == FAIL)
+                    goto failed;
+            }
+            if ( set_dead(matchups + 4 * i, 4, NULL, 0, dead) == FAIL ){
+                PyErr_SetString(PyExc_ValueError, "duplicate cards");
+                goto failed;
+            }
+        }
+        Py_DECREF(seq);
+    }
+
+    errno = 0;
+    Py_BEGIN_ALLOW_THREADS
+    result = save_preflop_table(path, (pymatchups == Py_None) ? NULL : matchups, nmatchups, nthreads);
+    Py_END_ALLOW_THREADS
+    PyMem_Free(matchups);
+    if (result == FAIL){
+        if (errno)
+            PyErr_SetFromErrnoWithFilename(PyExc_IOError, path);
+        else
+            PyErr_NoMemory();
         return NULL;
     }
+    Py_RETURN_NONE;
 
-    return (PyObject *) buildListFromArray( chart, maxDictValue + 1, 'i');
+  failed:
+    Py_DECREF(seq);
+    PyMem_Free(matchups);
+    return NULL;
+}
+
+
+const char load_preflop_table_doc[] =
+"load_preflop_table(path) -> bool\n\n"
+"Load the table saved by save_preflop_table.  Heads-up preflop\n"
+"full_enumerations and preflop_equity read from it from then on.\n"
+"Return False, leaving the current table alone, if the file is\n"
+"missing, stale or corrupt.\n";
+
+static PyObject * cpoker_load_preflop_table(PyObject *self, PyObject *args){
+    const char *path;
+    int result;
+
+    if (!PyArg_ParseTuple(args, "s", &path))
+        return NULL;
+
+    Py_BEGIN_ALLOW_THREADS
+    result = load_preflop_table(path);
+    Py_END_ALLOW_THREADS
+    if (result == FAIL){
+        Py_RETURN_FALSE;
+    }
+    Py_RETURN_TRUE;
+}
+
+
+const char preflop_equity_doc[] =
+"preflop_equity(hand1, hand2) -> float\n\n"
+"Return the ev of hand1 against hand2 with no board, the same as\n"
+"full_enumeration([hand1, hand2])[0], from the loaded preflop table.\n"
+"Raise ValueError if no table is loaded.\n";
+
+static PyObject * cpoker_preflop_equity(PyObject *self, PyObject *args){
+    PyObject *pyhand1, *pyhand2;
+    uint32_t h1[2], h2[2];
+    uint64_t counts[3];
+    STATS_START(start);
+
+    if (!PyArg_ParseTuple(args, "OO", &pyhand1, &pyhand2))
+        return NULL;
+
+    if (convert_cards(pyhand1, h1, 2) == FAIL || convert_cards(pyhand2, h2, 2) == FAIL)
+        return NULL;
+
+    if (preflop_lookup(h1, h2, counts) == FAIL){
+        PyErr_SetString(PyExc_ValueError, "no preflop table is loaded, or duplicate cards");
+        return NULL;
+    }
+    STATS_CALL(STAT_PREFLOP_EQUITY, start, 2);
+    return PyFloat_FromDouble((counts[0] + 0.5 * (double) counts[2]) / (counts[0] + counts[1] + counts[2]));
+}
+
+
+const char stats_doc[] =
+"stats() -> dict or None\n\n"
+"Return what the module has done since the last reset_stats, over\n"
+"every thread: calls, hands_given and latency, dicts by entry point of\n"
+"call counts, hands passed in and histograms of call times (entry i counts\n"
+"the calls taking 2**i to 2**(i+1) ns), and ranked, flushes and\n"
+"flush_ratio, the hands ranked and how many of them were flushes.\n"
+"Return None unless cpoker was built with POKYR_STATS=1.\n\n"
+"Every function that evaluates hands has an entry, counting only the\n"
+"calls that succeed; the table, isomorphism and abstraction functions\n"
+"are not counted.  hands_given counts the hands each call was given,\n"
+"not the work done on them: an enumeration of 3 hands adds 3 however\n"
+"many runouts it deals, range_equity adds its ranges and hand_strengths\n"
+"and equity_histograms, given only a board, every hand the board leaves.\n"
+"The hands actually evaluated are in ranked.\n"
+"ranked and flushes come from the hold'em rank tables only, not from\n"
+"handvalue or the omaha, low, best5 and short deck evaluators.\n";
+
+static PyObject * cpoker_stats(PyObject *self, PyObject *unused){
+#ifdef COLLECT_STATS
+    stats *s;
+    PyObject *calls, *given, *latency, *item, *result = NULL;
+    int i, j;
+
+    if ( (s = (stats *) PyMem_Malloc(sizeof(stats))) == NULL )
+        return PyErr_NoMemory();
+    read_stats(s);
+
+    calls = PyDict_New();
+    given = PyDict_New();
+    latency = PyDict_New();
+    if (calls == NULL || given == NULL || latency == NULL)
+        goto done;
+    for (i = 0; i < NUM_STATS; i++){
+        if ( (item = PyLong_FromUnsignedLongLong(s->calls[i])) == NULL ||
+             PyDict_SetItemString(calls, Stat_Names[i], item) == -1 )
+            goto item_failed;
+        Py_DECREF(item);
+        if ( (item = PyLong_FromUnsignedLongLong(s->hands_given[i])) == NULL ||
+             PyDict_SetItemString(given, Stat_Names[i], item) == -1 )
+            goto item_failed;
+        Py_DECREF(item);
+        if ( (item = PyList_New(LATENCY_BUCKETS)) == NULL )
+            goto done;
+        for (j = 0; j < LATENCY_BUCKETS; j++){
+            PyObject *count = PyLong_FromUnsignedLongLong(s->latency[i][j]);
+            if (count == NULL)
+                goto item_failed;
+            PyList_SET_ITEM(item, j, count);
+        }
+        if (PyDict_SetItemString(latency, Stat_Names[i], item) == -1)
+            goto item_failed;
+        Py_DECREF(item);
+    }
+    result = Py_BuildValue("{sOsOsOsKsKsd}", "calls", calls, "hands_given", given,
+                           "latency", latency, "ranked", (unsigned long long) s->ranked,
+                           "flushes", (unsigned long long) s->flushes,
+                           "flush_ratio", s->ranked ? (double) s->flushes / s->ranked : 0.0);
+    goto done;
+
+  item_failed:
+    Py_XDECREF(item);
+  done:
+    Py_XDECREF(calls);
+    Py_XDECREF(given);
+    Py_XDECREF(latency);
+    PyMem_Free(s);
+    return result;
+#else
+    Py_RETURN_NONE;
+#endif
+}
+
+
+const char reset_stats_doc[] =
+"reset_stats()\n\n"
+"Start the counts stats returns over from zero.  Does nothing unless\n"
+"cpoker was built with POKYR_STATS=1.\n";
+
+static PyObject * cpoker_reset_stats(PyObject *self, PyObject *unused){
+#ifdef COLLECT_STATS
+    reset_stats();
+#endif
+    Py_RETURN_NONE;
 }
 
 
@@ -550,31 +2947,172 @@ void printdeck(void){
     }
 
 
+//older pythons call the fast call functions through call_fast
+FAST_WRAPPER(cpoker_handvalue)
+FAST_WRAPPER(cpoker_best5_rank)
+FAST_WRAPPER(cpoker_low_rank)
+FAST_WRAPPER(cpoker_holdem2p)
+FAST_WRAPPER(cpoker_multi_holdem)
+FAST_WRAPPER(cpoker_rivervalue)
+FAST_WRAPPER(cpoker_riverties)
+FAST_WRAPPER(cpoker_omaha_rank)
+FAST_WRAPPER(cpoker_short_rank)
+
 static PyMethodDef cpokerMethods[] = {
-    { "handvalue", cpoker_handvalue, METH_VARARGS, handvalue_doc },
-    { "holdem2p", cpoker_holdem2p, METH_VARARGS, holdem2p_doc },
-    { "multi_holdem", cpoker_multi_holdem, METH_VARARGS, multi_holdem_doc},
-    { "rivervalue", cpoker_rivervalue, METH_VARARGS, rivervalue_doc },
-    { "riverties", cpoker_riverties, METH_VARARGS, riverties_doc },
-    { "full_enumeration", cpoker_full_enumeration, METH_VARARGS, full_enumeration_doc },
-    { "monte_carlo", cpoker_monte_carlo, METH_VARARGS, monte_carlo_doc },
-    { "river_distribution", cpoker_river_distribution, METH_VARARGS, river_distribution_doc },
+    FAST_METHOD("handvalue", cpoker_handvalue, handvalue_doc),
+    { "handranks", (PyCFunction) cpoker_handranks, METH_VARARGS | METH_KEYWORDS, handranks_doc },
+    { "holdem_handranks", (PyCFunction) cpoker_holdem_handranks, METH_VARARGS | METH_KEYWORDS, holdem_handranks_doc },
+    FAST_METHOD("best5_rank", cpoker_best5_rank, best5_rank_doc),
+    { "best5_ranks", (PyCFunction) cpoker_best5_ranks, METH_VARARGS | METH_KEYWORDS, best5_ranks_doc },
+    FAST_METHOD("low_rank", cpoker_low_rank, low_rank_doc),
+    { "low_ranks", (PyCFunction) cpoker_low_ranks, METH_VARARGS | METH_KEYWORDS, low_ranks_doc },
+    FAST_METHOD("holdem2p", cpoker_holdem2p, holdem2p_doc),
+    FAST_METHOD("multi_holdem", cpoker_multi_holdem, multi_holdem_doc),
+    FAST_METHOD("rivervalue", cpoker_rivervalue, rivervalue_doc),
+    FAST_METHOD("riverties", cpoker_riverties, riverties_doc),
+    { "full_enumeration", (PyCFunction) cpoker_full_enumeration, METH_VARARGS | METH_KEYWORDS, full_enumeration_doc },
+    { "headsup_counts", (PyCFunction) cpoker_headsup_counts, METH_VARARGS | METH_KEYWORDS, headsup_counts_doc },
+    { "monte_carlo", (PyCFunction) cpoker_monte_carlo, METH_VARARGS | METH_KEYWORDS, monte_carlo_doc },
+    FAST_METHOD("omaha_rank", cpoker_omaha_rank, omaha_rank_doc),
+    { "multi_omaha", cpoker_multi_omaha, METH_VARARGS, multi_omaha_doc },
+    { "omaha_enumeration", (PyCFunction) cpoker_omaha_enumeration, METH_VARARGS | METH_KEYWORDS, omaha_enumeration_doc },
+    { "omaha_monte_carlo", (PyCFunction) cpoker_omaha_monte_carlo, METH_VARARGS | METH_KEYWORDS, omaha_monte_carlo_doc },
+    { "omaha_low", cpoker_omaha_low, METH_VARARGS, omaha_low_doc },
+    { "multi_omaha_hilo", cpoker_multi_omaha_hilo, METH_VARARGS, multi_omaha_hilo_doc },
+    { "omaha_hilo_enumeration", (PyCFunction) cpoker_omaha_hilo_enumeration, METH_VARARGS | METH_KEYWORDS, omaha_hilo_enumeration_doc },
+    FAST_METHOD("short_rank", cpoker_short_rank, short_rank_doc),
+    { "short_rivervalue", cpoker_short_rivervalue, METH_VARARGS, short_rivervalue_doc },
+    { "short_enumeration", (PyCFunction) cpoker_short_enumeration, METH_VARARGS | METH_KEYWORDS, short_enumeration_doc },
+    { "short_monte_carlo", (PyCFunction) cpoker_short_monte_carlo, METH_VARARGS | METH_KEYWORDS, short_monte_carlo_doc },
+    { "range_equity", (PyCFunction) cpoker_range_equity, METH_VARARGS | METH_KEYWORDS, range_equity_doc },
+    { "hand_strength", (PyCFunction) cpoker_hand_strength, METH_VARARGS | METH_KEYWORDS, hand_strength_doc },
+    { "hand_strengths", (PyCFunction) cpoker_hand_strengths, METH_VARARGS | METH_KEYWORDS, hand_strengths_doc },
+    { "equity_histograms", (PyCFunction) cpoker_equity_histograms, METH_VARARGS | METH_KEYWORDS, equity_histograms_doc },
+    { "board_classes", cpoker_board_classes, METH_VARARGS, board_classes_doc },
+    { "board_class", cpoker_board_class, METH_VARARGS, board_class_doc },
+    { "iso_size", cpoker_iso_size, METH_VARARGS, iso_size_doc },
+    { "iso_index", cpoker_iso_index, METH_VARARGS, iso_index_doc },
+    { "iso_unindex", cpoker_iso_unindex, METH_VARARGS, iso_unindex_doc },
+    { "iso_indices", (PyCFunction) cpoker_iso_indices, METH_VARARGS | METH_KEYWORDS, iso_indices_doc },
+    { "save_histograms", (PyCFunction) cpoker_save_histograms, METH_VARARGS | METH_KEYWORDS, save_histograms_doc },
+    { "cluster_histograms", (PyCFunction) cpoker_cluster_histograms, METH_VARARGS | METH_KEYWORDS, cluster_histograms_doc },
+    { "river_distribution", (PyCFunction) cpoker_river_distribution, METH_VARARGS | METH_KEYWORDS, river_distribution_doc },
+    { "save_tables", cpoker_save_tables, METH_VARARGS, save_tables_doc },
+    { "load_tables", cpoker_load_tables, METH_VARARGS, load_tables_doc },
+    { "save_preflop_table", (PyCFunction) cpoker_save_preflop_table, METH_VARARGS | METH_KEYWORDS, save_preflop_table_doc },
+    { "load_preflop_table", cpoker_load_preflop_table, METH_VARARGS, load_preflop_table_doc },
+    { "preflop_equity", cpoker_preflop_equity, METH_VARARGS, preflop_equity_doc },
+    { "stats", cpoker_stats, METH_NOARGS, stats_doc },
+    { "reset_stats", cpoker_reset_stats, METH_NOARGS, reset_stats_doc },
     { NULL, NULL }
 };
 
 
+//the tables are shared by every module object and interpreter in the
+//process and built by whichever imports first
+static pthread_once_t Tables_Once = PTHREAD_ONCE_INIT;
+static bool Tables_Built;
+
+static void init_once(void){
+    Tables_Built = init_tables();
+    init_rank_keys();
+}
+
+static int build_tables(void){
+    pthread_once(&Tables_Once, init_once);
+    if (!Tables_Built){
+        PyErr_SetString(PyExc_MemoryError, "could not build the lookup tables");
+        return FAIL;
+    }
+    return SUCCESS;
+}
+
+
+static int init_state(module_state *state){
+    state->values = NULL;
+    state->oldvalues = NULL;
+    state->grouping_type = NULL;
+    state->buckets_type = NULL;
+    if ( (state->lock = PyThread_allocate_lock()) == NULL ){
+        PyErr_NoMemory();
+        return FAIL;
+    }
+    return SUCCESS;
+}
+
+
 #if PY_MAJOR_VERSION >= 3
 
+static int cpoker_exec(PyObject *m){
+    module_state *state = get_state(m);
+
+    if (build_tables() == FAIL || init_state(state) == FAIL)
+        return -1;
+    if ( (state->grouping_type = PyType_FromSpec(&groupingSpec)) == NULL )
+        return -1;
+    Py_INCREF(state->grouping_type);
+    if (PyModule_AddObject(m, "HandGrouping", state->grouping_type) < 0){
+        Py_DECREF(state->grouping_type);
+        return -1;
+    }
+    if ( (state->buckets_type = PyType_FromSpec(&bucketsSpec)) == NULL )
+        return -1;
+    Py_INCREF(state->buckets_type);
+    if (PyModule_AddObject(m, "BucketTable", state->buckets_type) < 0){
+        Py_DECREF(state->buckets_type);
+        return -1;
+    }
+    return 0;
+}
+
+static int cpoker_traverse(PyObject *m, visitproc visit, void *arg){
+    module_state *state = get_state(m);
+    Py_VISIT(state->oldvalues);
+    Py_VISIT(state->grouping_type);
+    Py_VISIT(state->buckets_type);
+    return 0;
+}
+
+static int cpoker_clear(PyObject *m){
+    module_state *state = get_state(m);
+    Py_CLEAR(state->oldvalues);
+    Py_CLEAR(state->grouping_type);
+    Py_CLEAR(state->buckets_type);
+    return 0;
+}
+
+static void cpoker_free(void *m){
+    module_state *state = get_state((PyObject *) m);
+    cpoker_clear((PyObject *) m);
+    release_values(state->values);
+    state->values = NULL;
+    if (state->lock){
+        PyThread_free_lock(state->lock);
+        state->lock = NULL;
+    }
+}
+
+static PyModuleDef_Slot cpokerSlots[] = {
+    {Py_mod_exec, cpoker_exec},
+    #if PY_VERSION_HEX >= 0x030c0000
+    {Py_mod_multiple_interpreters, Py_MOD_PER_INTERPRETER_GIL_SUPPORTED},
+    #endif
+    #if PY_VERSION_HEX >= 0x030d0000
+    {Py_mod_gil, Py_MOD_GIL_NOT_USED},
+    #endif
+    {0, NULL}
+};
+
 static struct PyModuleDef cpokermodule = {
     PyModuleDef_HEAD_INIT,
     "cpoker",     /* m_name */
     "This does poker stuff",  /* m_doc */
-    -1,                  /* m_size */
+    sizeof(module_state),     /* m_size */
     cpokerMethods,    /* m_methods */
-    NULL,                /* m_reload */
-    NULL,                /* m_traverse */
-    NULL,                /* m_clear */
-    NULL,                /* m_free */
+    cpokerSlots,         /* m_slots */
+    cpoker_traverse,     /* m_traverse */
+    cpoker_clear,        /* m_clear */
+    cpoker_free,         /* m_free */
 };
 
 #endif
@@ -587,22 +3125,13 @@ PyInit_cpoker (void)
 initcpoker (void)
 #endif
 {
-    extern uint16_t Rank_Table[7825760];
-    extern uint16_t Flush_Table[8129];
-    extern uint16_t Straight_Table[8129];
-    populate_tables(Rank_Table, Flush_Table, Straight_Table);
-
     #if PY_MAJOR_VERSION >= 3
 
-    PyObject *m;
-
-    m = PyModule_Create(&cpokermodule);
-    if (m == NULL)
-        return NULL;
-
-    return m;
+    return PyModuleDef_Init(&cpokermodule);
 
     #else
+    if (build_tables() == FAIL || init_state(get_state(NULL)) == FAIL)
+        return;
     (void) Py_InitModule("cpoker", cpokerMethods);
     #endif
 }
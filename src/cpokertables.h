@@ -0,0 +1,7 @@
+#define FLUSH_TABLE {0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,3,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,47,0,0,0,0,0,0,0,55,0,0,0,59,0,61,4,4,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,79,0,0,0,0,0,0,0,87,0,0,0,91,0,93,94,3,0,0,0,0,0,0,0,103,0,0,0,107,0,109,110,110,0,0,0,115,0,117,118,118,0,121,122,122,5,5,5,5,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,143,0,0,0,0,0,0,0,151,0,0,0,155,0,157,158,3,0,0,0,0,0,0,0,167,0,0,0,171,0,173,174,174,0,0,0,179,0,181,182,182,0,185,186,186,188,188,4,4,0,0,0,0,0,0,0,199,0,0,0,203,0,205,206,206,0,0,0,211,0,213,214,214,0,217,218,218,220,220,220,3,0,0,0,227,0,229,230,230,0,233,234,234,236,236,236,236,0,241,242,242,244,244,244,244,6,6,6,6,6,6,6,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,271,0,0,0,0,0,0,0,279,0,0,0,283,0,285,286,3,0,0,0,0,0,0,0,295,0,0,0,299,0,301,302,302,0,0,0,307,0,309,310,310,0,313,314,314,316,316,4,4,0,0,0,0,0,0,0,327,0,0,0,331,0,333,334,334,0,0,0,339,0,341,342,342,0,345,346,346,348,348,348,3,0,0,0,355,0,357,358,358,0,361,362,362,364,364,364,364,0,369,370,370,372,372,372,372,376,376,376,376,5,5,5,0,0,0,0,0,0,0,0,391,0,0,0,395,0,397,398,398,0,0,0,403,0,405,406,406,0,409,410,410,412,412,412,3,0,0,0,419,0,421,422,422,0,425,426,426,428,428,428,428,0,433,434,434,436,436,436,436,440,440,440,440,440,440,4,0,0,0,0,451,0,453,454,454,0,457,458,458,460,460,460,460,0,465,466,466,468,468,468,468,472,472,472,472,472,472,472,0,0,481,482,482,484,484,484,484,488,488,488,488,488,488,488,0,7,7,7,7,7,7,7,0,7,7,7,0,7,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,527,0,0,0,0,0,0,0,535,0,0,0,539,0,541,542,3,0,0,0,0,0,0,0,551,0,0,0,555,0,557,558,558,0,0,0,563,0,565,566,566,0,569,570,570,572,572,4,4,0,0,0,0,0,0,0,583,0,0,0,587,0,589,590,590,0,0,0,595,0,597,598,598,0,601,602,602,604,604,604,3,0,0,0,611,0,613,614,614,0,617,618,618,620,620,620,620,0,625,626,626,628,628,628,628,632,632,632,632,5,5,5,0,0,0,0,0,0,0,0,647,0,0,0,651,0,653,654,654,0,0,0,659,0,661,662,662,0,665,666,666,668,668,668,3,0,0,0,675,0,677,678,678,0,681,682,682,684,684,684,684,0,689,690,690,692,692,692,692,696,696,696,696,696,696,4,0,0,0,0,707,0,709,710,710,0,713,714,714,716,716,716,716,0,721,722,722,724,724,724,724,728,728,728,728,728,728,728,0,0,737,738,738,740,740,740,740,744,744,744,744,744,744,744,0,752,752,752,752,752,752,752,0,6,6,6,0,6,0,0,0,0,0,0,0,0,0,0,775,0,0,0,779,0,781,782,782,0,0,0,787,0,789,790,790,0,793,794,794,796,796,796,3,0,0,0,803,0,805,806,806,0,809,810,810,812,812,812,812,0,817,818,818,820,820,820,820,824,824,824,824,824,824,4,0,0,0,0,835,0,837,838,838,0,841,842,842,844,844,844,844,0,849,850,850,852,852,852,852,856,856,856,856,856,856,856,0,0,865,866,866,868,868,868,868,872,872,872,872,872,872,872,0,880,880,880,880,880,880,880,0,880,880,880,0,5,0,0,0,0,0,0,899,0,901,902,902,0,905,906,906,908,908,908,908,0,913,914,914,916,916,916,916,920,920,920,920,920,920,920,0,0,929,930,930,932,932,932,932,936,936,936,936,936,936,936,0,944,944,944,944,944,944,944,0,944,944,944,0,944,0,0,0,0,961,962,962,964,964,964,964,968,968,968,968,968,968,968,0,976,976,976,976,976,976,976,0,976,976,976,0,976,0,0,0,8,8,8,8,8,8,8,0,8,8,8,0,8,0,0,0,8,8,8,0,8,0,0,0,8,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,1039,0,0,0,0,0,0,0,1047,0,0,0,1051,0,1053,1054,3,0,0,0,0,0,0,0,1063,0,0,0,1067,0,1069,1070,1070,0,0,0,1075,0,1077,1078,1078,0,1081,1082,1082,1084,1084,4,4,0,0,0,0,0,0,0,1095,0,0,0,1099,0,1101,1102,1102,0,0,0,1107,0,1109,1110,1110,0,1113,1114,1114,1116,1116,1116,3,0,0,0,1123,0,1125,1126,1126,0,1129,1130,1130,1132,1132,1132,1132,0,1137,1138,1138,1140,1140,1140,1140,1144,1144,1144,1144,5,5,5,0,0,0,0,0,0,0,0,1159,0,0,0,1163,0,1165,1166,1166,0,0,0,1171,0,1173,1174,1174,0,1177,1178,1178,1180,1180,1180,3,0,0,0,1187,0,1189,1190,1190,0,1193,1194,1194,1196,1196,1196,1196,0,1201,1202,1202,1204,1204,1204,1204,1208,1208,1208,1208,1208,1208,4,0,0,0,0,1219,0,1221,1222,1222,0,1225,1226,1226,1228,1228,1228,1228,0,1233,1234,1234,1236,1236,1236,1236,1240,1240,1240,1240,1240,1240,1240,0,0,1249,1250,1250,1252,1252,1252,1252,1256,1256,1256,1256,1256,1256,1256,0,1264,1264,1264,1264,1264,1264,1264,0,6,6,6,0,6,0,0,0,0,0,0,0,0,0,0,1287,0,0,0,1291,0,1293,1294,1294,0,0,0,1299,0,1301,1302,1302,0,1305,1306,1306,1308,1308,1308,3,0,0,0,1315,0,1317,1318,1318,0,1321,1322,1322,1324,1324,1324,1324,0,1329,1330,1330,1332,1332,1332,1332,1336,1336,1336,1336,1336,1336,4,0,0,0,0,1347,0,1349,1350,1350,0,1353,1354,1354,1356,1356,1356,1356,0,1361,1362,1362,1364,1364,1364,1364,1368,1368,1368,1368,1368,1368,1368,0,0,1377,1378,1378,1380,1380,1380,1380,1384,1384,1384,1384,1384,1384,1384,0,1392,1392,1392,1392,1392,1392,1392,0,1392,1392,1392,0,5,0,0,0,0,0,0,1411,0,1413,1414,1414,0,1417,1418,1418,1420,1420,1420,1420,0,1425,1426,1426,1428,1428,1428,1428,1432,1432,1432,1432,1432,1432,1432,0,0,1441,1442,1442,1444,1444,1444,1444,1448,1448,1448,1448,1448,1448,1448,0,1456,1456,1456,1456,1456,1456,1456,0,1456,1456,1456,0,1456,0,0,0,0,1473,1474,1474,1476,1476,1476,1476,1480,1480,1480,1480,1480,1480,1480,0,1488,1488,1488,1488,1488,1488,1488,0,1488,1488,1488,0,1488,0,0,0,1504,1504,1504,1504,1504,1504,1504,0,1504,1504,1504,0,1504,0,0,0,7,7,7,0,7,0,0,0,7,0,0,0,0,0,0,0,0,0,0,0,0,0,0,1543,0,0,0,1547,0,1549,1550,1550,0,0,0,1555,0,1557,1558,1558,0,1561,1562,1562,1564,1564,1564,3,0,0,0,1571,0,1573,1574,1574,0,1577,1578,1578,1580,1580,1580,1580,0,1585,1586,1586,1588,1588,1588,1588,1592,1592,1592,1592,1592,1592,4,0,0,0,0,1603,0,1605,1606,1606,0,1609,1610,1610,1612,1612,1612,1612,0,1617,1618,1618,1620,1620,1620,1620,1624,1624,1624,1624,1624,1624,1624,0,0,1633,1634,1634,1636,1636,1636,1636,1640,1640,1640,1640,1640,1640,1640,0,1648,1648,1648,1648,1648,1648,1648,0,1648,1648,1648,0,5,0,0,0,0,0,0,1667,0,1669,1670,1670,0,1673,1674,1674,1676,1676,1676,1676,0,1681,1682,1682,1684,1684,1684,1684,1688,1688,1688,1688,1688,1688,1688,0,0,1697,1698,1698,1700,1700,1700,1700,1704,1704,1704,1704,1704,1704,1704,0,1712,1712,1712,1712,1712,1712,1712,0,1712,1712,1712,0,1712,0,0,0,0,1729,1730,1730,1732,1732,1732,1732,1736,1736,1736,1736,1736,1736,1736,0,1744,1744,1744,1744,1744,1744,1744,0,1744,1744,1744,0,1744,0,0,0,1760,1760,1760,1760,1760,1760,1760,0,1760,1760,1760,0,1760,0,0,0,1760,1760,1760,0,1760,0,0,0,6,0,0,0,0,0,0,0,0,0,0,1795,0,1797,1798,1798,0,1801,1802,1802,1804,1804,1804,1804,0,1809,1810,1810,1812,1812,1812,1812,1816,1816,1816,1816,1816,1816,1816,0,0,1825,1826,1826,1828,1828,1828,1828,1832,1832,1832,1832,1832,1832,1832,0,1840,1840,1840,1840,1840,1840,1840,0,1840,1840,1840,0,1840,0,0,0,0,1857,1858,1858,1860,1860,1860,1860,1864,1864,1864,1864,1864,1864,1864,0,1872,1872,1872,1872,1872,1872,1872,0,1872,1872,1872,0,1872,0,0,0,1888,1888,1888,1888,1888,1888,1888,0,1888,1888,1888,0,1888,0,0,0,1888,1888,1888,0,1888,0,0,0,1888,0,0,0,0,0,0,0,0,1921,1922,1922,1924,1924,1924,1924,1928,1928,1928,1928,1928,1928,1928,0,1936,1936,1936,1936,1936,1936,1936,0,1936,1936,1936,0,1936,0,0,0,1952,1952,1952,1952,1952,1952,1952,0,1952,1952,1952,0,1952,0,0,0,1952,1952,1952,0,1952,0,0,0,1952,0,0,0,0,0,0,0,9,9,9,9,9,9,9,0,9,9,9,0,9,0,0,0,9,9,9,0,9,0,0,0,9,0,0,0,0,0,0,0,9,9,9,0,9,0,0,0,9,0,0,0,0,0,0,0,9,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,2063,0,0,0,0,0,0,0,2071,0,0,0,2075,0,2077,2078,3,0,0,0,0,0,0,0,2087,0,0,0,2091,0,2093,2094,2094,0,0,0,2099,0,2101,2102,2102,0,2105,2106,2106,2108,2108,4,4,0,0,0,0,0,0,0,2119,0,0,0,2123,0,2125,2126,2126,0,0,0,2131,0,2133,2134,2134,0,2137,2138,2138,2140,2140,2140,3,0,0,0,2147,0,2149,2150,2150,0,2153,2154,2154,2156,2156,2156,2156,0,2161,2162,2162,2164,2164,2164,2164,2168,2168,2168,2168,5,5,5,0,0,0,0,0,0,0,0,2183,0,0,0,2187,0,2189,2190,2190,0,0,0,2195,0,2197,2198,2198,0,2201,2202,2202,2204,2204,2204,3,0,0,0,2211,0,2213,2214,2214,0,2217,2218,2218,2220,2220,2220,2220,0,2225,2226,2226,2228,2228,2228,2228,2232,2232,2232,2232,2232,2232,4,0,0,0,0,2243,0,2245,2246,2246,0,2249,2250,2250,2252,2252,2252,2252,0,2257,2258,2258,2260,2260,2260,2260,2264,2264,2264,2264,2264,2264,2264,0,0,2273,2274,2274,2276,2276,2276,2276,2280,2280,2280,2280,2280,2280,2280,0,2288,2288,2288,2288,2288,2288,2288,0,6,6,6,0,6,0,0,0,0,0,0,0,0,0,0,2311,0,0,0,2315,0,2317,2318,2318,0,0,0,2323,0,2325,2326,2326,0,2329,2330,2330,2332,2332,2332,3,0,0,0,2339,0,2341,2342,2342,0,2345,2346,2346,2348,2348,2348,2348,0,2353,2354,2354,2356,2356,2356,2356,2360,2360,2360,2360,2360,2360,4,0,0,0,0,2371,0,2373,2374,2374,0,2377,2378,2378,2380,2380,2380,2380,0,2385,2386,2386,2388,2388,2388,2388,2392,2392,2392,2392,2392,2392,2392,0,0,2401,2402,2402,2404,2404,2404,2404,2408,2408,2408,2408,2408,2408,2408,0,2416,2416,2416,2416,2416,2416,2416,0,2416,2416,2416,0,5,0,0,0,0,0,0,2435,0,2437,2438,2438,0,2441,2442,2442,2444,2444,2444,2444,0,2449,2450,2450,2452,2452,2452,2452,2456,2456,2456,2456,2456,2456,2456,0,0,2465,2466,2466,2468,2468,2468,2468,2472,2472,2472,2472,2472,2472,2472,0,2480,2480,2480,2480,2480,2480,2480,0,2480,2480,2480,0,2480,0,0,0,0,2497,2498,2498,2500,2500,2500,2500,2504,2504,2504,2504,2504,2504,2504,0,2512,2512,2512,2512,2512,2512,2512,0,2512,2512,2512,0,2512,0,0,0,2528,2528,2528,2528,2528,2528,2528,0,2528,2528,2528,0,2528,0,0,0,7,7,7,0,7,0,0,0,7,0,0,0,0,0,0,0,0,0,0,0,0,0,0,2567,0,0,0,2571,0,2573,2574,2574,0,0,0,2579,0,2581,2582,2582,0,2585,2586,2586,2588,2588,2588,3,0,0,0,2595,0,2597,2598,2598,0,2601,2602,2602,2604,2604,2604,2604,0,2609,2610,2610,2612,2612,2612,2612,2616,2616,2616,2616,2616,2616,4,0,0,0,0,2627,0,2629,2630,2630,0,2633,2634,2634,2636,2636,2636,2636,0,2641,2642,2642,2644,2644,2644,2644,2648,2648,2648,2648,2648,2648,2648,0,0,2657,2658,2658,2660,2660,2660,2660,2664,2664,2664,2664,2664,2664,2664,0,2672,2672,2672,2672,2672,2672,2672,0,2672,2672,2672,0,5,0,0,0,0,0,0,2691,0,2693,2694,2694,0,2697,2698,2698,2700,2700,2700,2700,0,2705,2706,2706,2708,2708,2708,2708,2712,2712,2712,2712,2712,2712,2712,0,0,2721,2722,2722,2724,2724,2724,2724,2728,2728,2728,2728,2728,2728,2728,0,2736,2736,2736,2736,2736,2736,2736,0,2736,2736,2736,0,2736,0,0,0,0,2753,2754,2754,2756,2756,2756,2756,2760,2760,2760,2760,2760,2760,2760,0,2768,2768,2768,2768,2768,2768,2768,0,2768,2768,2768,0,2768,0,0,0,2784,2784,2784,2784,2784,2784,2784,0,2784,2784,2784,0,2784,0,0,0,2784,2784,2784,0,2784,0,0,0,6,0,0,0,0,0,0,0,0,0,0,2819,0,2821,2822,2822,0,2825,2826,2826,2828,2828,2828,2828,0,2833,2834,2834,2836,2836,2836,2836,2840,2840,2840,2840,2840,2840,2840,0,0,2849,2850,2850,2852,2852,2852,2852,2856,2856,2856,2856,2856,2856,2856,0,2864,2864,2864,2864,2864,2864,2864,0,2864,2864,2864,0,2864,0,0,0,0,2881,2882,2882,2884,2884,2884,2884,2888,2888,2888,2888,2888,2888,2888,0,2896,2896,2896,2896,2896,2896,2896,0,2896,2896,2896,0,2896,0,0,0,2912,2912,2912,2912,2912,2912,2912,0,2912,2912,2912,0,2912,0,0,0,2912,2912,2912,0,2912,0,0,0,2912,0,0,0,0,0,0,0,0,2945,2946,2946,2948,2948,2948,2948,2952,2952,2952,2952,2952,2952,2952,0,2960,2960,2960,2960,2960,2960,2960,0,2960,2960,2960,0,2960,0,0,0,2976,2976,2976,2976,2976,2976,2976,0,2976,2976,2976,0,2976,0,0,0,2976,2976,2976,0,2976,0,0,0,2976,0,0,0,0,0,0,0,3008,3008,3008,3008,3008,3008,3008,0,3008,3008,3008,0,3008,0,0,0,3008,3008,3008,0,3008,0,0,0,3008,0,0,0,0,0,0,0,8,8,8,0,8,0,0,0,8,0,0,0,0,0,0,0,8,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,3079,0,0,0,3083,0,3085,3086,3086,0,0,0,3091,0,3093,3094,3094,0,3097,3098,3098,3100,3100,3100,3,0,0,0,3107,0,3109,3110,3110,0,3113,3114,3114,3116,3116,3116,3116,0,3121,3122,3122,3124,3124,3124,3124,3128,3128,3128,3128,3128,3128,4,0,0,0,0,3139,0,3141,3142,3142,0,3145,3146,3146,3148,3148,3148,3148,0,3153,3154,3154,3156,3156,3156,3156,3160,3160,3160,3160,3160,3160,3160,0,0,3169,3170,3170,3172,3172,3172,3172,3176,3176,3176,3176,3176,3176,3176,0,3184,3184,3184,3184,3184,3184,3184,0,3184,3184,3184,0,5,0,0,0,0,0,0,3203,0,3205,3206,3206,0,3209,3210,3210,3212,3212,3212,3212,0,3217,3218,3218,3220,3220,3220,3220,3224,3224,3224,3224,3224,3224,3224,0,0,3233,3234,3234,3236,3236,3236,3236,3240,3240,3240,3240,3240,3240,3240,0,3248,3248,3248,3248,3248,3248,3248,0,3248,3248,3248,0,3248,0,0,0,0,3265,3266,3266,3268,3268,3268,3268,3272,3272,3272,3272,3272,3272,3272,0,3280,3280,3280,3280,3280,3280,3280,0,3280,3280,3280,0,3280,0,0,0,3296,3296,3296,3296,3296,3296,3296,0,3296,3296,3296,0,3296,0,0,0,3296,3296,3296,0,3296,0,0,0,6,0,0,0,0,0,0,0,0,0,0,3331,0,3333,3334,3334,0,3337,3338,3338,3340,3340,3340,3340,0,3345,3346,3346,3348,3348,3348,3348,3352,3352,3352,3352,3352,3352,3352,0,0,3361,3362,3362,3364,3364,3364,3364,3368,3368,3368,3368,3368,3368,3368,0,3376,3376,3376,3376,3376,3376,3376,0,3376,3376,3376,0,3376,0,0,0,0,3393,3394,3394,3396,3396,3396,3396,3400,3400,3400,3400,3400,3400,3400,0,3408,3408,3408,3408,3408,3408,3408,0,3408,3408,3408,0,3408,0,0,0,3424,3424,3424,3424,3424,3424,3424,0,3424,3424,3424,0,3424,0,0,0,3424,3424,3424,0,3424,0,0,0,3424,0,0,0,0,0,0,0,0,3457,3458,3458,3460,3460,3460,3460,3464,3464,3464,3464,3464,3464,3464,0,3472,3472,3472,3472,3472,3472,3472,0,3472,3472,3472,0,3472,0,0,0,3488,3488,3488,3488,3488,3488,3488,0,3488,3488,3488,0,3488,0,0,0,3488,3488,3488,0,3488,0,0,0,3488,0,0,0,0,0,0,0,3520,3520,3520,3520,3520,3520,3520,0,3520,3520,3520,0,3520,0,0,0,3520,3520,3520,0,3520,0,0,0,3520,0,0,0,0,0,0,0,3520,3520,3520,0,3520,0,0,0,3520,0,0,0,0,0,0,0,7,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,3587,0,3589,3590,3590,0,3593,3594,3594,3596,3596,3596,3596,0,3601,3602,3602,3604,3604,3604,3604,3608,3608,3608,3608,3608,3608,3608,0,0,3617,3618,3618,3620,3620,3620,3620,3624,3624,3624,3624,3624,3624,3624,0,3632,3632,3632,3632,3632,3632,3632,0,3632,3632,3632,0,3632,0,0,0,0,3649,3650,3650,3652,3652,3652,3652,3656,3656,3656,3656,3656,3656,3656,0,3664,3664,3664,3664,3664,3664,3664,0,3664,3664,3664,0,3664,0,0,0,3680,3680,3680,3680,3680,3680,3680,0,3680,3680,3680,0,3680,0,0,0,3680,3680,3680,0,3680,0,0,0,3680,0,0,0,0,0,0,0,0,3713,3714,3714,3716,3716,3716,3716,3720,3720,3720,3720,3720,3720,3720,0,3728,3728,3728,3728,3728,3728,3728,0,3728,3728,3728,0,3728,0,0,0,3744,3744,3744,3744,3744,3744,3744,0,3744,3744,3744,0,3744,0,0,0,3744,3744,3744,0,3744,0,0,0,3744,0,0,0,0,0,0,0,3776,3776,3776,3776,3776,3776,3776,0,3776,3776,3776,0,3776,0,0,0,3776,3776,3776,0,3776,0,0,0,3776,0,0,0,0,0,0,0,3776,3776,3776,0,3776,0,0,0,3776,0,0,0,0,0,0,0,3776,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,3841,3842,3842,3844,3844,3844,3844,3848,3848,3848,3848,3848,3848,3848,0,3856,3856,3856,3856,3856,3856,3856,0,3856,3856,3856,0,3856,0,0,0,3872,3872,3872,3872,3872,3872,3872,0,3872,3872,3872,0,3872,0,0,0,3872,3872,3872,0,3872,0,0,0,3872,0,0,0,0,0,0,0,3904,3904,3904,3904,3904,3904,3904,0,3904,3904,3904,0,3904,0,0,0,3904,3904,3904,0,3904,0,0,0,3904,0,0,0,0,0,0,0,3904,3904,3904,0,3904,0,0,0,3904,0,0,0,0,0,0,0,3904,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,10,10,10,10,10,10,10,0,10,10,10,0,10,0,0,0,10,10,10,0,10,0,0,0,10,0,0,0,0,0,0,0,10,10,10,0,10,0,0,0,10,0,0,0,0,0,0,0,10,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,10,10,10,0,10,0,0,0,10,0,0,0,0,0,0,0,10,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,10,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,2,0,0,0,0,0,0,0,4119,0,0,0,4123,0,4125,4126,3,0,0,0,0,0,0,0,4135,0,0,0,4139,0,4141,4142,2,0,0,0,4147,0,4149,4150,4150,0,4153,4154,4154,4156,4156,4,4,0,0,0,0,0,0,0,4167,0,0,0,4171,0,4173,4174,2,0,0,0,4179,0,4181,4182,4182,0,4185,4186,4186,4188,4188,4188,3,0,0,0,4195,0,4197,4198,4198,0,4201,4202,4202,4204,4204,4204,2,0,4209,4210,4210,4212,4212,4212,4212,4216,4216,4216,4216,5,5,5,0,0,0,0,0,0,0,0,4231,0,0,0,4235,0,4237,4238,2,0,0,0,4243,0,4245,4246,4246,0,4249,4250,4250,4252,4252,4252,3,0,0,0,4259,0,4261,4262,4262,0,4265,4266,4266,4268,4268,4268,2,0,4273,4274,4274,4276,4276,4276,4276,4280,4280,4280,4280,4280,4280,4,0,0,0,0,4291,0,4293,4294,4294,0,4297,4298,4298,4300,4300,4300,2,0,4305,4306,4306,4308,4308,4308,4308,4312,4312,4312,4312,4312,4312,4312,0,0,4321,4322,4322,4324,4324,4324,4324,4328,4328,4328,4328,4328,4328,4328,0,4336,4336,4336,4336,4336,4336,4336,0,6,6,6,0,6,0,0,0,0,0,0,0,0,0,0,4359,0,0,0,4363,0,4365,4366,2,0,0,0,4371,0,4373,4374,4374,0,4377,4378,4378,4380,4380,4380,3,0,0,0,4387,0,4389,4390,4390,0,4393,4394,4394,4396,4396,4396,2,0,4401,4402,4402,4404,4404,4404,4404,4408,4408,4408,4408,4408,4408,4,0,0,0,0,4419,0,4421,4422,4422,0,4425,4426,4426,4428,4428,4428,2,0,4433,4434,4434,4436,4436,4436,4436,4440,4440,4440,4440,4440,4440,4440,0,0,4449,4450,4450,4452,4452,4452,4452,4456,4456,4456,4456,4456,4456,4456,0,4464,4464,4464,4464,4464,4464,4464,0,4464,4464,4464,0,5,0,0,0,0,0,0,4483,0,4485,4486,4486,0,4489,4490,4490,4492,4492,4492,2,0,4497,4498,4498,4500,4500,4500,4500,4504,4504,4504,4504,4504,4504,4504,0,0,4513,4514,4514,4516,4516,4516,4516,4520,4520,4520,4520,4520,4520,4520,0,4528,4528,4528,4528,4528,4528,4528,0,4528,4528,4528,0,4528,0,0,0,0,4545,4546,4546,4548,4548,4548,4548,4552,4552,4552,4552,4552,4552,4552,0,4560,4560,4560,4560,4560,4560,4560,0,4560,4560,4560,0,4560,0,0,0,4576,4576,4576,4576,4576,4576,4576,0,4576,4576,4576,0,4576,0,0,0,7,7,7,0,7,0,0,0,7,0,0,0,0,0,0,0,0,0,0,0,0,0,0,4615,0,0,0,4619,0,4621,4622,2,0,0,0,4627,0,4629,4630,4630,0,4633,4634,4634,4636,4636,4636,3,0,0,0,4643,0,4645,4646,4646,0,4649,4650,4650,4652,4652,4652,2,0,4657,4658,4658,4660,4660,4660,4660,4664,4664,4664,4664,4664,4664,4,0,0,0,0,4675,0,4677,4678,4678,0,4681,4682,4682,4684,4684,4684,2,0,4689,4690,4690,4692,4692,4692,4692,4696,4696,4696,4696,4696,4696,4696,0,0,4705,4706,4706,4708,4708,4708,4708,4712,4712,4712,4712,4712,4712,4712,0,4720,4720,4720,4720,4720,4720,4720,0,4720,4720,4720,0,5,0,0,0,0,0,0,4739,0,4741,4742,4742,0,4745,4746,4746,4748,4748,4748,2,0,4753,4754,4754,4756,4756,4756,4756,4760,4760,4760,4760,4760,4760,4760,0,0,4769,4770,4770,4772,4772,4772,4772,4776,4776,4776,4776,4776,4776,4776,0,4784,4784,4784,4784,4784,4784,4784,0,4784,4784,4784,0,4784,0,0,0,0,4801,4802,4802,4804,4804,4804,4804,4808,4808,4808,4808,4808,4808,4808,0,4816,4816,4816,4816,4816,4816,4816,0,4816,4816,4816,0,4816,0,0,0,4832,4832,4832,4832,4832,4832,4832,0,4832,4832,4832,0,4832,0,0,0,4832,4832,4832,0,4832,0,0,0,6,0,0,0,0,0,0,0,0,0,0,4867,0,4869,4870,4870,0,4873,4874,4874,4876,4876,4876,2,0,4881,4882,4882,4884,4884,4884,4884,4888,4888,4888,4888,4888,4888,4888,0,0,4897,4898,4898,4900,4900,4900,4900,4904,4904,4904,4904,4904,4904,4904,0,4912,4912,4912,4912,4912,4912,4912,0,4912,4912,4912,0,4912,0,0,0,0,4929,4930,4930,4932,4932,4932,4932,4936,4936,4936,4936,4936,4936,4936,0,4944,4944,4944,4944,4944,4944,4944,0,4944,4944,4944,0,4944,0,0,0,4960,4960,4960,4960,4960,4960,4960,0,4960,4960,4960,0,4960,0,0,0,4960,4960,4960,0,4960,0,0,0,4960,0,0,0,0,0,0,0,0,4993,4994,4994,4996,4996,4996,4996,5000,5000,5000,5000,5000,5000,5000,0,5008,5008,5008,5008,5008,5008,5008,0,5008,5008,5008,0,5008,0,0,0,5024,5024,5024,5024,5024,5024,5024,0,5024,5024,5024,0,5024,0,0,0,5024,5024,5024,0,5024,0,0,0,5024,0,0,0,0,0,0,0,5056,5056,5056,5056,5056,5056,5056,0,5056,5056,5056,0,5056,0,0,0,5056,5056,5056,0,5056,0,0,0,5056,0,0,0,0,0,0,0,8,8,8,0,8,0,0,0,8,0,0,0,0,0,0,0,8,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,5127,0,0,0,5131,0,5133,5134,2,0,0,0,5139,0,5141,5142,5142,0,5145,5146,5146,5148,5148,5148,3,0,0,0,5155,0,5157,5158,5158,0,5161,5162,5162,5164,5164,5164,2,0,5169,5170,5170,5172,5172,5172,5172,5176,5176,5176,5176,5176,5176,4,0,0,0,0,5187,0,5189,5190,5190,0,5193,5194,5194,5196,5196,5196,2,0,5201,5202,5202,5204,5204,5204,5204,5208,5208,5208,5208,5208,5208,5208,0,0,5217,5218,5218,5220,5220,5220,5220,5224,5224,5224,5224,5224,5224,5224,0,5232,5232,5232,5232,5232,5232,5232,0,5232,5232,5232,0,5,0,0,0,0,0,0,5251,0,5253,5254,5254,0,5257,5258,5258,5260,5260,5260,2,0,5265,5266,5266,5268,5268,5268,5268,5272,5272,5272,5272,5272,5272,5272,0,0,5281,5282,5282,5284,5284,5284,5284,5288,5288,5288,5288,5288,5288,5288,0,5296,5296,5296,5296,5296,5296,5296,0,5296,5296,5296,0,5296,0,0,0,0,5313,5314,5314,5316,5316,5316,5316,5320,5320,5320,5320,5320,5320,5320,0,5328,5328,5328,5328,5328,5328,5328,0,5328,5328,5328,0,5328,0,0,0,5344,5344,5344,5344,5344,5344,5344,0,5344,5344,5344,0,5344,0,0,0,5344,5344,5344,0,5344,0,0,0,6,0,0,0,0,0,0,0,0,0,0,5379,0,5381,5382,5382,0,5385,5386,5386,5388,5388,5388,2,0,5393,5394,5394,5396,5396,5396,5396,5400,5400,5400,5400,5400,5400,5400,0,0,5409,5410,5410,5412,5412,5412,5412,5416,5416,5416,5416,5416,5416,5416,0,5424,5424,5424,5424,5424,5424,5424,0,5424,5424,5424,0,5424,0,0,0,0,5441,5442,5442,5444,5444,5444,5444,5448,5448,5448,5448,5448,5448,5448,0,5456,5456,5456,5456,5456,5456,5456,0,5456,5456,5456,0,5456,0,0,0,5472,5472,5472,5472,5472,5472,5472,0,5472,5472,5472,0,5472,0,0,0,5472,5472,5472,0,5472,0,0,0,5472,0,0,0,0,0,0,0,0,5505,5506,5506,5508,5508,5508,5508,5512,5512,5512,5512,5512,5512,5512,0,5520,5520,5520,5520,5520,5520,5520,0,5520,5520,5520,0,5520,0,0,0,5536,5536,5536,5536,5536,5536,5536,0,5536,5536,5536,0,5536,0,0,0,5536,5536,5536,0,5536,0,0,0,5536,0,0,0,0,0,0,0,5568,5568,5568,5568,5568,5568,5568,0,5568,5568,5568,0,5568,0,0,0,5568,5568,5568,0,5568,0,0,0,5568,0,0,0,0,0,0,0,5568,5568,5568,0,5568,0,0,0,5568,0,0,0,0,0,0,0,7,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,5635,0,5637,5638,5638,0,5641,5642,5642,5644,5644,5644,2,0,5649,5650,5650,5652,5652,5652,5652,5656,5656,5656,5656,5656,5656,5656,0,0,5665,5666,5666,5668,5668,5668,5668,5672,5672,5672,5672,5672,5672,5672,0,5680,5680,5680,5680,5680,5680,5680,0,5680,5680,5680,0,5680,0,0,0,0,5697,5698,5698,5700,5700,5700,5700,5704,5704,5704,5704,5704,5704,5704,0,5712,5712,5712,5712,5712,5712,5712,0,5712,5712,5712,0,5712,0,0,0,5728,5728,5728,5728,5728,5728,5728,0,5728,5728,5728,0,5728,0,0,0,5728,5728,5728,0,5728,0,0,0,5728,0,0,0,0,0,0,0,0,5761,5762,5762,5764,5764,5764,5764,5768,5768,5768,5768,5768,5768,5768,0,5776,5776,5776,5776,5776,5776,5776,0,5776,5776,5776,0,5776,0,0,0,5792,5792,5792,5792,5792,5792,5792,0,5792,5792,5792,0,5792,0,0,0,5792,5792,5792,0,5792,0,0,0,5792,0,0,0,0,0,0,0,5824,5824,5824,5824,5824,5824,5824,0,5824,5824,5824,0,5824,0,0,0,5824,5824,5824,0,5824,0,0,0,5824,0,0,0,0,0,0,0,5824,5824,5824,0,5824,0,0,0,5824,0,0,0,0,0,0,0,5824,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,5889,5890,5890,5892,5892,5892,5892,5896,5896,5896,5896,5896,5896,5896,0,5904,5904,5904,5904,5904,5904,5904,0,5904,5904,5904,0,5904,0,0,0,5920,5920,5920,5920,5920,5920,5920,0,5920,5920,5920,0,5920,0,0,0,5920,5920,5920,0,5920,0,0,0,5920,0,0,0,0,0,0,0,5952,5952,5952,5952,5952,5952,5952,0,5952,5952,5952,0,5952,0,0,0,5952,5952,5952,0,5952,0,0,0,5952,0,0,0,0,0,0,0,5952,5952,5952,0,5952,0,0,0,5952,0,0,0,0,0,0,0,5952,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,6016,6016,6016,6016,6016,6016,6016,0,6016,6016,6016,0,6016,0,0,0,6016,6016,6016,0,6016,0,0,0,6016,0,0,0,0,0,0,0,6016,6016,6016,0,6016,0,0,0,6016,0,0,0,0,0,0,0,6016,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,9,9,9,0,9,0,0,0,9,0,0,0,0,0,0,0,9,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,9,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,6151,0,0,0,6155,0,6157,6158,2,0,0,0,6163,0,6165,6166,6166,0,6169,6170,6170,6172,6172,6172,3,0,0,0,6179,0,6181,6182,6182,0,6185,6186,6186,6188,6188,6188,2,0,6193,6194,6194,6196,6196,6196,6196,6200,6200,6200,6200,6200,6200,4,0,0,0,0,6211,0,6213,6214,6214,0,6217,6218,6218,6220,6220,6220,2,0,6225,6226,6226,6228,6228,6228,6228,6232,6232,6232,6232,6232,6232,6232,0,0,6241,6242,6242,6244,6244,6244,6244,6248,6248,6248,6248,6248,6248,6248,0,6256,6256,6256,6256,6256,6256,6256,0,6256,6256,6256,0,5,0,0,0,0,0,0,6275,0,6277,6278,6278,0,6281,6282,6282,6284,6284,6284,2,0,6289,6290,6290,6292,6292,6292,6292,6296,6296,6296,6296,6296,6296,6296,0,0,6305,6306,6306,6308,6308,6308,6308,6312,6312,6312,6312,6312,6312,6312,0,6320,6320,6320,6320,6320,6320,6320,0,6320,6320,6320,0,6320,0,0,0,0,6337,6338,6338,6340,6340,6340,6340,6344,6344,6344,6344,6344,6344,6344,0,6352,6352,6352,6352,6352,6352,6352,0,6352,6352,6352,0,6352,0,0,0,6368,6368,6368,6368,6368,6368,6368,0,6368,6368,6368,0,6368,0,0,0,6368,6368,6368,0,6368,0,0,0,6,0,0,0,0,0,0,0,0,0,0,6403,0,6405,6406,6406,0,6409,6410,6410,6412,6412,6412,2,0,6417,6418,6418,6420,6420,6420,6420,6424,6424,6424,6424,6424,6424,6424,0,0,6433,6434,6434,6436,6436,6436,6436,6440,6440,6440,6440,6440,6440,6440,0,6448,6448,6448,6448,6448,6448,6448,0,6448,6448,6448,0,6448,0,0,0,0,6465,6466,6466,6468,6468,6468,6468,6472,6472,6472,6472,6472,6472,6472,0,6480,6480,6480,6480,6480,6480,6480,0,6480,6480,6480,0,6480,0,0,0,6496,6496,6496,6496,6496,6496,6496,0,6496,6496,6496,0,6496,0,0,0,6496,6496,6496,0,6496,0,0,0,6496,0,0,0,0,0,0,0,0,6529,6530,6530,6532,6532,6532,6532,6536,6536,6536,6536,6536,6536,6536,0,6544,6544,6544,6544,6544,6544,6544,0,6544,6544,6544,0,6544,0,0,0,6560,6560,6560,6560,6560,6560,6560,0,6560,6560,6560,0,6560,0,0,0,6560,6560,6560,0,6560,0,0,0,6560,0,0,0,0,0,0,0,6592,6592,6592,6592,6592,6592,6592,0,6592,6592,6592,0,6592,0,0,0,6592,6592,6592,0,6592,0,0,0,6592,0,0,0,0,0,0,0,6592,6592,6592,0,6592,0,0,0,6592,0,0,0,0,0,0,0,7,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,6659,0,6661,6662,6662,0,6665,6666,6666,6668,6668,6668,2,0,6673,6674,6674,6676,6676,6676,6676,6680,6680,6680,6680,6680,6680,6680,0,0,6689,6690,6690,6692,6692,6692,6692,6696,6696,6696,6696,6696,6696,6696,0,6704,6704,6704,6704,6704,6704,6704,0,6704,6704,6704,0,6704,0,0,0,0,6721,6722,6722,6724,6724,6724,6724,6728,6728,6728,6728,6728,6728,6728,0,6736,6736,6736,6736,6736,6736,6736,0,6736,6736,6736,0,6736,0,0,0,6752,6752,6752,6752,6752,6752,6752,0,6752,6752,6752,0,6752,0,0,0,6752,6752,6752,0,6752,0,0,0,6752,0,0,0,0,0,0,0,0,6785,6786,6786,6788,6788,6788,6788,6792,6792,6792,6792,6792,6792,6792,0,6800,6800,6800,6800,6800,6800,6800,0,6800,6800,6800,0,6800,0,0,0,6816,6816,6816,6816,6816,6816,6816,0,6816,6816,6816,0,6816,0,0,0,6816,6816,6816,0,6816,0,0,0,6816,0,0,0,0,0,0,0,6848,6848,6848,6848,6848,6848,6848,0,6848,6848,6848,0,6848,0,0,0,6848,6848,6848,0,6848,0,0,0,6848,0,0,0,0,0,0,0,6848,6848,6848,0,6848,0,0,0,6848,0,0,0,0,0,0,0,6848,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,6913,6914,6914,6916,6916,6916,6916,6920,6920,6920,6920,6920,6920,6920,0,6928,6928,6928,6928,6928,6928,6928,0,6928,6928,6928,0,6928,0,0,0,6944,6944,6944,6944,6944,6944,6944,0,6944,6944,6944,0,6944,0,0,0,6944,6944,6944,0,6944,0,0,0,6944,0,0,0,0,0,0,0,6976,6976,6976,6976,6976,6976,6976,0,6976,6976,6976,0,6976,0,0,0,6976,6976,6976,0,6976,0,0,0,6976,0,0,0,0,0,0,0,6976,6976,6976,0,6976,0,0,0,6976,0,0,0,0,0,0,0,6976,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,7040,7040,7040,7040,7040,7040,7040,0,7040,7040,7040,0,7040,0,0,0,7040,7040,7040,0,7040,0,0,0,7040,0,0,0,0,0,0,0,7040,7040,7040,0,7040,0,0,0,7040,0,0,0,0,0,0,0,7040,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,7040,7040,7040,0,7040,0,0,0,7040,0,0,0,0,0,0,0,7040,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,8,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,7171,0,7173,7174,7174,0,7177,7178,7178,7180,7180,7180,2,0,7185,7186,7186,7188,7188,7188,7188,7192,7192,7192,7192,7192,7192,7192,0,0,7201,7202,7202,7204,7204,7204,7204,7208,7208,7208,7208,7208,7208,7208,0,7216,7216,7216,7216,7216,7216,7216,0,7216,7216,7216,0,7216,0,0,0,0,7233,7234,7234,7236,7236,7236,7236,7240,7240,7240,7240,7240,7240,7240,0,7248,7248,7248,7248,7248,7248,7248,0,7248,7248,7248,0,7248,0,0,0,7264,7264,7264,7264,7264,7264,7264,0,7264,7264,7264,0,7264,0,0,0,7264,7264,7264,0,7264,0,0,0,7264,0,0,0,0,0,0,0,0,7297,7298,7298,7300,7300,7300,7300,7304,7304,7304,7304,7304,7304,7304,0,7312,7312,7312,7312,7312,7312,7312,0,7312,7312,7312,0,7312,0,0,0,7328,7328,7328,7328,7328,7328,7328,0,7328,7328,7328,0,7328,0,0,0,7328,7328,7328,0,7328,0,0,0,7328,0,0,0,0,0,0,0,7360,7360,7360,7360,7360,7360,7360,0,7360,7360,7360,0,7360,0,0,0,7360,7360,7360,0,7360,0,0,0,7360,0,0,0,0,0,0,0,7360,7360,7360,0,7360,0,0,0,7360,0,0,0,0,0,0,0,7360,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,7425,7426,7426,7428,7428,7428,7428,7432,7432,7432,7432,7432,7432,7432,0,7440,7440,7440,7440,7440,7440,7440,0,7440,7440,7440,0,7440,0,0,0,7456,7456,7456,7456,7456,7456,7456,0,7456,7456,7456,0,7456,0,0,0,7456,7456,7456,0,7456,0,0,0,7456,0,0,0,0,0,0,0,7488,7488,7488,7488,7488,7488,7488,0,7488,7488,7488,0,7488,0,0,0,7488,7488,7488,0,7488,0,0,0,7488,0,0,0,0,0,0,0,7488,7488,7488,0,7488,0,0,0,7488,0,0,0,0,0,0,0,7488,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,7552,7552,7552,7552,7552,7552,7552,0,7552,7552,7552,0,7552,0,0,0,7552,7552,7552,0,7552,0,0,0,7552,0,0,0,0,0,0,0,7552,7552,7552,0,7552,0,0,0,7552,0,0,0,0,0,0,0,7552,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,7552,7552,7552,0,7552,0,0,0,7552,0,0,0,0,0,0,0,7552,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,7552,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,7681,7682,7682,7684,7684,7684,7684,7688,7688,7688,7688,7688,7688,7688,0,7696,7696,7696,7696,7696,7696,7696,0,7696,7696,7696,0,7696,0,0,0,7712,7712,7712,7712,7712,7712,7712,0,7712,7712,7712,0,7712,0,0,0,7712,7712,7712,0,7712,0,0,0,7712,0,0,0,0,0,0,0,7744,7744,7744,7744,7744,7744,7744,0,7744,7744,7744,0,7744,0,0,0,7744,7744,7744,0,7744,0,0,0,7744,0,0,0,0,0,0,0,7744,7744,7744,0,7744,0,0,0,7744,0,0,0,0,0,0,0,7744,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,7808,7808,7808,7808,7808,7808,7808,0,7808,7808,7808,0,7808,0,0,0,7808,7808,7808,0,7808,0,0,0,7808,0,0,0,0,0,0,0,7808,7808,7808,0,7808,0,0,0,7808,0,0,0,0,0,0,0,7808,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,7808,7808,7808,0,7808,0,0,0,7808,0,0,0,0,0,0,0,7808,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,7808,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,11,11,11,11,11,11,11,0,11,11,11,0,11,0,0,0,11,11,11,0,11,0,0,0,11,0,0,0,0,0,0,0,11,11,11,0,11,0,0,0,11,0,0,0,0,0,0,0,11,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,11,11,11,0,11,0,0,0,11,0,0,0,0,0,0,0,11,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,11,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,11,11,11,0,11,0,0,0,11,0,0,0,0,0,0,0,11,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,11,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,11}
+
+#define STRAIGHT_TABLE {0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,3,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,4,4,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,3,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,5,5,5,5,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,3,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,4,4,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,3,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,6,6,6,6,6,6,6,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,3,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,4,4,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,3,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,5,5,5,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,3,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,4,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,7,7,7,7,7,7,7,0,7,7,7,0,7,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,3,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,4,4,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,3,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,5,5,5,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,3,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,4,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,6,6,6,0,6,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,3,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,4,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,5,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,8,8,8,8,8,8,8,0,8,8,8,0,8,0,0,0,8,8,8,0,8,0,0,0,8,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,3,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,4,4,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,3,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,5,5,5,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,3,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,4,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,6,6,6,0,6,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,3,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,4,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,5,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,7,7,7,0,7,0,0,0,7,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,3,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,4,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,5,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,6,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,9,9,9,9,9,9,9,0,9,9,9,0,9,0,0,0,9,9,9,0,9,0,0,0,9,0,0,0,0,0,0,0,9,9,9,0,9,0,0,0,9,0,0,0,0,0,0,0,9,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,3,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,4,4,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,3,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,5,5,5,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,3,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,4,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,6,6,6,0,6,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,3,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,4,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,5,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,7,7,7,0,7,0,0,0,7,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,3,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,4,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,5,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,6,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,8,8,8,0,8,0,0,0,8,0,0,0,0,0,0,0,8,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,3,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,4,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,5,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,6,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,7,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,10,10,10,10,10,10,10,0,10,10,10,0,10,0,0,0,10,10,10,0,10,0,0,0,10,0,0,0,0,0,0,0,10,10,10,0,10,0,0,0,10,0,0,0,0,0,0,0,10,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,10,10,10,0,10,0,0,0,10,0,0,0,0,0,0,0,10,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,10,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,2,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,3,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,2,0,0,0,0,0,0,0,0,0,0,0,0,0,0,4,4,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,2,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,3,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,2,0,0,0,0,0,0,0,0,0,0,0,0,5,5,5,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,2,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,3,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,2,0,0,0,0,0,0,0,0,0,0,0,0,0,0,4,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,2,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,6,6,6,0,6,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,2,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,3,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,2,0,0,0,0,0,0,0,0,0,0,0,0,0,0,4,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,2,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,5,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,2,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,7,7,7,0,7,0,0,0,7,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,2,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,3,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,2,0,0,0,0,0,0,0,0,0,0,0,0,0,0,4,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,2,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,5,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,2,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,6,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,2,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,8,8,8,0,8,0,0,0,8,0,0,0,0,0,0,0,8,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,2,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,3,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,2,0,0,0,0,0,0,0,0,0,0,0,0,0,0,4,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,2,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,5,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,2,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,6,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,2,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,7,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,2,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,9,9,9,0,9,0,0,0,9,0,0,0,0,0,0,0,9,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,9,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,2,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,3,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,2,0,0,0,0,0,0,0,0,0,0,0,0,0,0,4,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,2,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,5,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,2,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,6,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,2,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,7,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,2,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,8,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,2,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,11,11,11,11,11,11,11,0,11,11,11,0,11,0,0,0,11,11,11,0,11,0,0,0,11,0,0,0,0,0,0,0,11,11,11,0,11,0,0,0,11,0,0,0,0,0,0,0,11,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,11,11,11,0,11,0,0,0,11,0,0,0,0,0,0,0,11,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,11,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,11,11,11,0,11,0,0,0,11,0,0,0,0,0,0,0,11,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,11,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,11}
+
+#define LOWBITS {255,1,2,1,4,1,2,1,8,1,2,1,4,1,2,1,16,1,2,1,4,1,2,1,8,1,2,1,4,1,2,1,32,1,2,1,4,1,2,1,8,1,2,1,4,1,2,1,16,1,2,1,4,1,2,1,8,1,2,1,4,1,2,1,64,1,2,1,4,1,2,1,8,1,2,1,4,1,2,1,16,1,2,1,4,1,2,1,8,1,2,1,4,1,2,1,32,1,2,1,4,1,2,1,8,1,2,1,4,1,2,1,16,1,2,1,4,1,2,1,8,1,2,1,4,1,2,1,128,1,2,1,4,1,2,1,8,1,2,1,4,1,2,1,16,1,2,1,4,1,2,1,8,1,2,1,4,1,2,1,32,1,2,1,4,1,2,1,8,1,2,1,4,1,2,1,16,1,2,1,4,1,2,1,8,1,2,1,4,1,2,1,64,1,2,1,4,1,2,1,8,1,2,1,4,1,2,1,16,1,2,1,4,1,2,1,8,1,2,1,4,1,2,1,32,1,2,1,4,1,2,1,8,1,2,1,4,1,2,1,16,1,2,1,4,1,2,1,8,1,2,1,4,1,2,1,256,1,2,1,4,1,2,1,8,1,2,1,4,1,2,1,16,1,2,1,4,1,2,1,8,1,2,1,4,1,2,1,32,1,2,1,4,1,2,1,8,1,2,1,4,1,2,1,16,1,2,1,4,1,2,1,8,1,2,1,4,1,2,1,64,1,2,1,4,1,2,1,8,1,2,1,4,1,2,1,16,1,2,1,4,1,2,1,8,1,2,1,4,1,2,1,32,1,2,1,4,1,2,1,8,1,2,1,4,1,2,1,16,1,2,1,4,1,2,1,8,1,2,1,4,1,2,1,128,1,2,1,4,1,2,1,8,1,2,1,4,1,2,1,16,1,2,1,4,1,2,1,8,1,2,1,4,1,2,1,32,1,2,1,4,1,2,1,8,1,2,1,4,1,2,1,16,1,2,1,4,1,2,1,8,1,2,1,4,1,2,1,64,1,2,1,4,1,2,1,8,1,2,1,4,1,2,1,16,1,2,1,4,1,2,1,8,1,2,1,4,1,2,1,32,1,2,1,4,1,2,1,8,1,2,1,4,1,2,1,16,1,2,1,4,1,2,1,8,1,2,1,4,1,2,1,512,1,2,1,4,1,2,1,8,1,2,1,4,1,2,1,16,1,2,1,4,1,2,1,8,1,2,1,4,1,2,1,32,1,2,1,4,1,2,1,8,1,2,1,4,1,2,1,16,1,2,1,4,1,2,1,8,1,2,1,4,1,2,1,64,1,2,1,4,1,2,1,8,1,2,1,4,1,2,1,16,1,2,1,4,1,2,1,8,1,2,1,4,1,2,1,32,1,2,1,4,1,2,1,8,1,2,1,4,1,2,1,16,1,2,1,4,1,2,1,8,1,2,1,4,1,2,1,128,1,2,1,4,1,2,1,8,1,2,1,4,1,2,1,16,1,2,1,4,1,2,1,8,1,2,1,4,1,2,1,32,1,2,1,4,1,2,1,8,1,2,1,4,1,2,1,16,1,2,1,4,1,2,1,8,1,2,1,4,1,2,1,64,1,2,1,4,1,2,1,8,1,2,1,4,1,2,1,16,1,2,1,4,1,2,1,8,1,2,1,4,1,2,1,32,1,2,1,4,1,2,1,8,1,2,1,4,1,2,1,16,1,2,1,4,1,2,1,8,1,2,1,4,1,2,1,256,1,2,1,4,1,2,1,8,1,2,1,4,1,2,1,16,1,2,1,4,1,2,1,8,1,2,1,4,1,2,1,32,1,2,1,4,1,2,1,8,1,2,1,4,1,2,1,16,1,2,1,4,1,2,1,8,1,2,1,4,1,2,1,64,1,2,1,4,1,2,1,8,1,2,1,4,1,2,1,16,1,2,1,4,1,2,1,8,1,2,1,4,1,2,1,32,1,2,1,4,1,2,1,8,1,2,1,4,1,2,1,16,1,2,1,4,1,2,1,8,1,2,1,4,1,2,1,128,1,2,1,4,1,2,1,8,1,2,1,4,1,2,1,16,1,2,1,4,1,2,1,8,1,2,1,4,1,2,1,32,1,2,1,4,1,2,1,8,1,2,1,4,1,2,1,16,1,2,1,4,1,2,1,8,1,2,1,4,1,2,1,64,1,2,1,4,1,2,1,8,1,2,1,4,1,2,1,16,1,2,1,4,1,2,1,8,1,2,1,4,1,2,1,32,1,2,1,4,1,2,1,8,1,2,1,4,1,2,1,16,1,2,1,4,1,2,1,8,1,2,1,4,1,2,1,1024,1,2,1,4,1,2,1,8,1,2,1,4,1,2,1,16,1,2,1,4,1,2,1,8,1,2,1,4,1,2,1,32,1,2,1,4,1,2,1,8,1,2,1,4,1,2,1,16,1,2,1,4,1,2,1,8,1,2,1,4,1,2,1,64,1,2,1,4,1,2,1,8,1,2,1,4,1,2,1,16,1,2,1,4,1,2,1,8,1,2,1,4,1,2,1,32,1,2,1,4,1,2,1,8,1,2,1,4,1,2,1,16,1,2,1,4,1,2,1,8,1,2,1,4,1,2,1,128,1,2,1,4,1,2,1,8,1,2,1,4,1,2,1,16,1,2,1,4,1,2,1,8,1,2,1,4,1,2,1,32,1,2,1,4,1,2,1,8,1,2,1,4,1,2,1,16,1,2,1,4,1,2,1,8,1,2,1,4,1,2,1,64,1,2,1,4,1,2,1,8,1,2,1,4,1,2,1,16,1,2,1,4,1,2,1,8,1,2,1,4,1,2,1,32,1,2,1,4,1,2,1,8,1,2,1,4,1,2,1,16,1,2,1,4,1,2,1,8,1,2,1,4,1,2,1,256,1,2,1,4,1,2,1,8,1,2,1,4,1,2,1,16,1,2,1,4,1,2,1,8,1,2,1,4,1,2,1,32,1,2,1,4,1,2,1,8,1,2,1,4,1,2,1,16,1,2,1,4,1,2,1,8,1,2,1,4,1,2,1,64,1,2,1,4,1,2,1,8,1,2,1,4,1,2,1,16,1,2,1,4,1,2,1,8,1,2,1,4,1,2,1,32,1,2,1,4,1,2,1,8,1,2,1,4,1,2,1,16,1,2,1,4,1,2,1,8,1,2,1,4,1,2,1,128,1,2,1,4,1,2,1,8,1,2,1,4,1,2,1,16,1,2,1,4,1,2,1,8,1,2,1,4,1,2,1,32,1,2,1,4,1,2,1,8,1,2,1,4,1,2,1,16,1,2,1,4,1,2,1,8,1,2,1,4,1,2,1,64,1,2,1,4,1,2,1,8,1,2,1,4,1,2,1,16,1,2,1,4,1,2,1,8,1,2,1,4,1,2,1,32,1,2,1,4,1,2,1,8,1,2,1,4,1,2,1,16,1,2,1,4,1,2,1,8,1,2,1,4,1,2,1,512,1,2,1,4,1,2,1,8,1,2,1,4,1,2,1,16,1,2,1,4,1,2,1,8,1,2,1,4,1,2,1,32,1,2,1,4,1,2,1,8,1,2,1,4,1,2,1,16,1,2,1,4,1,2,1,8,1,2,1,4,1,2,1,64,1,2,1,4,1,2,1,8,1,2,1,4,1,2,1,16,1,2,1,4,1,2,1,8,1,2,1,4,1,2,1,32,1,2,1,4,1,2,1,8,1,2,1,4,1,2,1,16,1,2,1,4,1,2,1,8,1,2,1,4,1,2,1,128,1,2,1,4,1,2,1,8,1,2,1,4,1,2,1,16,1,2,1,4,1,2,1,8,1,2,1,4,1,2,1,32,1,2,1,4,1,2,1,8,1,2,1,4,1,2,1,16,1,2,1,4,1,2,1,8,1,2,1,4,1,2,1,64,1,2,1,4,1,2,1,8,1,2,1,4,1,2,1,16,1,2,1,4,1,2,1,8,1,2,1,4,1,2,1,32,1,2,1,4,1,2,1,8,1,2,1,4,1,2,1,16,1,2,1,4,1,2,1,8,1,2,1,4,1,2,1,256,1,2,1,4,1,2,1,8,1,2,1,4,1,2,1,16,1,2,1,4,1,2,1,8,1,2,1,4,1,2,1,32,1,2,1,4,1,2,1,8,1,2,1,4,1,2,1,16,1,2,1,4,1,2,1,8,1,2,1,4,1,2,1,64,1,2,1,4,1,2,1,8,1,2,1,4,1,2,1,16,1,2,1,4,1,2,1,8,1,2,1,4,1,2,1,32,1,2,1,4,1,2,1,8,1,2,1,4,1,2,1,16,1,2,1,4,1,2,1,8,1,2,1,4,1,2,1,128,1,2,1,4,1,2,1,8,1,2,1,4,1,2,1,16,1,2,1,4,1,2,1,8,1,2,1,4,1,2,1,32,1,2,1,4,1,2,1,8,1,2,1,4,1,2,1,16,1,2,1,4,1,2,1,8,1,2,1,4,1,2,1,64,1,2,1,4,1,2,1,8,1,2,1,4,1,2,1,16,1,2,1,4,1,2,1,8,1,2,1,4,1,2,1,32,1,2,1,4,1,2,1,8,1,2,1,4,1,2,1,16,1,2,1,4,1,2,1,8,1,2,1,4,1,2,1,2048,1,2,1,4,1,2,1,8,1,2,1,4,1,2,1,16,1,2,1,4,1,2,1,8,1,2,1,4,1,2,1,32,1,2,1,4,1,2,1,8,1,2,1,4,1,2,1,16,1,2,1,4,1,2,1,8,1,2,1,4,1,2,1,64,1,2,1,4,1,2,1,8,1,2,1,4,1,2,1,16,1,2,1,4,1,2,1,8,1,2,1,4,1,2,1,32,1,2,1,4,1,2,1,8,1,2,1,4,1,2,1,16,1,2,1,4,1,2,1,8,1,2,1,4,1,2,1,128,1,2,1,4,1,2,1,8,1,2,1,4,1,2,1,16,1,2,1,4,1,2,1,8,1,2,1,4,1,2,1,32,1,2,1,4,1,2,1,8,1,2,1,4,1,2,1,16,1,2,1,4,1,2,1,8,1,2,1,4,1,2,1,64,1,2,1,4,1,2,1,8,1,2,1,4,1,2,1,16,1,2,1,4,1,2,1,8,1,2,1,4,1,2,1,32,1,2,1,4,1,2,1,8,1,2,1,4,1,2,1,16,1,2,1,4,1,2,1,8,1,2,1,4,1,2,1,256,1,2,1,4,1,2,1,8,1,2,1,4,1,2,1,16,1,2,1,4,1,2,1,8,1,2,1,4,1,2,1,32,1,2,1,4,1,2,1,8,1,2,1,4,1,2,1,16,1,2,1,4,1,2,1,8,1,2,1,4,1,2,1,64,1,2,1,4,1,2,1,8,1,2,1,4,1,2,1,16,1,2,1,4,1,2,1,8,1,2,1,4,1,2,1,32,1,2,1,4,1,2,1,8,1,2,1,4,1,2,1,16,1,2,1,4,1,2,1,8,1,2,1,4,1,2,1,128,1,2,1,4,1,2,1,8,1,2,1,4,1,2,1,16,1,2,1,4,1,2,1,8,1,2,1,4,1,2,1,32,1,2,1,4,1,2,1,8,1,2,1,4,1,2,1,16,1,2,1,4,1,2,1,8,1,2,1,4,1,2,1,64,1,2,1,4,1,2,1,8,1,2,1,4,1,2,1,16,1,2,1,4,1,2,1,8,1,2,1,4,1,2,1,32,1,2,1,4,1,2,1,8,1,2,1,4,1,2,1,16,1,2,1,4,1,2,1,8,1,2,1,4,1,2,1,512,1,2,1,4,1,2,1,8,1,2,1,4,1,2,1,16,1,2,1,4,1,2,1,8,1,2,1,4,1,2,1,32,1,2,1,4,1,2,1,8,1,2,1,4,1,2,1,16,1,2,1,4,1,2,1,8,1,2,1,4,1,2,1,64,1,2,1,4,1,2,1,8,1,2,1,4,1,2,1,16,1,2,1,4,1,2,1,8,1,2,1,4,1,2,1,32,1,2,1,4,1,2,1,8,1,2,1,4,1,2,1,16,1,2,1,4,1,2,1,8,1,2,1,4,1,2,1,128,1,2,1,4,1,2,1,8,1,2,1,4,1,2,1,16,1,2,1,4,1,2,1,8,1,2,1,4,1,2,1,32,1,2,1,4,1,2,1,8,1,2,1,4,1,2,1,16,1,2,1,4,1,2,1,8,1,2,1,4,1,2,1,64,1,2,1,4,1,2,1,8,1,2,1,4,1,2,1,16,1,2,1,4,1,2,1,8,1,2,1,4,1,2,1,32,1,2,1,4,1,2,1,8,1,2,1,4,1,2,1,16,1,2,1,4,1,2,1,8,1,2,1,4,1,2,1,256,1,2,1,4,1,2,1,8,1,2,1,4,1,2,1,16,1,2,1,4,1,2,1,8,1,2,1,4,1,2,1,32,1,2,1,4,1,2,1,8,1,2,1,4,1,2,1,16,1,2,1,4,1,2,1,8,1,2,1,4,1,2,1,64,1,2,1,4,1,2,1,8,1,2,1,4,1,2,1,16,1,2,1,4,1,2,1,8,1,2,1,4,1,2,1,32,1,2,1,4,1,2,1,8,1,2,1,4,1,2,1,16,1,2,1,4,1,2,1,8,1,2,1,4,1,2,1,128,1,2,1,4,1,2,1,8,1,2,1,4,1,2,1,16,1,2,1,4,1,2,1,8,1,2,1,4,1,2,1,32,1,2,1,4,1,2,1,8,1,2,1,4,1,2,1,16,1,2,1,4,1,2,1,8,1,2,1,4,1,2,1,64,1,2,1,4,1,2,1,8,1,2,1,4,1,2,1,16,1,2,1,4,1,2,1,8,1,2,1,4,1,2,1,32,1,2,1,4,1,2,1,8,1,2,1,4,1,2,1,16,1,2,1,4,1,2,1,8,1,2,1,4,1,2,1,1024,1,2,1,4,1,2,1,8,1,2,1,4,1,2,1,16,1,2,1,4,1,2,1,8,1,2,1,4,1,2,1,32,1,2,1,4,1,2,1,8,1,2,1,4,1,2,1,16,1,2,1,4,1,2,1,8,1,2,1,4,1,2,1,64,1,2,1,4,1,2,1,8,1,2,1,4,1,2,1,16,1,2,1,4,1,2,1,8,1,2,1,4,1,2,1,32,1,2,1,4,1,2,1,8,1,2,1,4,1,2,1,16,1,2,1,4,1,2,1,8,1,2,1,4,1,2,1,128,1,2,1,4,1,2,1,8,1,2,1,4,1,2,1,16,1,2,1,4,1,2,1,8,1,2,1,4,1,2,1,32,1,2,1,4,1,2,1,8,1,2,1,4,1,2,1,16,1,2,1,4,1,2,1,8,1,2,1,4,1,2,1,64,1,2,1,4,1,2,1,8,1,2,1,4,1,2,1,16,1,2,1,4,1,2,1,8,1,2,1,4,1,2,1,32,1,2,1,4,1,2,1,8,1,2,1,4,1,2,1,16,1,2,1,4,1,2,1,8,1,2,1,4,1,2,1,256,1,2,1,4,1,2,1,8,1,2,1,4,1,2,1,16,1,2,1,4,1,2,1,8,1,2,1,4,1,2,1,32,1,2,1,4,1,2,1,8,1,2,1,4,1,2,1,16,1,2,1,4,1,2,1,8,1,2,1,4,1,2,1,64,1,2,1,4,1,2,1,8,1,2,1,4,1,2,1,16,1,2,1,4,1,2,1,8,1,2,1,4,1,2,1,32,1,2,1,4,1,2,1,8,1,2,1,4,1,2,1,16,1,2,1,4,1,2,1,8,1,2,1,4,1,2,1,128,1,2,1,4,1,2,1,8,1,2,1,4,1,2,1,16,1,2,1,4,1,2,1,8,1,2,1,4,1,2,1,32,1,2,1,4,1,2,1,8,1,2,1,4,1,2,1,16,1,2,1,4,1,2,1,8,1,2,1,4,1,2,1,64,1,2,1,4,1,2,1,8,1,2,1,4,1,2,1,16,1,2,1,4,1,2,1,8,1,2,1,4,1,2,1,32,1,2,1,4,1,2,1,8,1,2,1,4,1,2,1,16,1,2,1,4,1,2,1,8,1,2,1,4,1,2,1,512,1,2,1,4,1,2,1,8,1,2,1,4,1,2,1,16,1,2,1,4,1,2,1,8,1,2,1,4,1,2,1,32,1,2,1,4,1,2,1,8,1,2,1,4,1,2,1,16,1,2,1,4,1,2,1,8,1,2,1,4,1,2,1,64,1,2,1,4,1,2,1,8,1,2,1,4,1,2,1,16,1,2,1,4,1,2,1,8,1,2,1,4,1,2,1,32,1,2,1,4,1,2,1,8,1,2,1,4,1,2,1,16,1,2,1,4,1,2,1,8,1,2,1,4,1,2,1,128,1,2,1,4,1,2,1,8,1,2,1,4,1,2,1,16,1,2,1,4,1,2,1,8,1,2,1,4,1,2,1,32,1,2,1,4,1,2,1,8,1,2,1,4,1,2,1,16,1,2,1,4,1,2,1,8,1,2,1,4,1,2,1,64,1,2,1,4,1,2,1,8,1,2,1,4,1,2,1,16,1,2,1,4,1,2,1,8,1,2,1,4,1,2,1,32,1,2,1,4,1,2,1,8,1,2,1,4,1,2,1,16,1,2,1,4,1,2,1,8,1,2,1,4,1,2,1,256,1,2,1,4,1,2,1,8,1,2,1,4,1,2,1,16,1,2,1,4,1,2,1,8,1,2,1,4,1,2,1,32,1,2,1,4,1,2,1,8,1,2,1,4,1,2,1,16,1,2,1,4,1,2,1,8,1,2,1,4,1,2,1,64,1,2,1,4,1,2,1,8,1,2,1,4,1,2,1,16,1,2,1,4,1,2,1,8,1,2,1,4,1,2,1,32,1,2,1,4,1,2,1,8,1,2,1,4,1,2,1,16,1,2,1,4,1,2,1,8,1,2,1,4,1,2,1,128,1,2,1,4,1,2,1,8,1,2,1,4,1,2,1,16,1,2,1,4,1,2,1,8,1,2,1,4,1,2,1,32,1,2,1,4,1,2,1,8,1,2,1,4,1,2,1,16,1,2,1,4,1,2,1,8,1,2,1,4,1,2,1,64,1,2,1,4,1,2,1,8,1,2,1,4,1,2,1,16,1,2,1,4,1,2,1,8,1,2,1,4,1,2,1,32,1,2,1,4,1,2,1,8,1,2,1,4,1,2,1,16,1,2,1,4,1,2,1,8,1,2,1,4,1,2,1,4096,1,2,1,4,1,2,1,8,1,2,1,4,1,2,1,16,1,2,1,4,1,2,1,8,1,2,1,4,1,2,1,32,1,2,1,4,1,2,1,8,1,2,1,4,1,2,1,16,1,2,1,4,1,2,1,8,1,2,1,4,1,2,1,64,1,2,1,4,1,2,1,8,1,2,1,4,1,2,1,16,1,2,1,4,1,2,1,8,1,2,1,4,1,2,1,32,1,2,1,4,1,2,1,8,1,2,1,4,1,2,1,16,1,2,1,4,1,2,1,8,1,2,1,4,1,2,1,128,1,2,1,4,1,2,1,8,1,2,1,4,1,2,1,16,1,2,1,4,1,2,1,8,1,2,1,4,1,2,1,32,1,2,1,4,1,2,1,8,1,2,1,4,1,2,1,16,1,2,1,4,1,2,1,8,1,2,1,4,1,2,1,64,1,2,1,4,1,2,1,8,1,2,1,4,1,2,1,16,1,2,1,4,1,2,1,8,1,2,1,4,1,2,1,32,1,2,1,4,1,2,1,8,1,2,1,4,1,2,1,16,1,2,1,4,1,2,1,8,1,2,1,4,1,2,1,256,1,2,1,4,1,2,1,8,1,2,1,4,1,2,1,16,1,2,1,4,1,2,1,8,1,2,1,4,1,2,1,32,1,2,1,4,1,2,1,8,1,2,1,4,1,2,1,16,1,2,1,4,1,2,1,8,1,2,1,4,1,2,1,64,1,2,1,4,1,2,1,8,1,2,1,4,1,2,1,16,1,2,1,4,1,2,1,8,1,2,1,4,1,2,1,32,1,2,1,4,1,2,1,8,1,2,1,4,1,2,1,16,1,2,1,4,1,2,1,8,1,2,1,4,1,2,1,128,1,2,1,4,1,2,1,8,1,2,1,4,1,2,1,16,1,2,1,4,1,2,1,8,1,2,1,4,1,2,1,32,1,2,1,4,1,2,1,8,1,2,1,4,1,2,1,16,1,2,1,4,1,2,1,8,1,2,1,4,1,2,1,64,1,2,1,4,1,2,1,8,1,2,1,4,1,2,1,16,1,2,1,4,1,2,1,8,1,2,1,4,1,2,1,32,1,2,1,4,1,2,1,8,1,2,1,4,1,2,1,16,1,2,1,4,1,2,1,8,1,2,1,4,1,2,1,512,1,2,1,4,1,2,1,8,1,2,1,4,1,2,1,16,1,2,1,4,1,2,1,8,1,2,1,4,1,2,1,32,1,2,1,4,1,2,1,8,1,2,1,4,1,2,1,16,1,2,1,4,1,2,1,8,1,2,1,4,1,2,1,64,1,2,1,4,1,2,1,8,1,2,1,4,1,2,1,16,1,2,1,4,1,2,1,8,1,2,1,4,1,2,1,32,1,2,1,4,1,2,1,8,1,2,1,4,1,2,1,16,1,2,1,4,1,2,1,8,1,2,1,4,1,2,1,128,1,2,1,4,1,2,1,8,1,2,1,4,1,2,1,16,1,2,1,4,1,2,1,8,1,2,1,4,1,2,1,32,1,2,1,4,1,2,1,8,1,2,1,4,1,2,1,16,1,2,1,4,1,2,1,8,1,2,1,4,1,2,1,64,1,2,1,4,1,2,1,8,1,2,1,4,1,2,1,16,1,2,1,4,1,2,1,8,1,2,1,4,1,2,1,32,1,2,1,4,1,2,1,8,1,2,1,4,1,2,1,16,1,2,1,4,1,2,1,8,1,2,1,4,1,2,1,256,1,2,1,4,1,2,1,8,1,2,1,4,1,2,1,16,1,2,1,4,1,2,1,8,1,2,1,4,1,2,1,32,1,2,1,4,1,2,1,8,1,2,1,4,1,2,1,16,1,2,1,4,1,2,1,8,1,2,1,4,1,2,1,64,1,2,1,4,1,2,1,8,1,2,1,4,1,2,1,16,1,2,1,4,1,2,1,8,1,2,1,4,1,2,1,32,1,2,1,4,1,2,1,8,1,2,1,4,1,2,1,16,1,2,1,4,1,2,1,8,1,2,1,4,1,2,1,128,1,2,1,4,1,2,1,8,1,2,1,4,1,2,1,16,1,2,1,4,1,2,1,8,1,2,1,4,1,2,1,32,1,2,1,4,1,2,1,8,1,2,1,4,1,2,1,16,1,2,1,4,1,2,1,8,1,2,1,4,1,2,1,64,1,2,1,4,1,2,1,8,1,2,1,4,1,2,1,16,1,2,1,4,1,2,1,8,1,2,1,4,1,2,1,32,1,2,1,4,1,2,1,8,1,2,1,4,1,2,1,16,1,2,1,4,1,2,1,8,1,2,1,4,1,2,1,1024,1,2,1,4,1,2,1,8,1,2,1,4,1,2,1,16,1,2,1,4,1,2,1,8,1,2,1,4,1,2,1,32,1,2,1,4,1,2,1,8,1,2,1,4,1,2,1,16,1,2,1,4,1,2,1,8,1,2,1,4,1,2,1,64,1,2,1,4,1,2,1,8,1,2,1,4,1,2,1,16,1,2,1,4,1,2,1,8,1,2,1,4,1,2,1,32,1,2,1,4,1,2,1,8,1,2,1,4,1,2,1,16,1,2,1,4,1,2,1,8,1,2,1,4,1,2,1,128,1,2,1,4,1,2,1,8,1,2,1,4,1,2,1,16,1,2,1,4,1,2,1,8,1,2,1,4,1,2,1,32,1,2,1,4,1,2,1,8,1,2,1,4,1,2,1,16,1,2,1,4,1,2,1,8,1,2,1,4,1,2,1,64,1,2,1,4,1,2,1,8,1,2,1,4,1,2,1,16,1,2,1,4,1,2,1,8,1,2,1,4,1,2,1,32,1,2,1,4,1,2,1,8,1,2,1,4,1,2,1,16,1,2,1,4,1,2,1,8,1,2,1,4,1,2,1,256,1,2,1,4,1,2,1,8,1,2,1,4,1,2,1,16,1,2,1,4,1,2,1,8,1,2,1,4,1,2,1,32,1,2,1,4,1,2,1,8,1,2,1,4,1,2,1,16,1,2,1,4,1,2,1,8,1,2,1,4,1,2,1,64,1,2,1,4,1,2,1,8,1,2,1,4,1,2,1,16,1,2,1,4,1,2,1,8,1,2,1,4,1,2,1,32,1,2,1,4,1,2,1,8,1,2,1,4,1,2,1,16,1,2,1,4,1,2,1,8,1,2,1,4,1,2,1,128,1,2,1,4,1,2,1,8,1,2,1,4,1,2,1,16,1,2,1,4,1,2,1,8,1,2,1,4,1,2,1,32,1,2,1,4,1,2,1,8,1,2,1,4,1,2,1,16,1,2,1,4,1,2,1,8,1,2,1,4,1,2,1,64,1,2,1,4,1,2,1,8,1,2,1,4,1,2,1,16,1,2,1,4,1,2,1,8,1,2,1,4,1,2,1,32,1,2,1,4,1,2,1,8,1,2,1,4,1,2,1,16,1,2,1,4,1,2,1,8,1,2,1,4,1,2,1,512,1,2,1,4,1,2,1,8,1,2,1,4,1,2,1,16,1,2,1,4,1,2,1,8,1,2,1,4,1,2,1,32,1,2,1,4,1,2,1,8,1,2,1,4,1,2,1,16,1,2,1,4,1,2,1,8,1,2,1,4,1,2,1,64,1,2,1,4,1,2,1,8,1,2,1,4,1,2,1,16,1,2,1,4,1,2,1,8,1,2,1,4,1,2,1,32,1,2,1,4,1,2,1,8,1,2,1,4,1,2,1,16,1,2,1,4,1,2,1,8,1,2,1,4,1,2,1,128,1,2,1,4,1,2,1,8,1,2,1,4,1,2,1,16,1,2,1,4,1,2,1,8,1,2,1,4,1,2,1,32,1,2,1,4,1,2,1,8,1,2,1,4,1,2,1,16,1,2,1,4,1,2,1,8,1,2,1,4,1,2,1,64,1,2,1,4,1,2,1,8,1,2,1,4,1,2,1,16,1,2,1,4,1,2,1,8,1,2,1,4,1,2,1,32,1,2,1,4,1,2,1,8,1,2,1,4,1,2,1,16,1,2,1,4,1,2,1,8,1,2,1,4,1,2,1,256,1,2,1,4,1,2,1,8,1,2,1,4,1,2,1,16,1,2,1,4,1,2,1,8,1,2,1,4,1,2,1,32,1,2,1,4,1,2,1,8,1,2,1,4,1,2,1,16,1,2,1,4,1,2,1,8,1,2,1,4,1,2,1,64,1,2,1,4,1,2,1,8,1,2,1,4,1,2,1,16,1,2,1,4,1,2,1,8,1,2,1,4,1,2,1,32,1,2,1,4,1,2,1,8,1,2,1,4,1,2,1,16,1,2,1,4,1,2,1,8,1,2,1,4,1,2,1,128,1,2,1,4,1,2,1,8,1,2,1,4,1,2,1,16,1,2,1,4,1,2,1,8,1,2,1,4,1,2,1,32,1,2,1,4,1,2,1,8,1,2,1,4,1,2,1,16,1,2,1,4,1,2,1,8,1,2,1,4,1,2,1,64,1,2,1,4,1,2,1,8,1,2,1,4,1,2,1,16,1,2,1,4,1,2,1,8,1,2,1,4,1,2,1,32,1,2,1,4,1,2,1,8,1,2,1,4,1,2,1,16,1,2,1,4,1,2,1,8,1,2,1,4,1,2,1,2048,1,2,1,4,1,2,1,8,1,2,1,4,1,2,1,16,1,2,1,4,1,2,1,8,1,2,1,4,1,2,1,32,1,2,1,4,1,2,1,8,1,2,1,4,1,2,1,16,1,2,1,4,1,2,1,8,1,2,1,4,1,2,1,64,1,2,1,4,1,2,1,8,1,2,1,4,1,2,1,16,1,2,1,4,1,2,1,8,1,2,1,4,1,2,1,32,1,2,1,4,1,2,1,8,1,2,1,4,1,2,1,16,1,2,1,4,1,2,1,8,1,2,1,4,1,2,1,128,1,2,1,4,1,2,1,8,1,2,1,4,1,2,1,16,1,2,1,4,1,2,1,8,1,2,1,4,1,2,1,32,1,2,1,4,1,2,1,8,1,2,1,4,1,2,1,16,1,2,1,4,1,2,1,8,1,2,1,4,1,2,1,64,1,2,1,4,1,2,1,8,1,2,1,4,1,2,1,16,1,2,1,4,1,2,1,8,1,2,1,4,1,2,1,32,1,2,1,4,1,2,1,8,1,2,1,4,1,2,1,16,1,2,1,4,1,2,1,8,1,2,1,4,1,2,1,256,1,2,1,4,1,2,1,8,1,2,1,4,1,2,1,16,1,2,1,4,1,2,1,8,1,2,1,4,1,2,1,32,1,2,1,4,1,2,1,8,1,2,1,4,1,2,1,16,1,2,1,4,1,2,1,8,1,2,1,4,1,2,1,64,1,2,1,4,1,2,1,8,1,2,1,4,1,2,1,16,1,2,1,4,1,2,1,8,1,2,1,4,1,2,1,32,1,2,1,4,1,2,1,8,1,2,1,4,1,2,1,16,1,2,1,4,1,2,1,8,1,2,1,4,1,2,1,128,1,2,1,4,1,2,1,8,1,2,1,4,1,2,1,16,1,2,1,4,1,2,1,8,1,2,1,4,1,2,1,32,1,2,1,4,1,2,1,8,1,2,1,4,1,2,1,16,1,2,1,4,1,2,1,8,1,2,1,4,1,2,1,64,1,2,1,4,1,2,1,8,1,2,1,4,1,2,1,16,1,2,1,4,1,2,1,8,1,2,1,4,1,2,1,32,1,2,1,4,1,2,1,8,1,2,1,4,1,2,1,16,1,2,1,4,1,2,1,8,1,2,1,4,1,2,1,512,1,2,1,4,1,2,1,8,1,2,1,4,1,2,1,16,1,2,1,4,1,2,1,8,1,2,1,4,1,2,1,32,1,2,1,4,1,2,1,8,1,2,1,4,1,2,1,16,1,2,1,4,1,2,1,8,1,2,1,4,1,2,1,64,1,2,1,4,1,2,1,8,1,2,1,4,1,2,1,16,1,2,1,4,1,2,1,8,1,2,1,4,1,2,1,32,1,2,1,4,1,2,1,8,1,2,1,4,1,2,1,16,1,2,1,4,1,2,1,8,1,2,1,4,1,2,1,128,1,2,1,4,1,2,1,8,1,2,1,4,1,2,1,16,1,2,1,4,1,2,1,8,1,2,1,4,1,2,1,32,1,2,1,4,1,2,1,8,1,2,1,4,1,2,1,16,1,2,1,4,1,2,1,8,1,2,1,4,1,2,1,64,1,2,1,4,1,2,1,8,1,2,1,4,1,2,1,16,1,2,1,4,1,2,1,8,1,2,1,4,1,2,1,32,1,2,1,4,1,2,1,8,1,2,1,4,1,2,1,16,1,2,1,4,1,2,1,8,1,2,1,4,1,2,1,256,1,2,1,4,1,2,1,8,1,2,1,4,1,2,1,16,1,2,1,4,1,2,1,8,1,2,1,4,1,2,1,32,1,2,1,4,1,2,1,8,1,2,1,4,1,2,1,16,1,2,1,4,1,2,1,8,1,2,1,4,1,2,1,64,1,2,1,4,1,2,1,8,1,2,1,4,1,2,1,16,1,2,1,4,1,2,1,8,1,2,1,4,1,2,1,32,1,2,1,4,1,2,1,8,1,2,1,4,1,2,1,16,1,2,1,4,1,2,1,8,1,2,1,4,1,2,1,128,1,2,1,4,1,2,1,8,1,2,1,4,1,2,1,16,1,2,1,4,1,2,1,8,1,2,1,4,1,2,1,32,1,2,1,4,1,2,1,8,1,2,1,4,1,2,1,16,1,2,1,4,1,2,1,8,1,2,1,4,1,2,1,64,1,2,1,4,1,2,1,8,1,2,1,4,1,2,1,16,1,2,1,4,1,2,1,8,1,2,1,4,1,2,1,32,1,2,1,4,1,2,1,8,1,2,1,4,1,2,1,16,1,2,1,4,1,2,1,8,1,2,1,4,1,2,1,1024,1,2,1,4,1,2,1,8,1,2,1,4,1,2,1,16,1,2,1,4,1,2,1,8,1,2,1,4,1,2,1,32,1,2,1,4,1,2,1,8,1,2,1,4,1,2,1,16,1,2,1,4,1,2,1,8,1,2,1,4,1,2,1,64,1,2,1,4,1,2,1,8,1,2,1,4,1,2,1,16,1,2,1,4,1,2,1,8,1,2,1,4,1,2,1,32,1,2,1,4,1,2,1,8,1,2,1,4,1,2,1,16,1,2,1,4,1,2,1,8,1,2,1,4,1,2,1,128,1,2,1,4,1,2,1,8,1,2,1,4,1,2,1,16,1,2,1,4,1,2,1,8,1,2,1,4,1,2,1,32,1,2,1,4,1,2,1,8,1,2,1,4,1,2,1,16,1,2,1,4,1,2,1,8,1,2,1,4,1,2,1,64,1,2,1,4,1,2,1,8,1,2,1,4,1,2,1,16,1,2,1,4,1,2,1,8,1,2,1,4,1,2,1,32,1,2,1,4,1,2,1,8,1,2,1,4,1,2,1,16,1,2,1,4,1,2,1,8,1,2,1,4,1,2,1,256,1,2,1,4,1,2,1,8,1,2,1,4,1,2,1,16,1,2,1,4,1,2,1,8,1,2,1,4,1,2,1,32,1,2,1,4,1,2,1,8,1,2,1,4,1,2,1,16,1,2,1,4,1,2,1,8,1,2,1,4,1,2,1,64,1,2,1,4,1,2,1,8,1,2,1,4,1,2,1,16,1,2,1,4,1,2,1,8,1,2,1,4,1,2,1,32,1,2,1,4,1,2,1,8,1,2,1,4,1,2,1,16,1,2,1,4,1,2,1,8,1,2,1,4,1,2,1,128,1,2,1,4,1,2,1,8,1,2,1,4,1,2,1,16,1,2,1,4,1,2,1,8,1,2,1,4,1,2,1,32,1,2,1,4,1,2,1,8,1,2,1,4,1,2,1,16,1,2,1,4,1,2,1,8,1,2,1,4,1,2,1,64,1,2,1,4,1,2,1,8,1,2,1,4,1,2,1,16,1,2,1,4,1,2,1,8,1,2,1,4,1,2,1,32,1,2,1,4,1,2,1,8,1,2,1,4,1,2,1,16,1,2,1,4,1,2,1,8,1,2,1,4,1,2,1,512,1,2,1,4,1,2,1,8,1,2,1,4,1,2,1,16,1,2,1,4,1,2,1,8,1,2,1,4,1,2,1,32,1,2,1,4,1,2,1,8,1,2,1,4,1,2,1,16,1,2,1,4,1,2,1,8,1,2,1,4,1,2,1,64,1,2,1,4,1,2,1,8,1,2,1,4,1,2,1,16,1,2,1,4,1,2,1,8,1,2,1,4,1,2,1,32,1,2,1,4,1,2,1,8,1,2,1,4,1,2,1,16,1,2,1,4,1,2,1,8,1,2,1,4,1,2,1,128,1,2,1,4,1,2,1,8,1,2,1,4,1,2,1,16,1,2,1,4,1,2,1,8,1,2,1,4,1,2,1,32,1,2,1,4,1,2,1,8,1,2,1,4,1,2,1,16,1,2,1,4,1,2,1,8,1,2,1,4,1,2,1,64,1,2,1,4,1,2,1,8,1,2,1,4,1,2,1,16,1,2,1,4,1,2,1,8,1,2,1,4,1,2,1,32,1,2,1,4,1,2,1,8,1,2,1,4,1,2,1,16,1,2,1,4,1,2,1,8,1,2,1,4,1,2,1,256,1,2,1,4,1,2,1,8,1,2,1,4,1,2,1,16,1,2,1,4,1,2,1,8,1,2,1,4,1,2,1,32,1,2,1,4,1,2,1,8,1,2,1,4,1,2,1,16,1,2,1,4,1,2,1,8,1,2,1,4,1,2,1,64,1,2,1,4,1,2,1,8,1,2,1,4,1,2,1,16,1,2,1,4,1,2,1,8,1,2,1,4,1,2,1,32,1,2,1,4,1,2,1,8,1,2,1,4,1,2,1,16,1,2,1,4,1,2,1,8,1,2,1,4,1,2,1,128,1,2,1,4,1,2,1,8,1,2,1,4,1,2,1,16,1,2,1,4,1,2,1,8,1,2,1,4,1,2,1,32,1,2,1,4,1,2,1,8,1,2,1,4,1,2,1,16,1,2,1,4,1,2,1,8,1,2,1,4,1,2,1,64,1,2,1,4,1,2,1,8,1,2,1,4,1,2,1,16,1,2,1,4,1,2,1,8,1,2,1,4,1,2,1,32,1,2,1,4,1,2,1,8,1,2,1,4,1,2,1,16,1,2,1,4,1,2,1,8,1,2,1,4,1,2,1}
+
+#define ISFLUSH {0,0,0,-1,-1,13,13,13,0,0,-1,-1,-1,13,13,-1,0,-1,-1,-1,-1,13,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,26,26,26,-1,-1,-1,-1,-1,26,26,-1,-1,-1,-1,-1,-1,26,0,0,-1,-1,-1,13,13,-1,0,-1,-1,-1,-1,13,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,26,26,-1,-1,-1,-1,-1,-1,26,-1,-1,-1,-1,-1,-1,-1,-1,0,-1,-1,-1,-1,13,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,26,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,39,39,39,-1,-1,-1,-1,-1,39,39,-1,-1,-1,-1,-1,-1,39,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,39,39,-1,-1,-1,-1,-1,-1,39,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,39}
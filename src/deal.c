@@ -1,47 +1,129 @@
-#include <stdio.h>
-#include <stdint.h>
-#include <stdlib.h>
+#include "poker_heavy.h"
+
 #include <time.h>
-#include <stdbool.h>
 
-#define FAIL -1
-#define SUCCESS 1
+//each caller deals from its own deck, so deals in different threads
+//don't share any state
+//
+//Decks draw from xoshiro256** seeded through splitmix64.  jumpdeck
+//moves a deck's generator 2^128 steps along, so decks seeded alike
+//and jumped different numbers of times deal independent streams.
+
+
+static uint64_t splitmix64(uint64_t *x){
+    uint64_t z = (*x += 0x9e3779b97f4a7c15ull);
+    z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ull;
+    z = (z ^ (z >> 27)) * 0x94d049bb133111ebull;
+    return z ^ (z >> 31);
+}
+
+
+static inline uint64_t rotl(uint64_t x, int k){
+    return (x << k) | (x >> (64 - k));
+}
+
+
+static inline uint64_t next(deck *d){
+    uint64_t *s = d->state;
+    uint64_t result = rotl(s[1] * 5, 7) * 9;
+    uint64_t t = s[1] << 17;
+
+    s[2] ^= s[0];
+    s[3] ^= s[1];
+    s[1] ^= s[2];
+    s[0] ^= s[3];
+    s[2] ^= t;
+    s[3] = rotl(s[3], 45);
+    return result;
+}
 
 
-static uint32_t Deck[52];
-static int DeckSize = 0;
-static char randstate[256];
+//a uniform integer in [0, range) by Lemire's multiply and reject
+static inline uint32_t bounded(deck *d, uint32_t range){
+    uint64_t m = (next(d) >> 32) * range;
+    uint32_t threshold;
+
+    if ((uint32_t) m < range){
+        threshold = -range % range;
+        while ((uint32_t) m < threshold)
+            m = (next(d) >> 32) * range;
+    }
+    return (uint32_t) (m >> 32);
+}
 
 
-int initdeck(bool dead[52]){
+//a seed for callers that don't give one
+//decks made in the same second still get different seeds
+uint64_t random_seed(void){
+    static uint64_t ncalls = 0;
+    struct timespec t;
+    uint64_t x;
+
+    clock_gettime(CLOCK_REALTIME, &t);
+    x = (uint64_t) t.tv_sec * 1000000000u + (uint64_t) t.tv_nsec;
+    x ^= __sync_fetch_and_add(&ncalls, 1) * 0x9e3779b97f4a7c15ull;
+    return splitmix64(&x);
+}
+
+
+int initdeck(deck *d, bool dead[52], uint64_t seed){
     //dead is true at positions of cards that are dead
     uint32_t card;
     int i = 0;
     for (card = 0; card < 52; card++){
         if (!dead || !dead[card])
-            Deck[i++] = card;
+            d->cards[i++] = card;
     }
-    DeckSize = i;
-    if (!initstate((unsigned int)time(NULL), randstate, 256))
-        return FAIL;
+    d->size = i;
+    for (i = 0; i < 4; i++)
+        d->state[i] = splitmix64(&seed);
     return SUCCESS;
 }
 
 
-int deal(uint32_t cards[], int n){
+//advance the generator 2^128 draws
+void jumpdeck(deck *d){
+    static const uint64_t jump[] = {
+        0x180ec6d33cfd0abaull, 0xd5a61266f0c9392cull,
+        0xa9582618e03fc9aaull, 0x39abdc4529b1661cull
+    };
+    uint64_t s[4] = {0, 0, 0, 0};
+    int i, b, j;
+
+    for (i = 0; i < 4; i++){
+        for (b = 0; b < 64; b++){
+            if (jump[i] & (1ull << b)){
+                for (j = 0; j < 4; j++)
+                    s[j] ^= d->state[j];
+            }
+            next(d);
+        }
+    }
+    for (j = 0; j < 4; j++)
+        d->state[j] = s[j];
+}
+
+
+//a uniform double in [0, 1) from the deck's generator
+double random_unit(deck *d){
+    return (next(d) >> 11) * 0x1.0p-53;
+}
+
+
+int deal(deck *d, uint32_t cards[], int n){
     int i, r;
-    int decksize = DeckSize;
+    int decksize = d->size;
     int last_index = decksize - 1;
-    uint32_t *deck = Deck;
+    uint32_t *cardsleft = d->cards;
 
     if (decksize < n)
         return FAIL;
 
     for (i = 0; i < n; i++, last_index--){
-         r = random() * (decksize --) / RAND_MAX;
-         cards[i] = deck[r];
-         deck[r] = deck[last_index];
-         deck[last_index] = cards[i];
+         r = (int) bounded(d, (uint32_t) (decksize --));
+         cards[i] = cardsleft[r];
+         cardsleft[r] = cardsleft[last_index];
+         cardsleft[last_index] = cards[i];
     }
     return SUCCESS;
 }
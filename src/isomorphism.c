@@ -0,0 +1,409 @@
+// Copyright 2013 Allen Boyd Cunningham
+
+// This file is part of pokyr.
+
+//     pokyr is free software: you can redistribute it and/or modify
+//     it under the terms of the GNU General Public License as published by
+//     the Free Software Foundation, either version 3 of the License, or
+//     (at your option) any later version.
+//     pokyr is distributed in the hope that it will be useful,
+//     but WITHOUT ANY WARRANTY; without even the implied warranty of
+//     MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//     GNU General Public License for more details.
+
+//     You should have received a copy of the GNU General Public License
+//     along with pokyr.  If not, see <http://www.gnu.org/licenses/>.
+
+
+#include "poker_heavy.h"
+
+#include <pthread.h>
+#include <string.h>
+
+//iso_index numbers the hole cards and board of a street up to suit
+//isomorphism, after Waugh's "A Fast and Optimal Hand Isomorphism
+//Algorithm", with two rounds: the hole cards and the board.  The order
+//of cards within a round doesn't matter.
+//
+//Each suit holds a set of ranks from every round.  Its shape is how
+//many cards it has in each round, and its index numbers its rank sets
+//among those of its shape: each round's set is numbered among the
+//ranks the suit's earlier rounds left.  A hand's configuration is the
+//shapes of its suits, sorted, and the hands of a configuration are
+//numbered by the multiset of indexes each group of suits with the same
+//shape holds, since suits of one shape can be swapped.  Configurations
+//take consecutive ranges of the indexes.
+
+#define MAX_CONFIGS 64
+#define MAX_ROUNDS 2
+#define NUM_STREETS 4
+
+typedef struct{
+    int nrounds;
+    int cards[MAX_ROUNDS];          //in each round
+    int nconfigs;
+    uint32_t configs[MAX_CONFIGS];  //4 shapes of a byte each, largest first
+    uint64_t offsets[MAX_CONFIGS + 1];
+}iso_round;
+
+static iso_round Rounds[NUM_STREETS];
+static uint32_t Choose[14][14];
+static pthread_once_t Rounds_Once = PTHREAD_ONCE_INIT;
+
+//a shape keeps 3 bits a round, first round highest
+#define SHAPE_COUNT(shape, r, nrounds) (((shape) >> (3 * ((nrounds) - 1 - (r)))) & 7)
+
+
+//n choose k for the multisets of suit indexes, which can be big
+static unsigned __int128 choose(uint64_t n, int k){
+    unsigned __int128 result = 1;
+    int i;
+
+    if (n < (uint64_t) k)
+        return 0;
+    for (i = 0; i < k; i++)
+        result = result * (n - i) / (i + 1);
+    return result;
+}
+
+
+//the rank sets a suit of shape can hold over nrounds
+static uint64_t shape_size(uint32_t shape, int nrounds){
+    uint64_t size = 1;
+    int r, m, left = 13;
+
+    for (r = 0; r < nrounds; r++){
+        m = SHAPE_COUNT(shape, r, nrounds);
+        size *= Choose[left][m];
+        left -= m;
+    }
+    return size;
+}
+
+
+//the hands of a configuration: for each run of k suits of one shape,
+//the multisets of k of that shape's indexes
+static uint64_t config_size(uint32_t config, int nrounds){
+    uint64_t size = 1;
+    int i, j;
+    uint32_t shape;
+
+    for (i = 0; i < 4; i = j){
+        shape = (config >> (8 * (3 - i))) & 0xff;
+        for (j = i; j < 4 && ((config >> (8 * (3 - j))) & 0xff) == shape; j++);
+        size *= (uint64_t) choose(shape_size(shape, nrounds) + (j - i) - 1, j - i);
+    }
+    return size;
+}
+
+
+static int compare_configs(const void *a, const void *b){
+    uint32_t x = *(const uint32_t *) a, y = *(const uint32_t *) b;
+    return (x > y) - (x < y);
+}
+
+
+//the configuration of 4 shapes
+static uint32_t pack_config(uint32_t shapes[4]){
+    uint32_t shape;
+    int i, j;
+
+    for (i = 1; i < 4; i++){
+        shape = shapes[i];
+        for (j = i; j > 0 && shapes[j - 1] < shape; j--)
+            shapes[j] = shapes[j - 1];
+        shapes[j] = shape;
+    }
+    return shapes[0] << 24 | shapes[1] << 16 | shapes[2] << 8 | shapes[3];
+}
+
+
+//every way the cards of the nleft rounds from cards on can go to the suits
+static void add_configs(iso_round *round, const int *cards, int nleft, uint32_t shapes[4]){
+    uint32_t next[4], sorted[4], config;
+    int a, b, c, n;
+
+    if (nleft == 0){
+        memcpy(sorted, shapes, sizeof(sorted));
+        config = pack_config(sorted);
+        for (a = 0; a < round->nconfigs && round->configs[a] != config; a++);
+        if (a == round->nconfigs)
+            round->configs[round->nconfigs++] = config;
+        return;
+    }
+    n = cards[0];
+    for (a = 0; a <= n; a++){
+        for (b = 0; a + b <= n; b++){
+            for (c = 0; a + b + c <= n; c++){
+                next[0] = shapes[0] << 3 | a;
+                next[1] = shapes[1] << 3 | b;
+                next[2] = shapes[2] << 3 | c;
+                next[3] = shapes[3] << 3 | (n - a - b - c);
+                add_configs(round, cards + 1, nleft - 1, next);
+            }
+        }
+    }
+}
+
+
+static void build_rounds(void){
+    uint32_t shapes[4] = {0, 0, 0, 0};
+    iso_round *round;
+    int n, k, i;
+
+    for (n = 0; n < 14; n++){
+        for (k = 0; k < 14; k++)
+            Choose[n][k] = (k == 0) ? 1 : (n == 0) ? 0 : Choose[n - 1][k - 1] + Choose[n - 1][k];
+    }
+    //preflop, then 3, 4 and 5 board cards
+    for (n = 0; n < NUM_STREETS; n++){
+        round = &Rounds[n];
+        round->nrounds = (n == 0) ? 1 : 2;
+        round->cards[0] = 2;
+        round->cards[1] = (n == 0) ? 0 : n + 2;
+        add_configs(round, round->cards, round->nrounds, shapes);
+        qsort(round->configs, round->nconfigs, sizeof(uint32_t), compare_configs);
+        for (i = 0, round->offsets[0] = 0; i < round->nconfigs; i++)
+            round->offsets[i + 1] = round->offsets[i] + config_size(round->configs[i], round->nrounds);
+    }
+}
+
+
+static const iso_round *get_round(int nboard){
+    if (nboard != 0 && (nboard < 3 || nboard > 5))
+        return NULL;
+    pthread_once(&Rounds_Once, build_rounds);
+    return &Rounds[(nboard == 0) ? 0 : nboard - 2];
+}
+
+
+//the number of hole card and board combinations of nboard board cards
+//(0, 3, 4 or 5) up to suit isomorphism, or 0 for other streets
+uint64_t iso_size(int nboard){
+    const iso_round *round = get_round(nboard);
+
+    return round ? round->offsets[round->nconfigs] : 0;
+}
+
+
+//the index of the set bits of ranks among the sets of their size
+static uint32_t set_index(uint32_t ranks){
+    uint32_t index = 0;
+    int j;
+
+    for (j = 1; ranks; j++, ranks &= ranks - 1)
+        index += Choose[__builtin_ctz(ranks)][j];
+    return index;
+}
+
+
+//the set of m ranks with index
+static uint32_t index_set(uint32_t index, int m){
+    uint32_t ranks = 0;
+    int j, p;
+
+    for (j = m; j > 0; j--){
+        for (p = j - 1; Choose[p + 1][j] <= index; p++);
+        index -= Choose[p][j];
+        ranks |= 1u << p;
+    }
+    return ranks;
+}
+
+
+//ranks numbered among the ranks not in used, and back
+static uint32_t squeeze(uint32_t ranks, uint32_t used){
+    uint32_t out = 0;
+    int p;
+
+    for (; ranks; ranks &= ranks - 1){
+        p = __builtin_ctz(ranks);
+        out |= 1u << (p - __builtin_popcount(used & ((1u << p) - 1)));
+    }
+    return out;
+}
+
+static uint32_t spread(uint32_t ranks, uint32_t used){
+    uint32_t out = 0, free = ~used & 0x1fff;
+    int p, i;
+
+    for (i = 0; free; i++, free &= free - 1){
+        p = __builtin_ctz(free);
+        if (ranks >> i & 1)
+            out |= 1u << p;
+    }
+    return out;
+}
+
+
+//each group of suits with one shape holds a multiset of their indexes,
+//numbered with each index offset by its place in sorted order
+static uint64_t multiset_index(const uint64_t indexes[], int k){
+    unsigned __int128 index = 0;
+    int j;
+
+    for (j = 0; j < k; j++)
+        index += choose(indexes[j] + j, j + 1);
+    return (uint64_t) index;
+}
+
+static void index_multiset(uint64_t index, int k, uint64_t size, uint64_t indexes[]){
+    uint64_t lo, hi, mid;
+    int j;
+
+    for (j = k; j > 0; j--){
+        //the largest b with choose(b, j) <= index
+        lo = j - 1;
+        hi = size + j - 1;
+        while (hi - lo > 1){
+            mid = lo + (hi - lo) / 2;
+            if (choose(mid, j) <= index)
+                lo = mid;
+            else
+                hi = mid;
+        }
+        index -= (uint64_t) choose(lo, j);
+        indexes[j - 1] = lo - (j - 1);
+    }
+}
+
+
+//the index of 2 hole cards followed by nboard board cards
+//Return ISO_FAIL for bad or duplicate cards or streets
+uint64_t iso_index(const uint32_t cards[], int nboard){
+    const iso_round *round = get_round(nboard);
+    uint32_t ranks[4][MAX_ROUNDS], shapes[4], config, used, tmp;
+    uint64_t indexes[4], index, size, mask = 0, swap;
+    int nrounds, r, s, i, j, k, m, c = 0, found;
+
+    if (!round)
+        return ISO_FAIL;
+    nrounds = round->nrounds;
+    memset(ranks, 0, sizeof(ranks));
+    for (r = 0; r < nrounds; r++){
+        for (i = 0; i < round->cards[r]; i++, c++){
+            if (cards[c] > 51 || (mask & CARD_BIT(cards[c])))
+                return ISO_FAIL;
+            mask |= CARD_BIT(cards[c]);
+            ranks[cards[c] & 3][r] |= 1u << (cards[c] >> 2);
+        }
+    }
+
+    for (s = 0; s < 4; s++){
+        shapes[s] = 0;
+        indexes[s] = 0;
+        for (r = 0, used = 0, size = 1; r < nrounds; r++){
+            m = __builtin_popcount(ranks[s][r]);
+            shapes[s] = shapes[s] << 3 | m;
+            indexes[s] += set_index(squeeze(ranks[s][r], used)) * size;
+            size *= Choose[13 - __builtin_popcount(used)][m];
+            used |= ranks[s][r];
+        }
+    }
+    //suits by shape, largest first, then by index
+    for (i = 1; i < 4; i++){
+        for (j = i; j > 0 && (shapes[j - 1] < shapes[j] ||
+                              (shapes[j - 1] == shapes[j] && indexes[j - 1] > indexes[j])); j--){
+            tmp = shapes[j];
+            shapes[j] = shapes[j - 1];
+            shapes[j - 1] = tmp;
+            swap = indexes[j];
+            indexes[j] = indexes[j - 1];
+            indexes[j - 1] = swap;
+        }
+    }
+    config = shapes[0] << 24 | shapes[1] << 16 | shapes[2] << 8 | shapes[3];
+    for (found = 0, j = round->nconfigs; found < j;){
+        k = (found + j) / 2;
+        if (round->configs[k] < config)
+            found = k + 1;
+        else
+            j = k;
+    }
+
+    for (i = 0, index = 0; i < 4; i = j){
+        for (j = i; j < 4 && shapes[j] == shapes[i]; j++);
+        k = j - i;
+        size = (uint64_t) choose(shape_size(shapes[i], nrounds) + k - 1, k);
+        index = index * size + multiset_index(indexes + i, k);
+    }
+    return round->offsets[found] + index;
+}
+
+
+//fill cards with 2 hole cards and nboard board cards, each round in
+//order, of the hands with index
+//Return FAIL if the index is out of range for the street
+int iso_unindex(uint64_t index, int nboard, uint32_t cards[]){
+    const iso_round *round = get_round(nboard);
+    uint64_t indexes[4], sizes[4], si, size;
+    uint32_t shapes[4], config, used, set;
+    int nrounds, lo, hi, mid, i, j, r, s, m, c = 0, starts[4], ngroups = 0;
+
+    if (!round || index >= round->offsets[round->nconfigs])
+        return FAIL;
+    nrounds = round->nrounds;
+    for (lo = 0, hi = round->nconfigs; hi - lo > 1;){
+        mid = (lo + hi) / 2;
+        if (round->offsets[mid] <= index)
+            lo = mid;
+        else
+            hi = mid;
+    }
+    config = round->configs[lo];
+    index -= round->offsets[lo];
+    for (s = 0; s < 4; s++)
+        shapes[s] = (config >> (8 * (3 - s))) & 0xff;
+
+    for (i = 0; i < 4; i = j){
+        for (j = i; j < 4 && shapes[j] == shapes[i]; j++);
+        starts[ngroups] = i;
+        sizes[ngroups++] = shape_size(shapes[i], nrounds);
+    }
+    //the groups were added up first to last
+    for (i = ngroups; i--;){
+        j = (i + 1 < ngroups) ? starts[i + 1] : 4;
+        size = (uint64_t) choose(sizes[i] + (j - starts[i]) - 1, j - starts[i]);
+        index_multiset(index % size, j - starts[i], sizes[i], indexes + starts[i]);
+        index /= size;
+    }
+
+    //suit s of the configuration gets suit number s
+    for (r = 0; r < nrounds; r++){
+        for (s = 0; s < 4; s++){
+            si = indexes[s];
+            for (i = 0, used = 0; i <= r; i++){
+                m = SHAPE_COUNT(shapes[s], i, nrounds);
+                size = Choose[13 - __builtin_popcount(used)][m];
+                set = spread(index_set((uint32_t) (si % size), m), used);
+                si /= size;
+                used |= set;
+            }
+            for (; set; set &= set - 1)
+                cards[c++] = (uint32_t) __builtin_ctz(set) << 2 | s;
+        }
+        //each round's cards in order
+        for (i = c - round->cards[r] + 1; i < c; i++){
+            for (j = i; j > c - round->cards[r] && cards[j - 1] > cards[j]; j--){
+                set = cards[j];
+                cards[j] = cards[j - 1];
+                cards[j - 1] = set;
+            }
+        }
+    }
+    return SUCCESS;
+}
+
+
+//index n hands of 2 hole cards and nboard board cards each
+//Return FAIL, with the hands before the bad one indexed, for bad or
+//duplicate cards
+int iso_index_batch(const uint32_t *cards, int n, int nboard, uint64_t *out){
+    int i, width = 2 + nboard;
+
+    for (i = 0; i < n; i++){
+        if ( (out[i] = iso_index(cards + i * width, nboard)) == ISO_FAIL )
+            return FAIL;
+    }
+    return SUCCESS;
+}
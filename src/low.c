@@ -0,0 +1,145 @@
+// Copyright 2013 Allen Boyd Cunningham
+
+// This file is part of pokyr.
+
+//     pokyr is free software: you can redistribute it and/or modify
+//     it under the terms of the GNU General Public License as published by
+//     the Free Software Foundation, either version 3 of the License, or
+//     (at your option) any later version.
+//     pokyr is distributed in the hope that it will be useful,
+//     but WITHOUT ANY WARRANTY; without even the implied warranty of
+//     MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//     GNU General Public License for more details.
+
+//     You should have received a copy of the GNU General Public License
+//     along with pokyr.  If not, see <http://www.gnu.org/licenses/>.
+
+
+#include "poker_heavy.h"
+
+#include <pthread.h>
+
+//Ace to five lows, eight or better: the best 5 different ranks from ace
+//up to eight, straights and flushes not counting.  Suits never matter,
+//so a low is looked up by the specialK sum of the ranks alone, the key
+//Rank_Table uses, through a perfect hash per number of cards (see
+//compact_table.c).
+//
+//low_rank is 0 for no qualifying low and otherwise from 1 for 8-7-6-5-4
+//up to NUM_LOWS for 5-4-3-2-A, so higher is better as for highs.
+
+#define MIN_LOW_CARDS 5
+#define MAX_LOW_CARDS 7
+#define LOW_TABLES (MAX_LOW_CARDS - MIN_LOW_CARDS + 1)
+
+//DECK = [r | (s << SUITSHIFT) for r in SPECIALKS for s in (0, 1, 8, 57)]
+static const uint32_t Deck[52] = DECK;
+
+//by number of cards less 5, looked up with LOW_LOOKUP
+uint16_t Low_Displace[LOW_TABLES][COMPACT_BUCKETS];
+uint16_t Low_Compact[LOW_TABLES][COMPACT_SLOTS];
+
+static bool Low_Ready = false;
+static pthread_once_t Low_Once = PTHREAD_ONCE_INIT;
+
+
+//the low of a mask of low ranks, A in bit 0 up to 8 in bit 7
+static uint16_t mask_low(uint32_t mask){
+    uint32_t other;
+    uint16_t low = 1;
+
+    while (__builtin_popcount(mask) > 5)
+        mask &= ~(1u << (31 - __builtin_clz(mask)));
+    if (__builtin_popcount(mask) < 5)
+        return 0;
+    //a lower mask is a better low
+    for (other = mask + 1; other < 0x100; other++)
+        low += __builtin_popcount(other) == 5;
+    return low;
+}
+
+
+//append the specialK sum and low of every rank combination of left more
+//cards to keys and lows, the ranks from rank up, count of rank so far
+//and lowmask the low ranks so far
+static int walk_lows(uint32_t *keys, uint16_t *lows, int n, int rank, int left, uint32_t sum,
+                     uint32_t lowmask, int count){
+    static const uint32_t specialks[13] = SPECIALKS;
+
+    if (!left){
+        keys[n] = sum;
+        lows[n] = mask_low(lowmask);
+        return n + 1;
+    }
+    for (; rank < 13; rank++, count = 0){
+        if (count == 4)
+            continue;
+        //A is rank 0, and 8 down to 2 are ranks 6 to 12
+        n = walk_lows(keys, lows, n, rank, left - 1, sum + specialks[rank],
+                      (rank == 0 || rank >= 6) ? lowmask | 1u << (rank ? 13 - rank : 0) : lowmask,
+                      count + 1);
+    }
+    return n;
+}
+
+
+static void build_lows(void){
+    uint32_t *keys = (uint32_t *) malloc(NUM_RANK_COMBOS * sizeof(uint32_t));
+    uint16_t *lows = (uint16_t *) malloc(NUM_RANK_COMBOS * sizeof(uint16_t));
+    int n, nkeys;
+
+    if (!keys || !lows)
+        goto done;
+    for (n = MIN_LOW_CARDS; n <= MAX_LOW_CARDS; n++){
+        nkeys = walk_lows(keys, lows, 0, 0, n, 0, 0, 0);
+        if (build_compact_hash(keys, lows, nkeys, Low_Displace[n - MIN_LOW_CARDS],
+                               Low_Compact[n - MIN_LOW_CARDS]) == FAIL)
+            goto done;
+    }
+    Low_Ready = true;
+
+done:
+    free(keys);
+    free(lows);
+}
+
+
+//build the tables the first time
+//Return false if there wasn't memory for them
+bool init_lows(void){
+    pthread_once(&Low_Once, build_lows);
+    return Low_Ready;
+}
+
+
+//the low of n (5 to 7) cards, or FAIL for bad or duplicate cards
+int low_rank(const uint32_t cards[], int n){
+    uint64_t mask = 0;
+    uint32_t key = 0;
+    int i;
+
+    if (n < MIN_LOW_CARDS || n > MAX_LOW_CARDS || !init_lows())
+        return FAIL;
+    for (i = 0; i < n; i++){
+        if (cards[i] > 51 || (mask & CARD_BIT(cards[i])))
+            return FAIL;
+        mask |= CARD_BIT(cards[i]);
+        key += Deck[cards[i]];
+    }
+    return LOW_LOOKUP(n, key & RANKMASK);
+}
+
+
+//the lows of n hands of ncards cards each into out
+//Return FAIL, with the hands before the bad one done, for bad or
+//duplicate cards
+int low_rank_batch(const uint32_t *hands, int n, int ncards, uint16_t *out){
+    int i, low;
+
+    for (i = 0; i < n; i++){
+        if ( (low = low_rank(hands + i * ncards, ncards)) == FAIL )
+            return FAIL;
+        out[i] = (uint16_t) low;
+    }
+    return SUCCESS;
+}
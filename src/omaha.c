@@ -0,0 +1,410 @@
+// Copyright 2013 Allen Boyd Cunningham
+
+// This file is part of pokyr.
+
+//     pokyr is free software: you can redistribute it and/or modify
+//     it under the terms of the GNU General Public License as published by
+//     the Free Software Foundation, either version 3 of the License, or
+//     (at your option) any later version.
+//     pokyr is distributed in the hope that it will be useful,
+//     but WITHOUT ANY WARRANTY; without even the implied warranty of
+//     MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//     GNU General Public License for more details.
+
+//     You should have received a copy of the GNU General Public License
+//     along with pokyr.  If not, see <http://www.gnu.org/licenses/>.
+
+
+#include "poker_heavy.h"
+
+#include <string.h>
+
+//An Omaha hand plays exactly 2 of its 4 or 5 hole cards with exactly 3
+//of the board, so it is the best of up to 10 x 10 five card hands.
+//
+//The five card hands are ranked on the best5_rank scale from the
+//tables of best5.c.  The key sums of the hole card pairs are made once
+//per hand and those of the board triples once per board, so each of
+//the five card hands is one add and one lookup, and only a suited
+//triple with a pair of its suit is looked up as a flush.
+
+//DECK = [r | (s << SUITSHIFT) for r in SPECIALKS for s in (0, 1, 8, 57)]
+static const uint32_t Deck[52] = DECK;
+
+extern uint16_t Five_Displace[COMPACT_BUCKETS];
+extern uint16_t Five_Compact[COMPACT_SLOTS];
+extern uint16_t Best_Flush[CARD_MASK + 1];
+extern uint16_t Low_Displace[3][COMPACT_BUCKETS];
+extern uint16_t Low_Compact[3][COMPACT_SLOTS];
+
+#define FIVE_LOOKUP(key) Five_Compact[COMPACT_SLOT(key) ^ Five_Displace[COMPACT_BUCKET(key)]]
+
+//the rank bit of card c in the suit planes of Bits
+#define RANK_BIT(c) (1u << (12 - ((c) >> 2)))
+
+
+//the key sums, rank bits and suit (or -1 when mixed) of every 2 or 3
+//card part of some cards
+typedef struct{
+    int n;
+    uint32_t keys[10];
+    uint32_t bits[10];
+    int suits[10];
+}parts;
+
+
+static void hole_pairs(const uint32_t hole[], int nhole, parts *p){
+    int i, j;
+
+    p->n = 0;
+    for (i = 0; i < nhole; i++){
+        for (j = i + 1; j < nhole; j++, p->n++){
+            p->keys[p->n] = Deck[hole[i]] + Deck[hole[j]];
+            p->bits[p->n] = RANK_BIT(hole[i]) | RANK_BIT(hole[j]);
+            p->suits[p->n] = ((hole[i] & 3) == (hole[j] & 3)) ? (int) (hole[i] & 3) : -1;
+        }
+    }
+}
+
+
+//the triples reuse the sums of the pairs below them
+static void board_triples(const uint32_t board[], int nboard, parts *p){
+    uint32_t pairkey, pairbits;
+    int i, j, k, pairsuit;
+
+    p->n = 0;
+    for (i = 0; i < nboard; i++){
+        for (j = i + 1; j < nboard; j++){
+            pairkey = Deck[board[i]] + Deck[board[j]];
+            pairbits = RANK_BIT(board[i]) | RANK_BIT(board[j]);
+            pairsuit = ((board[i] & 3) == (board[j] & 3)) ? (int) (board[i] & 3) : -1;
+            for (k = j + 1; k < nboard; k++, p->n++){
+                p->keys[p->n] = pairkey + Deck[board[k]];
+                p->bits[p->n] = pairbits | RANK_BIT(board[k]);
+                p->suits[p->n] = (pairsuit == (int) (board[k] & 3)) ? pairsuit : -1;
+            }
+        }
+    }
+}
+
+
+static uint16_t best_rank(const parts *pairs, const parts *triples){
+    uint16_t rank, best = 0;
+    int t, p;
+
+    for (t = 0; t < triples->n; t++){
+        for (p = 0; p < pairs->n; p++){
+            if (triples->suits[t] != -1 && triples->suits[t] == pairs->suits[p])
+                rank = Best_Flush[triples->bits[t] | pairs->bits[p]];
+            else
+                rank = FIVE_LOOKUP((triples->keys[t] + pairs->keys[p]) & RANKMASK);
+            if (rank > best)
+                best = rank;
+        }
+    }
+    return best;
+}
+
+
+//the best high and low together, each five card hand looked up in both
+static void best_hilo(const parts *pairs, const parts *triples, int *hi, int *lo){
+    uint32_t key;
+    uint16_t rank, low, best = 0, bestlow = 0;
+    int t, p;
+
+    for (t = 0; t < triples->n; t++){
+        for (p = 0; p < pairs->n; p++){
+            key = (triples->keys[t] + pairs->keys[p]) & RANKMASK;
+            if (triples->suits[t] != -1 && triples->suits[t] == pairs->suits[p])
+                rank = Best_Flush[triples->bits[t] | pairs->bits[p]];
+            else
+                rank = FIVE_LOOKUP(key);
+            low = LOW_LOOKUP(5, key);
+            if (rank > best)
+                best = rank;
+            if (low > bestlow)
+                bestlow = low;
+        }
+    }
+    *hi = best;
+    *lo = bestlow;
+}
+
+
+//the best5_rank of an Omaha hand of nhole (4 or 5) hole cards on a
+//board of 3 to 5 cards
+//Return FAIL for bad or duplicate cards
+int omaha_rank(const uint32_t hole[], int nhole, const uint32_t board[], int nboard){
+    parts pairs, triples;
+    bool dead[52];
+
+    if (nhole < 4 || nhole > MAX_HOLE || nboard < 3 || nboard > 5 || !init_best5())
+        return FAIL;
+    if (set_dead((void *) hole, nhole, (void *) board, nboard, dead) == FAIL)
+        return FAIL;
+    hole_pairs(hole, nhole, &pairs);
+    board_triples(board, nboard, &triples);
+    return best_rank(&pairs, &triples);
+}
+
+
+//the low_rank of an Omaha hand, 2 hole cards and 3 board cards, or 0
+//when it has no low
+//Return FAIL for bad or duplicate cards
+int omaha_low(const uint32_t hole[], int nhole, const uint32_t board[], int nboard){
+    parts pairs, triples;
+    bool dead[52];
+    int hi, lo;
+
+    if (nhole < 4 || nhole > MAX_HOLE || nboard < 3 || nboard > 5 || !init_best5() || !init_lows())
+        return FAIL;
+    if (set_dead((void *) hole, nhole, (void *) board, nboard, dead) == FAIL)
+        return FAIL;
+    hole_pairs(hole, nhole, &pairs);
+    board_triples(board, nboard, &triples);
+    best_hilo(&pairs, &triples, &hi, &lo);
+    return lo;
+}
+
+
+//add hand i with rank to the n winners so far if it ties or beats them
+#define ADD_WINNER(winners, n, best, rank, i) \
+    if ((rank) > (best)){ \
+        (best) = (rank); \
+        (n) = 0; \
+    } \
+    if ((rank) == (best)) \
+        (winners)[(n)++] = (i);
+
+
+//fill winners with the indexes of the nhands hands of nhole cards each
+//in holes that tie for the best on a 5 card board
+//Return the number of winners, or FAIL if the tables can't be built
+int multi_omaha(const uint32_t *holes, int nhole, int nhands, const uint32_t board[5], int winners[]){
+    parts pairs, triples;
+    int i, rank, best = -1, nwinners = 0;
+
+    if (!init_best5())
+        return FAIL;
+    board_triples(board, 5, &triples);
+    for (i = 0; i < nhands; i++){
+        hole_pairs(holes + i * nhole, nhole, &pairs);
+        rank = best_rank(&pairs, &triples);
+        ADD_WINNER(winners, nwinners, best, rank, i)
+    }
+    return nwinners;
+}
+
+
+//the same for hi/lo, with the winners of the low half in lowinners and
+//their number in nlow, which is 0 when no hand has a low
+//Return the number of high winners, or FAIL if the tables can't be built
+int multi_omaha_hilo(const uint32_t *holes, int nhole, int nhands, const uint32_t board[5],
+                     int hiwinners[], int lowinners[], int *nlow){
+    parts pairs, triples;
+    int i, hi, lo, best = -1, bestlow = 1, nhi = 0;
+
+    if (!init_best5() || !init_lows())
+        return FAIL;
+    *nlow = 0;
+    board_triples(board, 5, &triples);
+    for (i = 0; i < nhands; i++){
+        hole_pairs(holes + i * nhole, nhole, &pairs);
+        best_hilo(&pairs, &triples, &hi, &lo);
+        ADD_WINNER(hiwinners, nhi, best, hi, i)
+        ADD_WINNER(lowinners, *nlow, bestlow, lo, i)
+    }
+    return nhi;
+}
+
+
+//Enumeration splits the runouts by their highest live card, like
+//full_enumeration, and scores them in SHARE_UNITs so the results don't
+//depend on the threads.  Hi/lo scores each half of the pot in
+//SHARE_UNITs and the pot in half units, from one ranking of each hand.
+
+//what every worker reads
+typedef struct{
+    int nhands;
+    bool split;
+    parts pairs[MAX_HANDS];
+    uint32_t board[5];
+    int nboard;
+    int nlive;
+    uint32_t live[52];
+}omaha_job;
+
+//what each worker writes
+typedef struct{
+    uint64_t shares[MAX_HANDS];     //of the pot, or of the high half
+    uint64_t lowshares[MAX_HANDS];
+    uint64_t halves[MAX_HANDS];     //of the pot when split
+    uint64_t scoops[MAX_HANDS];
+    uint64_t nrunouts;
+}omaha_scorer;
+
+
+static void score_split(const omaha_job *job, omaha_scorer *s, const parts *triples){
+    int i, w, hi, lo, best = -1, bestlow = 1, nhi = 0, nlow = 0;
+    int hiwinners[MAX_HANDS], lowinners[MAX_HANDS];
+
+    for (i = 0; i < job->nhands; i++){
+        best_hilo(&job->pairs[i], triples, &hi, &lo);
+        ADD_WINNER(hiwinners, nhi, best, hi, i)
+        ADD_WINNER(lowinners, nlow, bestlow, lo, i)
+    }
+    //with no low the high takes both halves
+    for (w = 0; w < nhi; w++){
+        s->shares[hiwinners[w]] += SHARE_UNIT / nhi;
+        s->halves[hiwinners[w]] += (nlow ? 1 : 2) * (SHARE_UNIT / nhi);
+    }
+    for (w = 0; w < nlow; w++){
+        s->lowshares[lowinners[w]] += SHARE_UNIT / nlow;
+        s->halves[lowinners[w]] += SHARE_UNIT / nlow;
+    }
+    if (nhi == 1 && (nlow == 0 || (nlow == 1 && lowinners[0] == hiwinners[0])))
+        s->scoops[hiwinners[0]]++;
+    s->nrunouts++;
+}
+
+
+static void score_board(const omaha_job *job, omaha_scorer *s, const uint32_t board[5]){
+    parts triples;
+    int i, w, rank, best = -1, nwinners = 0, winners[MAX_HANDS];
+
+    board_triples(board, 5, &triples);
+    if (job->split){
+        score_split(job, s, &triples);
+        return;
+    }
+    for (i = 0; i < job->nhands; i++){
+        rank = best_rank(&job->pairs[i], &triples);
+        ADD_WINNER(winners, nwinners, best, rank, i)
+    }
+    for (w = 0; w < nwinners; w++)
+        s->shares[winners[w]] += SHARE_UNIT / nwinners;
+    s->nrunouts++;
+}
+
+
+//deal the cards from nboard on from the live cards below below
+static void omaha_runouts(const omaha_job *job, omaha_scorer *s, uint32_t board[5],
+                          int nboard, int below){
+    int i;
+
+    if (nboard == 5){
+        score_board(job, s, board);
+        return;
+    }
+    for (i = below; i-- > 4 - nboard;){
+        board[nboard] = job->live[i];
+        omaha_runouts(job, s, board, nboard + 1, i);
+    }
+}
+
+
+static void omaha_task(void *shared, void *local, int task){
+    const omaha_job *job = (const omaha_job *) shared;
+    uint32_t board[5];
+    int i = job->nlive - 1 - task;
+
+    memcpy(board, job->board, sizeof(board));
+    if (job->nboard == 5){
+        score_board(job, (omaha_scorer *) local, board);
+        return;
+    }
+    board[job->nboard] = job->live[i];
+    omaha_runouts(job, (omaha_scorer *) local, board, job->nboard + 1, i);
+}
+
+
+//score every runout into total, split or not
+static int enumerate(const uint32_t *holes, int nhole, int nhands, uint32_t board[5], int nboard,
+                     bool split, omaha_scorer *total, int nthreads){
+    bool dead[52];
+    omaha_job *job;
+    omaha_scorer *s;
+    int i, t, ntasks;
+
+    if (nhole < 4 || nhole > MAX_HOLE || nhands < 1 || nhands > MAX_HANDS ||
+        nboard < 0 || nboard > 5 || nhands * nhole + 5 > 52 || !init_best5() || (split && !init_lows()))
+        return FAIL;
+    if (set_dead((void *) holes, nhands * nhole, board, nboard, dead) == FAIL)
+        return FAIL;
+    if ( (job = (omaha_job *) malloc(sizeof(omaha_job))) == NULL )
+        return FAIL;
+
+    job->nhands = nhands;
+    job->split = split;
+    for (i = 0; i < nhands; i++)
+        hole_pairs(holes + i * nhole, nhole, &job->pairs[i]);
+    memcpy(job->board, board, nboard * sizeof(uint32_t));
+    job->nboard = nboard;
+    for (i = 0, job->nlive = 0; i < 52; i++){
+        if (!dead[i])
+            job->live[job->nlive++] = i;
+    }
+
+    ntasks = (nboard == 5) ? 1 : job->nlive - (4 - nboard);
+    nthreads = task_threads(nthreads, ntasks);
+    if ( (s = (omaha_scorer *) calloc(nthreads, sizeof(omaha_scorer))) == NULL ){
+        free(job);
+        return FAIL;
+    }
+    run_tasks(omaha_task, job, s, sizeof(omaha_scorer), ntasks, nthreads);
+
+    memset(total, 0, sizeof(omaha_scorer));
+    for (t = 0; t < nthreads; t++){
+        for (i = 0; i < nhands; i++){
+            total->shares[i] += s[t].shares[i];
+            total->lowshares[i] += s[t].lowshares[i];
+            total->halves[i] += s[t].halves[i];
+            total->scoops[i] += s[t].scoops[i];
+        }
+        total->nrunouts += s[t].nrunouts;
+    }
+    free(s);
+    free(job);
+    return SUCCESS;
+}
+
+
+int omaha_enumeration(const uint32_t *holes, int nhole, int nhands, uint32_t board[5], int nboard,
+                      double results[], int nthreads){
+    //holes -> nhands hands of nhole (4 or 5) cards each, one after another
+    //board -> nboard cards, between 0 and 5
+    //results -> the ev of each hand
+    //nthreads -> workers to share the next board card (see run_tasks)
+
+    omaha_scorer total;
+    int i;
+
+    if (enumerate(holes, nhole, nhands, board, nboard, false, &total, nthreads) == FAIL)
+        return FAIL;
+    for (i = 0; i < nhands; i++)
+        results[i] = (double) total.shares[i] / ((double) total.nrunouts * SHARE_UNIT);
+    return SUCCESS;
+}
+
+
+//as omaha_enumeration, for hi/lo 8 or better
+//results -> each hand's ev of the pot, its share of the high and low
+//    halves (the low share counting boards with no low as 0) and how
+//    often it scoops
+int omaha_hilo_enumeration(const uint32_t *holes, int nhole, int nhands, uint32_t board[5], int nboard,
+                           hilo results[], int nthreads){
+    omaha_scorer total;
+    double n;
+    int i;
+
+    if (enumerate(holes, nhole, nhands, board, nboard, true, &total, nthreads) == FAIL)
+        return FAIL;
+    n = (double) total.nrunouts;
+    for (i = 0; i < nhands; i++){
+        results[i].ev = (double) total.halves[i] / (2.0 * n * SHARE_UNIT);
+        results[i].hi = (double) total.shares[i] / (n * SHARE_UNIT);
+        results[i].lo = (double) total.lowshares[i] / (n * SHARE_UNIT);
+        results[i].scoop = (double) total.scoops[i] / n;
+    }
+    return SUCCESS;
+}
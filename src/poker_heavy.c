@@ -17,7 +17,16 @@
 
 #include "poker_heavy.h"
 
-uint16_t Rank_Table[7825760];
+#include <math.h>
+#include <string.h>
+
+//Rank_Table points at Rank_Storage once populate_tables has filled it,
+//or at a mapping of a saved table file (see table_file.c)
+uint16_t Rank_Storage[RANK_TABLE_SIZE];
+uint16_t *Rank_Table = Rank_Storage;
+
+extern uint16_t Rank_Displace[COMPACT_BUCKETS + 1];
+extern uint16_t Rank_Compact[COMPACT_SLOTS + 1];
 
 //DECK = [r | (s << SUITSHIFT) for r in SPECIALKS for s in (0, 1, 8, 57)]
 static const uint32_t Deck[52] = DECK;
@@ -53,7 +62,9 @@ static uint16_t dohand(uint32_t c1, uint32_t c2, const partial *data){
 
     uint32_t val = data->val + Deck[c1] + Deck[c2];
 
+    STATS_ADD(ranked, 1);
     if ( isFlushTable[val >> SUITSHIFT] != FAIL){
+        STATS_ADD(flushes, 1);
         flush = GET_BIT(c1) | GET_BIT(c2);
         for ( i = 0; i < 5; i++ ){
             flush += GET_BIT(data->board[i]);
@@ -63,7 +74,7 @@ static uint16_t dohand(uint32_t c1, uint32_t c2, const partial *data){
         return Flush_Table[flush];
     }
 
-    return Rank_Table[val & RANKMASK];
+    return RANK_LOOKUP(val & RANKMASK);
 }
 
 
@@ -86,6 +97,63 @@ int holdem2p(uint32_t h1[2], uint32_t h2[2], uint32_t board[5]){
 }
 
 
+//hands are handed to rank_keys this many at a time
+#define KEY_BUFFER 256
+
+//write the strength of each of n seven card hands to out
+//hands holds n rows of 7 cards
+//Return FAIL at the first hand holding a duplicate card
+int rank_batch(const uint32_t *hands, int n, uint16_t *out){
+    uint32_t keys[KEY_BUFFER];
+    uint64_t bits[KEY_BUFFER];
+    int i, j, nbuf;
+
+    for (; n > 0; n -= nbuf, out += nbuf){
+        nbuf = (n < KEY_BUFFER) ? n : KEY_BUFFER;
+        for (i = 0; i < nbuf; i++, hands += 7){
+            keys[i] = 0;
+            bits[i] = 0;
+            for (j = 0; j < 7; j++){
+                if (bits[i] & GET_BIT(hands[j]))
+                    return FAIL;
+                bits[i] |= GET_BIT(hands[j]);
+                keys[i] += Deck[hands[j]];
+            }
+        }
+        rank_keys(0, 0, keys, bits, nbuf, out);
+    }
+    return SUCCESS;
+}
+
+
+//as rank_batch with each hand split into a row of 2 hole cards
+//and a row of 5 board cards
+int holdem_rank_batch(const uint32_t *holes, const uint32_t *boards, int n, uint16_t *out){
+    uint32_t keys[KEY_BUFFER];
+    uint64_t bits[KEY_BUFFER];
+    int i, j, nbuf;
+
+    for (; n > 0; n -= nbuf, out += nbuf){
+        nbuf = (n < KEY_BUFFER) ? n : KEY_BUFFER;
+        for (i = 0; i < nbuf; i++, holes += 2, boards += 5){
+            keys[i] = Deck[holes[0]] + Deck[holes[1]];
+            bits[i] = GET_BIT(holes[0]);
+            if (bits[i] & GET_BIT(holes[1]))
+                return FAIL;
+            bits[i] |= GET_BIT(holes[1]);
+            for (j = 0; j < 5; j++){
+                if (bits[i] & GET_BIT(boards[j]))
+                    return FAIL;
+                bits[i] |= GET_BIT(boards[j]);
+                keys[i] += Deck[boards[j]];
+            }
+        }
+        rank_keys(0, 0, keys, bits, nbuf, out);
+    }
+    return SUCCESS;
+}
+
+
 int multi_holdem(uint32_t hands[MAX_HANDS][2], int n, uint32_t board[5], int winners_buf[]){
 
     //Return the number of players tied for the win (usually one)
@@ -116,7 +184,7 @@ int multi_holdem(uint32_t hands[MAX_HANDS][2], int n, uint32_t board[5], int win
 int set_dead(void *cards1_, int n1, void *cards2_, int n2, bool dead[52]){
     //assign true to all positions in deck that are listed in cards1
     //or cards2.  otherwise false.
-    //Return FAIL if there were duplicate cards
+    //Return FAIL if there were duplicate or bad cards
     int i;
     uint32_t *cards1 = (uint32_t*) cards1_;
     uint32_t *cards2 = (uint32_t*) cards2_;
@@ -125,13 +193,13 @@ int set_dead(void *cards1_, int n1, void *cards2_, int n2, bool dead[52]){
         dead[i] = false;
 
     for (i = 0; i < n1; i++){
-        if (dead[cards1[i]]){ //duplicate card
+        if (cards1[i] > 51 || dead[cards1[i]]){ //duplicate card
             return FAIL;
         }
         dead[cards1[i]] = true;
     }
     for (i = 0; i < n2; i++){
-        if (dead[cards2[i]]){ //duplicate card
+        if (cards2[i] > 51 || dead[cards2[i]]){ //duplicate card
             return FAIL;
         }
         dead[cards2[i]] = true;
@@ -140,19 +208,234 @@ int set_dead(void *cards1_, int n1, void *cards2_, int n2, bool dead[52]){
 }
 
 
+//the live cards and every pair of them, as keys and bits for rank_keys
+//pairs are ordered by their higher card, so the pairs among the first
+//n live cards are the first PAIRS_BELOW(n)
+typedef struct{
+    int nlive;
+    uint32_t live[52];
+    uint32_t keys[NUM_STARTING_HANDS];
+    uint64_t bits[NUM_STARTING_HANDS];
+    uint64_t masks[NUM_STARTING_HANDS];
+    bool pairs;
+}completions;
+
+#define PAIRS_BELOW(n) ((n) * ((n) - 1) / 2)
+
+
+static void live_cards(completions *c, const bool dead[52]){
+    int i;
+
+    c->nlive = 0;
+    for (i = 0; i < 52; i++){
+        if (!dead[i])
+            c->live[c->nlive++] = i;
+    }
+}
+
+
+static void live_singles(completions *c, const bool dead[52]){
+    int i;
+
+    live_cards(c, dead);
+    c->pairs = false;
+    for (i = 0; i < c->nlive; i++){
+        c->keys[i] = Deck[c->live[i]];
+        c->bits[i] = GET_BIT(c->live[i]);
+        c->masks[i] = CARD_BIT(c->live[i]);
+    }
+}
+
+
+static void live_pairs(completions *c, const bool dead[52]){
+    int i, j, n = 0;
+
+    live_cards(c, dead);
+    c->pairs = true;
+    for (i = 1; i < c->nlive; i++){
+        for (j = 0; j < i; j++, n++){
+            c->keys[n] = Deck[c->live[i]] + Deck[c->live[j]];
+            c->bits[n] = GET_BIT(c->live[i]) + GET_BIT(c->live[j]);
+            c->masks[n] = CARD_BIT(c->live[i]) | CARD_BIT(c->live[j]);
+        }
+    }
+}
+
+
+//Suit isomorphism
+//
+//A suit permutation that maps every hand and the board onto itself
+//maps each runout onto one with the same outcome, so only one runout
+//of each class needs ranking, counted once per member.
+//
+//Runouts are compared as masks with bit c set for card c.  Each rank
+//is a nibble, so comparing masks compares ranks from the last in card
+//order down ("above" below means later in card order), and a
+//permutation only moves bits within nibbles.  The runout a class is
+//ranked by is its largest mask.
+
+#define SUIT_PLANE 0x1111111111111ULL
+
+typedef struct{
+    int order;              //of the whole group
+    int nperms;             //perms excluding the identity
+    uint8_t perms[23][4];
+}suit_group;
+
+
+static inline uint64_t permute_suits(uint64_t mask, const uint8_t perm[4]){
+    return ((mask & SUIT_PLANE) << perm[0]) |
+           (((mask >> 1) & SUIT_PLANE) << perm[1]) |
+           (((mask >> 2) & SUIT_PLANE) << perm[2]) |
+           (((mask >> 3) & SUIT_PLANE) << perm[3]);
+}
+
+
+//fill g with the suit permutations fixing each hand and the board
+static void find_suit_group(suit_group *g, uint32_t hands[][2], int nhands,
+                            const uint32_t *board, int nboard){
+    uint64_t fixed[MAX_HANDS + 1];
+    uint8_t perm[4];
+    int a, b, c, i, nfixed = 0;
+
+    for (i = 0; i < nhands; i++)
+        fixed[nfixed++] = CARD_BIT(hands[i][0]) | CARD_BIT(hands[i][1]);
+    fixed[nfixed] = 0;
+    for (i = 0; i < nboard; i++)
+        fixed[nfixed] |= CARD_BIT(board[i]);
+    nfixed++;
+
+    g->order = 1;
+    g->nperms = 0;
+    for (a = 0; a < 4; a++){
+        for (b = 0; b < 4; b++){
+            if (b == a) continue;
+            for (c = 0; c < 4; c++){
+                if (c == a || c == b) continue;
+                perm[0] = a;
+                perm[1] = b;
+                perm[2] = c;
+                perm[3] = 6 - a - b - c;
+                if (a == 0 && b == 1 && c == 2)
+                    continue;
+                for (i = 0; i < nfixed; i++){
+                    if (permute_suits(fixed[i], perm) != fixed[i])
+                        break;
+                }
+                if (i == nfixed){
+                    memcpy(g->perms[g->nperms++], perm, 4);
+                    g->order++;
+                }
+            }
+        }
+    }
+}
+
+
+//narrow g to the permutations that matter for runouts of the cards in
+//mask plus cards below lowcard.  The ranks above lowcard's are settled
+//by mask, so a permutation lowering them can never raise such a runout
+//and one raising them raises them all: Return false if one does.
+static bool narrow_suit_group(const suit_group *g, uint64_t mask, int lowcard, suit_group *sub){
+    uint64_t image;
+    int i;
+
+    mask &= ~(CARD_BIT(((lowcard >> 2) + 1) * 4) - 1);
+    sub->order = g->order;
+    sub->nperms = 0;
+    for (i = 0; i < g->nperms; i++){
+        image = permute_suits(mask, g->perms[i]);
+        if (image > mask)
+            return false;
+        if (image == mask)
+            memcpy(sub->perms[sub->nperms++], g->perms[i], 4);
+    }
+    return true;
+}
+
+
+//append the canonical runouts among completions [p, end) of the cards
+//in mask to keys, bits and weights from m on.  Return the new count
+static int check_runouts(const suit_group *g, uint64_t mask, const completions *c, int p, int end,
+                         uint32_t *keys, uint64_t *bits, int *weights, int m){
+    uint64_t runout, image;
+    int i, fixes;
+
+    //nothing left that could raise them
+    if (!g->nperms){
+        memcpy(keys + m, c->keys + p, (end - p) * sizeof(uint32_t));
+        memcpy(bits + m, c->bits + p, (end - p) * sizeof(uint64_t));
+        for (; p < end; p++)
+            weights[m++] = g->order;
+        return m;
+    }
+
+    for (; p < end; p++){
+        runout = mask | c->masks[p];
+        fixes = 1;
+        for (i = 0; i < g->nperms; i++){
+            image = permute_suits(runout, g->perms[i]);
+            if (image > runout)
+                break;
+            fixes += (image == runout);
+        }
+        if (i < g->nperms)
+            continue;
+        keys[m] = c->keys[p];
+        bits[m] = c->bits[p];
+        weights[m++] = g->order / fixes;
+    }
+    return m;
+}
+
+
+//copy the canonical runouts among the first n completions of the cards
+//in mask to keys and bits, with the size of their class in weights
+//g must be narrowed to mask.  Return how many were copied
+static int canonical_runouts(const suit_group *g, uint64_t mask, const completions *c, int n,
+                             uint32_t *keys, uint64_t *bits, int *weights){
+    suit_group sub, lower;
+    int l, p, card, same, m = 0;
+
+    if (!c->pairs)
+        return check_runouts(g, mask, c, 0, n, keys, bits, weights, 0);
+
+    //the pairs under each higher card l are a run, with those whose
+    //lower card has l's rank at its end.  Below l's rank the cards of
+    //l's rank are settled, so the run narrows g twice.
+    for (l = 1; PAIRS_BELOW(l) < n; l++){
+        card = c->live[l];
+        if (!narrow_suit_group(g, mask | CARD_BIT(card), card, &sub))
+            continue;
+        p = PAIRS_BELOW(l);
+        for (same = l; same > 0 && (int) (c->live[same - 1] >> 2) == (card >> 2); same--);
+
+        if (same && narrow_suit_group(&sub, mask | CARD_BIT(card), (card & ~3) - 1, &lower))
+            m = check_runouts(&lower, mask | CARD_BIT(card), c, p, p + same, keys, bits, weights, m);
+        m = check_runouts(&sub, mask, c, p + same, p + l, keys, bits, weights, m);
+    }
+    return m;
+}
+
+
 struct rivervalue rivervalue (uint32_t hand[2], uint32_t board[5])
 //count the number of wins, losses, and ties vs all opponent combinations
 {
-    uint32_t i, j;
+    uint32_t i;
 
-    uint16_t my_rank;
-    uint16_t his_rank;
+    completions c;
+    uint16_t my_rank, ranks[NUM_STARTING_HANDS];
+    uint32_t handval;
+    uint64_t handbits;
+    int n, opp;
     bool dead[52];
     struct rivervalue value = (struct rivervalue) {0, 0};
 
-    partial data = {0, board};
+    uint32_t boardval = 0;
+    uint64_t boardbits = 0;
     for (i = 0; i < 5; i++){
-        data.val += Deck[board[i]];
+        boardval += Deck[board[i]];
+        boardbits |= GET_BIT(board[i]);
     }
 
     if (set_dead(hand, 2, board, 5, dead) == FAIL){
@@ -160,225 +443,1388 @@ struct rivervalue rivervalue (uint32_t hand[2], uint32_t board[5])
         return value;
     }
 
-    my_rank = dohand(hand[0], hand[1], &data);
+    handval = Deck[hand[0]] + Deck[hand[1]];
+    handbits = GET_BIT(hand[0]) | GET_BIT(hand[1]);
+    rank_keys(boardval, boardbits, &handval, &handbits, 1, &my_rank);
 
-    //run the hands, skipping deck[card]=falses
-    for (i = 52; --i; ){
-        if ( !dead[i] ){
-            for ( j = i; j--; ){
-                if ( !dead[j] ){
-                    his_rank = dohand(i, j, &data);
-                    if (my_rank > his_rank){
-                        value.wins ++;
-                    }else if (my_rank == his_rank){
-                        value.ties ++;
-                    }
-                }
-            }
+    //every opposing hand made of live cards
+    live_pairs(&c, dead);
+    n = PAIRS_BELOW(c.nlive);
+    rank_keys(boardval, boardbits, c.keys, c.bits, n, ranks);
+
+    for (opp = 0; opp < n; opp++){
+        if (my_rank > ranks[opp]){
+            value.wins ++;
+        }else if (my_rank == ranks[opp]){
+            value.ties ++;
         }
     }
     return value;
 }
 
 
-//return the win% of h1
-//super ugly optimized for two hands preflop
-double enum2p(uint32_t h1[2], uint32_t h2[2]){
-    bool dead[52];
+//what every enum2p worker reads
+typedef struct{
+    uint32_t h1val, h2val;
+    uint64_t flush1, flush2;
+    completions c;
+    suit_group g;
+}headsup;
+
+
+//count h1 wins, h2 wins and boards in results[3] for the runouts
+//whose first board card is the task-th live card from the top
+static void headsup_task(void *shared, void *local, int task){
+    const headsup *h = (const headsup *) shared;
+    const completions *c = &h->c;
+    uint64_t *results = (uint64_t *) local;
+
+    int i, j, k, n, p, w;
+    uint32_t vals[3];
+    uint64_t flushes[3], masks[3];
+    uint16_t ranks1[NUM_STARTING_HANDS], ranks2[NUM_STARTING_HANDS];
+    uint32_t counts[2];
+
+    //the canonical runouts below each flop when suits are interchangeable
+    suit_group g1, g2;
+    uint32_t symkeys[NUM_STARTING_HANDS];
+    uint64_t symbits[NUM_STARTING_HANDS];
+    int weights[NUM_STARTING_HANDS];
+
+    i = c->nlive - 1 - task;
+    vals[0] = Deck[c->live[i]];
+    flushes[0] = GET_BIT(c->live[i]);
+    masks[0] = CARD_BIT(c->live[i]);
+
+    for (j = i; j--;){
+        vals[1] = vals[0] + Deck[c->live[j]];
+        flushes[1] = flushes[0] + GET_BIT(c->live[j]);
+        masks[1] = masks[0] | CARD_BIT(c->live[j]);
+        if (!narrow_suit_group(&h->g, masks[1], c->live[j], &g1))
+            continue;
+
+        for (k = j; k-- > 1;){
+            vals[2] = vals[1] + Deck[c->live[k]];
+            flushes[2] = flushes[1] + GET_BIT(c->live[k]);
+            masks[2] = masks[1] | CARD_BIT(c->live[k]);
+            if (!narrow_suit_group(&g1, masks[2], c->live[k], &g2))
+                continue;
+            n = PAIRS_BELOW(k);
+
+            //every runout below is canonical with a class of g.order
+            if (!g2.nperms){
+                rank_keys(vals[2] + h->h1val, flushes[2] + h->flush1, c->keys, c->bits, n, ranks1);
+                rank_keys(vals[2] + h->h2val, flushes[2] + h->flush2, c->keys, c->bits, n, ranks2);
+                counts[0] = counts[1] = 0;
+                for (p = 0; p < n; p++){
+                    counts[0] += ranks1[p] > ranks2[p];
+                    counts[1] += ranks1[p] < ranks2[p];
+                }
+                results[0] += (uint64_t) h->g.order * counts[0];
+                results[1] += (uint64_t) h->g.order * counts[1];
+                results[2] += (uint64_t) h->g.order * n;
+                continue;
+            }
 
-    uint32_t i, j, k, l, m;
-    uint32_t results[3] = {0, 0, 0};
+            n = canonical_runouts(&g2, masks[2], c, n, symkeys, symbits, weights);
+            rank_keys(vals[2] + h->h1val, flushes[2] + h->flush1, symkeys, symbits, n, ranks1);
+            rank_keys(vals[2] + h->h2val, flushes[2] + h->flush2, symkeys, symbits, n, ranks2);
+            for (p = 0; p < n; p++){
+                w = weights[p];
+                results[0] += w * (ranks1[p] > ranks2[p]);
+                results[1] += w * (ranks1[p] < ranks2[p]);
+                results[2] += w;
+            }
+        }
+    }
+}
 
-    const uint64_t flush1 = GET_BIT(h1[0]) + GET_BIT(h1[1]);
-    const uint64_t flush2 = GET_BIT(h2[0]) + GET_BIT(h2[1]);
-    const uint32_t h1val = Deck[h1[0]] + Deck[h1[1]];
-    const uint32_t h2val = Deck[h2[0]] + Deck[h2[1]];
-    uint32_t vals[5];
 
-    uint32_t temp1, temp2;
-    uint64_t tempflush1, tempflush2;
+//count h1 wins, h2 wins and ties over every board in counts
+//the first three board cards are looped over and the last two come
+//from the live pairs below them, ranked a row at a time by rank_keys
+//nthreads workers share the first board cards (see run_tasks)
+int headsup_counts(uint32_t h1[2], uint32_t h2[2], uint64_t counts[3], int nthreads){
+    bool dead[52];
+    uint32_t hands[2][2] = {{h1[0], h1[1]}, {h2[0], h2[1]}};
+    uint64_t locals[MAX_THREADS][3];
+    headsup h;
+    int i;
 
     if (set_dead(h1, 2, h2, 2, dead) == FAIL)
         return FAIL;
 
-    for (i = 52; --i;){
-        if (dead[i]) continue;
-        //board[0] = i;
-        vals[0] = Deck[i];
-
-        for (j = i; j--;){
-            if (dead[j]) continue;
-            //board[1] = j;
-            vals[1] = vals[0] + Deck[j];
-
-            for (k = j; k--;){
-                if (dead[k]) continue;
-                //board[2] = k;
-                vals[2] = vals[1] + Deck[k];
-
-                for (l = k; l--;){
-                    if (dead[l]) continue;
-                    //board[3] = l;
-                    vals[3] = vals[2] + Deck[l];
-
-                    for (m = l; m--;){
-                        if (dead[m]) continue;
-                        //board[4] = m;
-                        vals[4] = vals[3] + Deck[m];
-                        temp1 = vals[4] + h1val;
-                        temp2 = vals[4] + h2val;
-
-                        if ( isFlushTable[(temp1 >> SUITSHIFT)] != FAIL ){
-
-                            tempflush1 = flush1 + GET_BIT(i) + GET_BIT(j) + GET_BIT(k) + GET_BIT(l) + GET_BIT(m);
-
-                            tempflush1 >>= isFlushTable[temp1 >> SUITSHIFT];
-                            tempflush1 &= CARD_MASK;
-                            temp1 = Flush_Table[tempflush1];
-
-                        }
-                        else{
-                            temp1 = Rank_Table[temp1 & RANKMASK];
-                        }
-
-                        if ( isFlushTable[(temp2 >> SUITSHIFT)] != FAIL ){
-
-                            tempflush2 = flush2 + GET_BIT(i) + GET_BIT(j) + GET_BIT(k) + GET_BIT(l) + GET_BIT(m);
-
-                            tempflush2 >>= isFlushTable[temp2 >> SUITSHIFT];
-                            tempflush2 &= CARD_MASK;
-                            temp2 = Flush_Table[tempflush2];
-
-                        }
-                        else{
-                            temp2 = Rank_Table[temp2 & RANKMASK];
-                        }
-
-                        if (temp1 > temp2){
-                            results[0] ++;
-                        }
-                        else if (temp1 < temp2){
-                            results[1] ++;
-                        }
-                        else{
-                            results[2] ++;
-                        }
-                    }
-                }
-            }
-        }
+    h.flush1 = GET_BIT(h1[0]) + GET_BIT(h1[1]);
+    h.flush2 = GET_BIT(h2[0]) + GET_BIT(h2[1]);
+    h.h1val = Deck[h1[0]] + Deck[h1[1]];
+    h.h2val = Deck[h2[0]] + Deck[h2[1]];
+    live_pairs(&h.c, dead);
+    find_suit_group(&h.g, hands, 2, NULL, 0);
+
+    nthreads = task_threads(nthreads, h.c.nlive);
+    memset(locals, 0, sizeof(locals));
+    run_tasks(headsup_task, &h, locals, sizeof(locals[0]), h.c.nlive, nthreads);
+    counts[0] = counts[1] = counts[2] = 0;
+    for (i = 0; i < nthreads; i++){
+        counts[0] += locals[i][0];
+        counts[1] += locals[i][1];
+        counts[2] += locals[i][2];
     }
-    return (results[0] + 0.5 * (double) results[2]) / (results[0] + results[1]+ results[2]);
+
+    //counts[2] counted every board so far
+    counts[2] -= counts[0] + counts[1];
+    return SUCCESS;
 }
 
 
-int monte_carlo(uint32_t hands[MAX_HANDS][2], int nhands, int nruns, double results[]){
-    //no board because full_enumeration should be fast enough
+//return the win% of h1
+//from the preflop table when one is loaded (see preflop.c)
+double enum2p(uint32_t h1[2], uint32_t h2[2], int nthreads){
+    uint64_t counts[3];
 
-    int deal(uint32_t [], int);
-    int initdeck(bool [52]);
+    if (preflop_lookup(h1, h2, counts) == FAIL && headsup_counts(h1, h2, counts, nthreads) == FAIL)
+        return FAIL;
+    return (counts[0] + 0.5 * (double) counts[2]) / (counts[0] + counts[1]+ counts[2]);
+}
 
-    int i, n, nwinners, winners[MAX_HANDS];
-    uint32_t board[5];
-    bool dead[52];
 
-    if (set_dead(hands, nhands * 2, NULL, 0, dead) == FAIL)
+//count h1 wins, h2 wins and ties over every runout of a 3 or 4 card
+//board in counts
+//Each hand's sums with the board are made once, and the missing cards
+//come from the live pairs or singles (only the canonical ones when
+//suits are interchangeable), ranked in one row per hand by rank_keys.
+int headsup_board_counts(uint32_t h1[2], uint32_t h2[2], uint32_t board[5], int nboard,
+                         uint64_t counts[3]){
+    bool dead[52];
+    uint32_t hands[2][2] = {{h1[0], h1[1]}, {h2[0], h2[1]}};
+    uint32_t boardval = 0, symkeys[NUM_STARTING_HANDS];
+    uint64_t boardflush = 0, symbits[NUM_STARTING_HANDS];
+    uint16_t ranks1[NUM_STARTING_HANDS], ranks2[NUM_STARTING_HANDS];
+    int weights[NUM_STARTING_HANDS];
+    const uint32_t *keys;
+    const uint64_t *bits;
+    completions *c;
+    suit_group g;
+    int i, n, w;
+
+    if ((nboard != 3 && nboard != 4) || set_dead(hands, 4, board, nboard, dead) == FAIL)
         return FAIL;
-    if (initdeck(dead) == FAIL)
+    if ( (c = (completions *) malloc(sizeof(completions))) == NULL )
         return FAIL;
 
-    for (i = 0; i < nhands; results[i++] = 0.0);
+    for (i = 0; i < nboard; i++){
+        boardval += Deck[board[i]];
+        boardflush += GET_BIT(board[i]);
+    }
+    if (nboard == 4){
+        live_singles(c, dead);
+        n = c->nlive;
+    }
+    else{
+        live_pairs(c, dead);
+        n = PAIRS_BELOW(c->nlive);
+    }
+    keys = c->keys;
+    bits = c->bits;
+    find_suit_group(&g, hands, 2, board, nboard);
+    if (g.nperms){
+        n = canonical_runouts(&g, 0, c, n, symkeys, symbits, weights);
+        keys = symkeys;
+        bits = symbits;
+    }
 
-    for (i = 0; i < nruns; i++){
-        deal(board, 5);
-        nwinners = multi_holdem(hands, nhands, board, winners);
-        if (nwinners == 1){
-            results[winners[0]] += 1.0;
+    rank_keys(boardval + Deck[h1[0]] + Deck[h1[1]], boardflush + GET_BIT(h1[0]) + GET_BIT(h1[1]),
+              keys, bits, n, ranks1);
+    rank_keys(boardval + Deck[h2[0]] + Deck[h2[1]], boardflush + GET_BIT(h2[0]) + GET_BIT(h2[1]),
+              keys, bits, n, ranks2);
+    counts[0] = counts[1] = counts[2] = 0;
+    for (i = 0; i < n; i++){
+        w = g.nperms ? weights[i] : g.order;
+        counts[0] += w * (ranks1[i] > ranks2[i]);
+        counts[1] += w * (ranks1[i] < ranks2[i]);
+        counts[2] += w * (ranks1[i] == ranks2[i]);
+    }
+    free(c);
+    return SUCCESS;
+}
+
+
+//full_enumeration ranks every hand against each set of runouts that
+//share their leading cards, then scores those runouts together
+//
+//A win scores SHARE_UNIT and an n way tie SHARE_UNIT / n, which is
+//exact for up to MAX_HANDS ways.  Integer scores add up the same in
+//any order, so threaded results match serial ones bit for bit.
+
+//full_enumeration's kernels are specialized for up to this many hands
+#define MAX_KERNEL_HANDS 9
+
+typedef struct enumeration enumeration;
+typedef struct scorer scorer;
+typedef void (*score_fn)(const enumeration *e, scorer *s, const suit_group *g, uint32_t boardval,
+                         uint64_t boardflush, uint64_t mask, int n);
+
+//what every worker reads
+struct enumeration{
+    int nhands;
+    uint32_t handvals[MAX_HANDS];
+    uint64_t handflushes[MAX_HANDS];
+    int nboard;
+    uint32_t boardval;
+    uint64_t boardflush;
+    completions c;
+    suit_group g;
+    score_fn score;     //the kernel for nhands
+};
+
+//what each worker writes
+struct scorer{
+    uint64_t shares[MAX_HANDS];
+    uint64_t nrunnouts;
+    uint16_t ranks[MAX_HANDS][NUM_STARTING_HANDS];
+    //for the canonical runouts when suits are interchangeable
+    uint32_t keys[NUM_STARTING_HANDS];
+    uint64_t bits[NUM_STARTING_HANDS];
+    int weights[NUM_STARTING_HANDS];
+};
+
+
+//SHARE_UNIT / n for each n way tie
+#define TIE(n) SHARE_UNIT / (n)
+static const uint32_t Tie_Shares[MAX_HANDS + 1] = {
+    0, TIE(1), TIE(2), TIE(3), TIE(4), TIE(5), TIE(6), TIE(7), TIE(8), TIE(9), TIE(10), TIE(11),
+    TIE(12), TIE(13), TIE(14), TIE(15), TIE(16), TIE(17), TIE(18), TIE(19), TIE(20), TIE(21), TIE(22)
+};
+#undef TIE
+
+
+//rank each hand against the first n completions of the board summed
+//in boardval whose runout cards so far are in mask, with g narrowed to
+//mask, into s->ranks
+//Return the number of completions ranked, fewer when suits are
+//interchangeable and only the canonical ones (in s) are
+static inline __attribute__((always_inline))
+int rank_runnouts(const enumeration *e, scorer *s, const suit_group *g, uint32_t boardval,
+                  uint64_t boardflush, uint64_t mask, int n, const int nhands){
+    const uint32_t *keys = e->c.keys;
+    const uint64_t *bits = e->c.bits;
+    int i;
+
+    if (g->nperms){
+        n = canonical_runouts(g, mask, &e->c, n, s->keys, s->bits, s->weights);
+        keys = s->keys;
+        bits = s->bits;
+    }
+    for (i = 0; i < nhands; i++){
+        rank_keys(boardval + e->handvals[i], boardflush + e->handflushes[i],
+                  keys, bits, n, s->ranks[i]);
+    }
+    return n;
+}
+
+
+//score those completions for any number of hands
+static void score_any(const enumeration *e, scorer *s, const suit_group *g, uint32_t boardval,
+                      uint64_t boardflush, uint64_t mask, int n){
+    int p, i, w, weight = g->order, best, nwinners, winners[MAX_HANDS];
+
+    n = rank_runnouts(e, s, g, boardval, boardflush, mask, n, e->nhands);
+    for (p = 0; p < n; p++){
+        best = -1;
+        nwinners = 0;
+        for (i = 0; i < e->nhands; i++){
+            if (s->ranks[i][p] > best){
+                winners[0] = i;
+                nwinners = 1;
+                best = s->ranks[i][p];
+            }
+            else if (s->ranks[i][p] == best){
+                winners[nwinners++] = i;
+            }
         }
-        else{
-            for (n = nwinners - 1; n >= 0; n--){
-                results[winners[n]] += 1.0 / nwinners;
-             }
+        if (g->nperms)
+            weight = s->weights[p];
+        for (w = nwinners - 1; w >= 0; w--){
+            s->shares[winners[w]] += (uint64_t) weight * (SHARE_UNIT / nwinners);
         }
+        s->nrunnouts += weight;
     }
+}
 
-    for (i = 0; i < nhands; i++){
-        results[i] /= nruns;
+
+//score them for a number of hands known at compile time, inlined into
+//the kernels below: the loops over the hands unroll, without branches,
+//and the shares stay in registers
+static inline __attribute__((always_inline))
+void score_hands(const enumeration *e, scorer *s, const suit_group *g, uint32_t boardval,
+                 uint64_t boardflush, uint64_t mask, int n, const int nhands){
+    uint64_t shares[MAX_KERNEL_HANDS] = {0}, share, nrunnouts = 0;
+    int p, i, weight = g->order, best, nwinners;
+
+    n = rank_runnouts(e, s, g, boardval, boardflush, mask, n, nhands);
+    for (p = 0; p < n; p++){
+        best = s->ranks[0][p];
+        for (i = 1; i < nhands; i++){
+            if (s->ranks[i][p] > best)
+                best = s->ranks[i][p];
+        }
+        nwinners = 0;
+        for (i = 0; i < nhands; i++)
+            nwinners += s->ranks[i][p] == best;
+        if (g->nperms)
+            weight = s->weights[p];
+        share = (uint64_t) weight * Tie_Shares[nwinners];
+        for (i = 0; i < nhands; i++)
+            shares[i] += share & -(uint64_t) (s->ranks[i][p] == best);
+        nrunnouts += weight;
     }
-    return SUCCESS;
+    for (i = 0; i < nhands; i++)
+        s->shares[i] += shares[i];
+    s->nrunnouts += nrunnouts;
 }
 
 
-int full_enumeration(uint32_t hands[MAX_HANDS][2], int nhands, uint32_t board[5], int nboard, double results[]){
+#define SCORE_KERNEL(nhands) \
+    static void score_##nhands(const enumeration *e, scorer *s, const suit_group *g, uint32_t boardval, \
+                               uint64_t boardflush, uint64_t mask, int n){ \
+        score_hands(e, s, g, boardval, boardflush, mask, n, nhands); \
+    }
+
+SCORE_KERNEL(2)
+SCORE_KERNEL(3)
+SCORE_KERNEL(4)
+SCORE_KERNEL(5)
+SCORE_KERNEL(6)
+SCORE_KERNEL(7)
+SCORE_KERNEL(8)
+SCORE_KERNEL(9)
+
+#undef SCORE_KERNEL
+
+//by number of hands 2 and up, with score_any outside it
+static const score_fn Score_Kernels[MAX_KERNEL_HANDS + 1] = {
+    NULL, NULL, score_2, score_3, score_4, score_5, score_6, score_7, score_8, score_9
+};
+
+
+//score the runouts whose first card is the task-th live card from the
+//top, or all of them when the flop is already out
+//The kernels below inline this with nboard a constant.
+static inline __attribute__((always_inline))
+void enumerate_runouts(const enumeration *e, scorer *s, int task, const int nboard){
+    const completions *c = &e->c;
+    const score_fn score = e->score;
+
+    int i, j, k;
+    uint32_t vals[3];
+    uint64_t flushes[3], masks[3];
+    suit_group g[3];
+
+    //the last one (turn given) or two cards of each runout come from
+    //e->c, and the 3 - nboard before them are looped over here
+
+    if (nboard == 4){
+        score(e, s, &e->g, e->boardval, e->boardflush, 0, c->nlive);
+        return;
+    }
+    if (nboard == 3){
+        score(e, s, &e->g, e->boardval, e->boardflush, 0, PAIRS_BELOW(c->nlive));
+        return;
+    }
+
+    i = c->nlive - 1 - task;
+    vals[0] = e->boardval + Deck[c->live[i]];
+    flushes[0] = e->boardflush + GET_BIT(c->live[i]);
+    masks[0] = CARD_BIT(c->live[i]);
+    if (!narrow_suit_group(&e->g, masks[0], c->live[i], &g[0]))
+        return;
+    if (nboard == 2){
+        score(e, s, &g[0], vals[0], flushes[0], masks[0], PAIRS_BELOW(i));
+        return;
+    }
+    for (j = i; j--;){
+        vals[1] = vals[0] + Deck[c->live[j]];
+        flushes[1] = flushes[0] + GET_BIT(c->live[j]);
+        masks[1] = masks[0] | CARD_BIT(c->live[j]);
+        if (!narrow_suit_group(&g[0], masks[1], c->live[j], &g[1]))
+            continue;
+        if (nboard == 1){
+            score(e, s, &g[1], vals[1], flushes[1], masks[1], PAIRS_BELOW(j));
+            continue;
+        }
+        for (k = j; k-- > 1;){
+            vals[2] = vals[1] + Deck[c->live[k]];
+            flushes[2] = flushes[1] + GET_BIT(c->live[k]);
+            masks[2] = masks[1] | CARD_BIT(c->live[k]);
+            if (!narrow_suit_group(&g[1], masks[2], c->live[k], &g[2]))
+                continue;
+            score(e, s, &g[2], vals[2], flushes[2], masks[2], PAIRS_BELOW(k));
+        }
+    }
+}
+
+
+#define ENUMERATION_KERNEL(nboard) \
+    static void enumeration_task_##nboard(void *shared, void *local, int task){ \
+        enumerate_runouts((const enumeration *) shared, (scorer *) local, task, nboard); \
+    }
+
+ENUMERATION_KERNEL(0)
+ENUMERATION_KERNEL(1)
+ENUMERATION_KERNEL(2)
+ENUMERATION_KERNEL(3)
+ENUMERATION_KERNEL(4)
+
+#undef ENUMERATION_KERNEL
+
+//by number of board cards
+static const task_fn Enumeration_Tasks[5] = {
+    enumeration_task_0, enumeration_task_1, enumeration_task_2, enumeration_task_3, enumeration_task_4
+};
+
+
+int full_enumeration(uint32_t hands[MAX_HANDS][2], int nhands, uint32_t board[5], int nboard,
+                     double results[], int nthreads){
     //hands ->array of two card hands with no duplicates
     //results -> buffer to hold the results, ev of each hand
     //nhands -> number of hands
-    //board -> populated by up to 4 cards with room for 5
+    //board -> populated by up to 4 cards
     //nboard -> between 0 and 4
+    //nthreads -> workers to share the first board cards (see run_tasks)
 
     bool dead[52];
 
-    uint32_t i, j, k, l, m;
-    int n, nwinners, nrunnouts = 0, winners[MAX_HANDS];
+    int i, t, ntasks;
+    uint64_t shares[MAX_HANDS], nrunnouts = 0;
+    enumeration *e;
+    scorer *s;
 
     if (set_dead(hands, nhands * 2, board, nboard, dead) == FAIL)
         return FAIL;
+    //too big for the stack of a thread
+    if ( (e = (enumeration *) malloc(sizeof(enumeration))) == NULL )
+        return FAIL;
 
-    for (i = 0; i < nhands; results[i++] = 0.0);
-
-    //a solution for incorporating variable number of board cards
-    //without changing the preflop code much
-
-    #define CRUNCH nwinners = multi_holdem(hands, nhands, board, winners); \
-                   nrunnouts++; \
-                   if (nwinners == 1) \
-                       results[winners[0]] += 1.0; \
-                   else{ \
-                       for (n = nwinners - 1; n >= 0; n--){ \
-                           results[winners[n]] += 1.0 / nwinners; \
-                        } \
-                   }
-
-    #define CRUNCH_IF(n_) if (nboard == n_){ \
-                              CRUNCH \
-                              continue; \
-                          }
-
-    for (i = 52; --i;){
-        if (dead[i]) continue;
-        board[4] = i;
-        CRUNCH_IF(4)
-        for (j = i; j--;){
-            if (dead[j]) continue;
-            board[3] = j;
-            CRUNCH_IF(3)
-            for (k = j; k--;){
-                if (dead[k]) continue;
-                board[2] = k;
-                CRUNCH_IF(2)
-                for (l = k; l--;){
-                    if (dead[l]) continue;
-                    board[1] = l;
-                    CRUNCH_IF(1)
-                    for (m = l; m--;){
-                        if (dead[m]) continue;
-                        board[0] = m;
-                        CRUNCH
-                    }
+    e->nhands = nhands;
+    e->nboard = nboard;
+    for (i = 0; i < nhands; i++){
+        e->handvals[i] = Deck[hands[i][0]] + Deck[hands[i][1]];
+        e->handflushes[i] = GET_BIT(hands[i][0]) + GET_BIT(hands[i][1]);
+    }
+    e->boardval = 0;
+    e->boardflush = 0;
+    for (i = 0; i < nboard; i++){
+        e->boardval += Deck[board[i]];
+        e->boardflush += GET_BIT(board[i]);
+    }
+    e->score = (nhands >= 2 && nhands <= MAX_KERNEL_HANDS) ? Score_Kernels[nhands] : score_any;
+    find_suit_group(&e->g, hands, nhands, board, nboard);
+    if (nboard == 4)
+        live_singles(&e->c, dead);
+    else
+        live_pairs(&e->c, dead);
+
+    ntasks = (nboard >= 3) ? 1 : e->c.nlive;
+    nthreads = task_threads(nthreads, ntasks);
+    if ( (s = (scorer *) malloc(nthreads * sizeof(scorer))) == NULL ){
+        free(e);
+        return FAIL;
+    }
+    for (t = 0; t < nthreads; t++){
+        memset(s[t].shares, 0, sizeof(s[t].shares));
+        s[t].nrunnouts = 0;
+    }
+    run_tasks(Enumeration_Tasks[nboard], e, s, sizeof(scorer), ntasks, nthreads);
+
+    for (i = 0; i < nhands; i++)
+        shares[i] = 0;
+    for (t = 0; t < nthreads; t++){
+        for (i = 0; i < nhands; i++)
+            shares[i] += s[t].shares[i];
+        nrunnouts += s[t].nrunnouts;
+    }
+    for (i = 0; i < nhands; i++){
+        results[i] = (double) shares[i] / ((double) nrunnouts * SHARE_UNIT);
+    }
+    free(s);
+    free(e);
+    return SUCCESS;
+}
+
+
+//range_equity weighs every set of non-conflicting combos, one from
+//each range, by the product of their weights over every runout.
+//A runout ranks each combo that is in any range once.  Two ranges are
+//then scored in one sweep over the combos in rank order, taking the
+//weight of the combos each one blocks back out card by card.  More
+//ranges are scored set by set from a list made up front.
+//
+//Each task adds into its own row of sums, which are combined in task
+//order, so the results are the same for any number of threads.
+
+#define MAX_TUPLES (1 << 21)
+
+typedef struct{
+    int nranges;
+    int ncombos;
+    uint32_t keys[NUM_STARTING_HANDS];
+    uint64_t bits[NUM_STARTING_HANDS];
+    uint64_t masks[NUM_STARTING_HANDS];
+    uint8_t cards[NUM_STARTING_HANDS][2];
+    double weights[MAX_HANDS][NUM_STARTING_HANDS];
+    //three or more ranges
+    int ntuples;
+    uint16_t *tuples;       //nranges combos each
+    uint64_t *tuplemasks;
+    double *tupleweights;
+    //runouts
+    uint32_t boardval;
+    uint64_t boardflush;
+    int nlive;
+    uint32_t live[52];
+    int nrunout;
+    //per task, the weighted share of each range then the total weight
+    double (*sums)[MAX_HANDS + 1];
+}ranged;
+
+//each worker's scratch
+typedef struct{
+    //the combos a runout doesn't block, then the ranks of all by index
+    int nlive;
+    uint16_t live[NUM_STARTING_HANDS];
+    uint32_t keys[NUM_STARTING_HANDS];
+    uint64_t bits[NUM_STARTING_HANDS];
+    uint16_t liveranks[NUM_STARTING_HANDS];
+    uint16_t ranks[NUM_STARTING_HANDS];
+    uint32_t order[NUM_STARTING_HANDS];
+    uint32_t spare[NUM_STARTING_HANDS];
+}range_scratch;
+
+
+//sort the n values in order by the 16 bit rank above their low 11 bits
+static uint32_t *sort_by_rank(uint32_t *order, uint32_t *spare, int n){
+    int counts[256], i, j, shift, total, tmp;
+    uint32_t *swap, value;
+
+    //clearing the counts costs more than sorting a few directly
+    if (n < 64){
+        for (i = 1; i < n; i++){
+            value = order[i];
+            for (j = i; j > 0 && order[j - 1] > value; j--)
+                order[j] = order[j - 1];
+            order[j] = value;
+        }
+        return order;
+    }
+    for (shift = 11; shift < 27; shift += 8){
+        memset(counts, 0, sizeof(counts));
+        for (i = 0; i < n; i++)
+            counts[(order[i] >> shift) & 0xff]++;
+        for (i = 0, total = 0; i < 256; i++){
+            tmp = counts[i];
+            counts[i] = total;
+            total += tmp;
+        }
+        for (i = 0; i < n; i++)
+            spare[counts[(order[i] >> shift) & 0xff]++] = order[i];
+        swap = order;
+        order = spare;
+        spare = swap;
+    }
+    return order;
+}
+
+
+//score two ranges on the runout s has ranked
+//the first range's wins, ties and total weight go in sums[0], [1], [2]
+static void score_two_ranges(const ranged *r, range_scratch *s, double *sums){
+    const double *wa = r->weights[0], *wb = r->weights[1];
+    double total = 0.0, below = 0.0, equal, cards[52], cardsbelow[52], cardsequal[52];
+    double wins = 0.0, ties = 0.0, weight = 0.0;
+    uint32_t *order;
+    int i, j, k, n = s->nlive, a;
+    const uint8_t *c;
+
+    memset(cards, 0, sizeof(cards));
+    memset(cardsbelow, 0, sizeof(cardsbelow));
+    for (i = 0; i < n; i++){
+        a = s->live[i];
+        s->order[i] = ((uint32_t) s->liveranks[i] << 11) | a;
+        total += wb[a];
+        cards[r->cards[a][0]] += wb[a];
+        cards[r->cards[a][1]] += wb[a];
+    }
+    order = sort_by_rank(s->order, s->spare, n);
+
+    for (i = 0; i < n; i = j){
+        //the combos from i to j tie
+        equal = 0.0;
+        for (j = i; j < n && (order[j] >> 11) == (order[i] >> 11); j++){
+            c = r->cards[order[j] & 0x7ff];
+            cardsequal[c[0]] = cardsequal[c[1]] = 0.0;
+        }
+        for (k = i; k < j; k++){
+            a = order[k] & 0x7ff;
+            c = r->cards[a];
+            equal += wb[a];
+            cardsequal[c[0]] += wb[a];
+            cardsequal[c[1]] += wb[a];
+        }
+        for (k = i; k < j; k++){
+            a = order[k] & 0x7ff;
+            if (wa[a] == 0.0)
+                continue;
+            c = r->cards[a];
+            wins += wa[a] * (below - cardsbelow[c[0]] - cardsbelow[c[1]]);
+            ties += wa[a] * (equal - cardsequal[c[0]] - cardsequal[c[1]] + wb[a]);
+            weight += wa[a] * (total - cards[c[0]] - cards[c[1]] + wb[a]);
+        }
+        for (k = i; k < j; k++){
+            a = order[k] & 0x7ff;
+            c = r->cards[a];
+            below += wb[a];
+            cardsbelow[c[0]] += wb[a];
+            cardsbelow[c[1]] += wb[a];
+        }
+    }
+    sums[0] += wins;
+    sums[1] += ties;
+    sums[2] += weight;
+}
+
+
+//score every listed set of combos that the runout in mask doesn't block
+static void score_tuples(const ranged *r, range_scratch *s, uint64_t mask, double *sums){
+    const uint16_t *tuple = r->tuples;
+    int t, i, best, rank, nwinners, winners[MAX_HANDS];
+    double w;
+
+    for (t = 0; t < r->ntuples; t++, tuple += r->nranges){
+        if (r->tuplemasks[t] & mask)
+            continue;
+        best = -1;
+        nwinners = 0;
+        for (i = 0; i < r->nranges; i++){
+            rank = s->ranks[tuple[i]];
+            if (rank > best){
+                winners[0] = i;
+                nwinners = 1;
+                best = rank;
+            }
+            else if (rank == best){
+                winners[nwinners++] = i;
+            }
+        }
+        w = r->tupleweights[t];
+        for (i = 0; i < nwinners; i++)
+            sums[winners[i]] += w / nwinners;
+        sums[r->nranges] += w;
+    }
+}
+
+
+//score every runout that adds left more of the first below live cards
+static void range_runouts(const ranged *r, range_scratch *s, int below, int left,
+                          uint32_t val, uint64_t flush, uint64_t mask, double *sums){
+    int i, n = 0;
+
+    if (!left){
+        //combos sharing a runout card would make bad keys
+        for (i = 0; i < r->ncombos; i++){
+            if (r->masks[i] & mask)
+                continue;
+            s->live[n] = i;
+            s->keys[n] = r->keys[i];
+            s->bits[n++] = r->bits[i];
+        }
+        s->nlive = n;
+        rank_keys(val, flush, s->keys, s->bits, n, s->liveranks);
+        if (r->nranges == 2){
+            score_two_ranges(r, s, sums);
+            return;
+        }
+        for (i = 0; i < n; i++)
+            s->ranks[s->live[i]] = s->liveranks[i];
+        score_tuples(r, s, mask, sums);
+        return;
+    }
+    for (i = below; i-- >= left;){
+        range_runouts(r, s, i, left - 1, val + Deck[r->live[i]], flush + GET_BIT(r->live[i]),
+                      mask | CARD_BIT(r->live[i]), sums);
+    }
+}
+
+
+//the runouts whose highest card is the task-th live card from the top
+static void range_task(void *shared, void *local, int task){
+    const ranged *r = (const ranged *) shared;
+    int i = r->nlive - 1 - task;
+
+    if (!r->nrunout){
+        range_runouts(r, (range_scratch *) local, 0, 0, r->boardval, r->boardflush, 0, r->sums[task]);
+        return;
+    }
+    range_runouts(r, (range_scratch *) local, i, r->nrunout - 1, r->boardval + Deck[r->live[i]],
+                  r->boardflush + GET_BIT(r->live[i]), CARD_BIT(r->live[i]), r->sums[task]);
+}
+
+
+//list the sets of combos from ranges n and up that don't conflict with
+//mask or each other
+static bool list_tuples(ranged *r, int n, uint16_t *tuple, uint64_t mask, double weight){
+    int i;
+
+    if (n == r->nranges){
+        if (r->ntuples == MAX_TUPLES)
+            return false;
+        memcpy(r->tuples + r->ntuples * r->nranges, tuple, r->nranges * sizeof(tuple[0]));
+        r->tuplemasks[r->ntuples] = mask;
+        r->tupleweights[r->ntuples++] = weight;
+        return true;
+    }
+    for (i = 0; i < r->ncombos; i++){
+        if (r->weights[n][i] == 0.0 || (r->masks[i] & mask))
+            continue;
+        tuple[n] = i;
+        if (!list_tuples(r, n + 1, tuple, mask | r->masks[i], weight * r->weights[n][i]))
+            return false;
+    }
+    return true;
+}
+
+
+int range_equity(const double *weights[], int nranges, uint32_t board[5], int nboard,
+                 double results[], int nthreads){
+    //weights -> nranges arrays of NUM_STARTING_HANDS weights in
+    //    GET_INDEX order, 0 for combos not in the range
+    //board -> nboard cards, 0-5
+    //results -> the equity of each range
+    //nthreads -> workers to share the runouts (see run_tasks)
+    //Return FAIL if no combos can meet, or there are too many sets of
+    //three or more to list
+
+    int i, j, k, n, t, ntasks, result = FAIL;
+    uint16_t tuple[MAX_HANDS];
+    uint64_t boardmask = 0;
+    double sums[MAX_HANDS + 1];
+    bool dead[52];
+    range_scratch *scratch = NULL;
+    ranged *r;
+
+    if (nranges < 2 || nranges > MAX_HANDS)
+        return FAIL;
+    if (set_dead(board, nboard, NULL, 0, dead) == FAIL)
+        return FAIL;
+    if ( (r = (ranged *) calloc(1, sizeof(ranged))) == NULL )
+        return FAIL;
+
+    r->nranges = nranges;
+    for (i = 0; i < nboard; i++){
+        r->boardval += Deck[board[i]];
+        r->boardflush += GET_BIT(board[i]);
+        boardmask |= CARD_BIT(board[i]);
+    }
+
+    //the combos in any range that the board doesn't block
+    for (i = 0, k = 0; i < 52; i++){
+        for (j = i + 1; j < 52; j++, k++){
+            if (dead[i] || dead[j])
+                continue;
+            for (t = 0; t < nranges && weights[t][k] == 0.0; t++);
+            if (t == nranges)
+                continue;
+            n = r->ncombos++;
+            r->keys[n] = Deck[i] + Deck[j];
+            r->bits[n] = GET_BIT(i) + GET_BIT(j);
+            r->masks[n] = CARD_BIT(i) | CARD_BIT(j);
+            r->cards[n][0] = i;
+            r->cards[n][1] = j;
+            for (t = 0; t < nranges; t++)
+                r->weights[t][n] = weights[t][k];
+        }
+    }
+
+    if (nranges > 2){
+        r->tuples = (uint16_t *) malloc(MAX_TUPLES * nranges * sizeof(uint16_t));
+        r->tuplemasks = (uint64_t *) malloc(MAX_TUPLES * sizeof(uint64_t));
+        r->tupleweights = (double *) malloc(MAX_TUPLES * sizeof(double));
+        if (!r->tuples || !r->tuplemasks || !r->tupleweights)
+            goto done;
+        if (!list_tuples(r, 0, tuple, boardmask, 1.0))
+            goto done;
+    }
+
+    for (i = 0; i < 52; i++){
+        if (!dead[i])
+            r->live[r->nlive++] = i;
+    }
+    r->nrunout = 5 - nboard;
+    ntasks = r->nrunout ? r->nlive - r->nrunout + 1 : 1;
+    nthreads = task_threads(nthreads, ntasks);
+    r->sums = calloc(ntasks, sizeof(r->sums[0]));
+    scratch = (range_scratch *) malloc(nthreads * sizeof(range_scratch));
+    if (!r->sums || !scratch)
+        goto done;
+    run_tasks(range_task, r, scratch, sizeof(range_scratch), ntasks, nthreads);
+
+    memset(sums, 0, sizeof(sums));
+    for (t = 0; t < ntasks; t++){
+        for (i = 0; i <= nranges; i++)
+            sums[i] += r->sums[t][i];
+    }
+    if (nranges == 2){
+        //sums are the first range's wins, ties and total weight
+        if (sums[2] > 0.0){
+            results[0] = (sums[0] + 0.5 * sums[1]) / sums[2];
+            results[1] = 1.0 - results[0];
+            result = SUCCESS;
+        }
+    }
+    else if (sums[nranges] > 0.0){
+        for (i = 0; i < nranges; i++)
+            results[i] = sums[i] / sums[nranges];
+        result = SUCCESS;
+    }
+
+  done:
+    free(scratch);
+    free(r->sums);
+    free(r->tuples);
+    free(r->tuplemasks);
+    free(r->tupleweights);
+    free(r);
+    return result;
+}
+
+
+//hand_strengths rates hands on a board of 3 to 5 cards against every
+//other hand: HS now, the mean (EHS) and mean square (EHS2) of the
+//river HS over every runout, and the potentials of Billings et al,
+//PPot for getting ahead from behind and NPot for the reverse.
+//Each runout ranks every combo the board leaves once, then compares
+//every pair of them, so rating all of the hands shares the rankings.
+//
+//The rank table only covers 7 cards, so the current strengths come
+//from best5_rank, which looks the flop's and turn's up in the 5 and 6
+//card tables of best5.c.
+
+
+//the sums hand_strengths keeps for each rated hand and task
+typedef struct{
+    double hs, hs2;         //of the river HS
+    uint64_t nrunouts;
+    uint64_t hp[3][3];      //opponents by now then river, behind tied ahead
+}potential;
+
+typedef struct{
+    int ncombos;            //the combos the board leaves
+    uint32_t keys[NUM_STARTING_HANDS];
+    uint64_t bits[NUM_STARTING_HANDS];
+    uint64_t masks[NUM_STARTING_HANDS];
+    uint32_t now[NUM_STARTING_HANDS];
+    uint8_t cards[NUM_STARTING_HANDS][2];
+    int hand;               //the combo to rate, or FAIL for all of them
+    bool potentials;        //false when only the river HS is wanted
+    uint32_t boardval;
+    uint64_t boardflush;
+    int nlive;
+    uint32_t live[52];
+    int nrunout;
+    potential *sums;        //per task, per rated combo
+    int nbins;              //of the river HS histograms, if any
+}strengths;
+
+//each worker's scratch
+typedef struct{
+    uint16_t live[NUM_STARTING_HANDS];
+    uint32_t keys[NUM_STARTING_HANDS];
+    uint64_t bits[NUM_STARTING_HANDS];
+    uint16_t ranks[NUM_STARTING_HANDS];
+    uint32_t river[NUM_STARTING_HANDS][3];
+    uint32_t order[NUM_STARTING_HANDS];
+    uint32_t spare[NUM_STARTING_HANDS];
+    uint32_t *hist;         //nbins per combo, or NULL
+}strength_scratch;
+
+//0, 1 or 2 for a behind, tied with or ahead of b
+#define COMPARE(a, b) (((a) > (b)) - ((a) < (b)) + 1)
+
+
+//count every ranked combo's opponents behind, tied and ahead on the
+//river by sweeping them in rank order and taking out the opponents that
+//share a card, as score_two_ranges does
+static void river_counts(const strengths *st, strength_scratch *s, int n){
+    int i, j, k, x, y, below = 0, cards[52], cardsbelow[52], cardsequal[52];
+    const uint8_t *c;
+    uint32_t *order, *river;
+
+    memset(cards, 0, sizeof(cards));
+    memset(cardsbelow, 0, sizeof(cardsbelow));
+    for (i = 0; i < n; i++){
+        c = st->cards[s->live[i]];
+        cards[c[0]]++;
+        cards[c[1]]++;
+        s->order[i] = (uint32_t) s->ranks[i] << 11 | i;
+    }
+    order = sort_by_rank(s->order, s->spare, n);
+
+    for (i = 0; i < n; i = j){
+        //the combos from i to j tie
+        for (j = i; j < n && (order[j] >> 11) == (order[i] >> 11); j++){
+            c = st->cards[s->live[order[j] & 0x7ff]];
+            cardsequal[c[0]] = cardsequal[c[1]] = 0;
+        }
+        for (k = i; k < j; k++){
+            c = st->cards[s->live[order[k] & 0x7ff]];
+            cardsequal[c[0]]++;
+            cardsequal[c[1]]++;
+        }
+        for (k = i; k < j; k++){
+            river = s->river[order[k] & 0x7ff];
+            c = st->cards[s->live[order[k] & 0x7ff]];
+            x = c[0];
+            y = c[1];
+            //the combo itself shares both cards, so is taken out twice
+            river[2] = below - cardsbelow[x] - cardsbelow[y];
+            river[1] = (j - i) - cardsequal[x] - cardsequal[y] + 1;
+            river[0] = (n - cards[x] - cards[y] + 1) - river[2] - river[1];
+        }
+        for (k = i; k < j; k++){
+            c = st->cards[s->live[order[k] & 0x7ff]];
+            cardsbelow[c[0]]++;
+            cardsbelow[c[1]]++;
+        }
+        below += j - i;
+    }
+}
+
+
+//rate the hands on the runout whose cards are in mask
+static void rate_runout(const strengths *st, strength_scratch *s, uint32_t val, uint64_t flush,
+                        uint64_t mask, potential *sums){
+    int i, j, a, b, c, d, n = 0, me = 0;
+    uint32_t *river;
+    double hs;
+
+    if (st->hand != FAIL && (st->masks[st->hand] & mask))
+        return;
+    for (i = 0; i < st->ncombos; i++){
+        if (st->masks[i] & mask)
+            continue;
+        if (i == st->hand)
+            me = n;
+        s->live[n] = i;
+        s->keys[n] = st->keys[i];
+        s->bits[n++] = st->bits[i];
+    }
+    rank_keys(val, flush, s->keys, s->bits, n, s->ranks);
+
+    memset(s->river, 0, n * sizeof(s->river[0]));
+    if (st->hand == FAIL && !st->potentials)
+        river_counts(st, s, n);
+    else if (st->hand != FAIL){
+        a = st->hand;
+        for (j = 0; j < n; j++){
+            b = s->live[j];
+            if (st->masks[a] & st->masks[b])
+                continue;
+            c = COMPARE(st->now[a], st->now[b]);
+            d = COMPARE(s->ranks[me], s->ranks[j]);
+            sums->hp[c][d]++;
+            s->river[0][d]++;
+        }
+        n = 1;
+    }
+    else{
+        for (i = 0; i < n; i++){
+            a = s->live[i];
+            for (j = i + 1; j < n; j++){
+                b = s->live[j];
+                if (st->masks[a] & st->masks[b])
+                    continue;
+                c = COMPARE(st->now[a], st->now[b]);
+                d = COMPARE(s->ranks[i], s->ranks[j]);
+                sums[a].hp[c][d]++;
+                sums[b].hp[2 - c][2 - d]++;
+                s->river[i][d]++;
+                s->river[j][2 - d]++;
+            }
+        }
+    }
+
+    for (i = 0; i < n; i++){
+        river = s->river[i];
+        hs = (river[2] + 0.5 * river[1]) / (river[0] + river[1] + river[2]);
+        a = (st->hand != FAIL) ? 0 : s->live[i];
+        sums[a].hs += hs;
+        sums[a].hs2 += hs * hs;
+        sums[a].nrunouts++;
+        if (s->hist){
+            b = (int) (hs * st->nbins);
+            s->hist[(size_t) a * st->nbins + ((b < st->nbins) ? b : st->nbins - 1)]++;
+        }
+    }
+}
+
+
+//rate the hands on every runout that adds left more of the first
+//below live cards
+static void strength_runouts(const strengths *st, strength_scratch *s, int below, int left,
+                             uint32_t val, uint64_t flush, uint64_t mask, potential *sums){
+    int i;
+
+    if (!left){
+        rate_runout(st, s, val, flush, mask, sums);
+        return;
+    }
+    for (i = below; i-- >= left;){
+        strength_runouts(st, s, i, left - 1, val + Deck[st->live[i]], flush + GET_BIT(st->live[i]),
+                         mask | CARD_BIT(st->live[i]), sums);
+    }
+}
+
+
+//the runouts whose highest card is the task-th live card from the top
+static void strength_task(void *shared, void *local, int task){
+    const strengths *st = (const strengths *) shared;
+    potential *sums = st->sums + task * ((st->hand != FAIL) ? 1 : st->ncombos);
+    int i = st->nlive - 1 - task;
+
+    if (!st->nrunout){
+        strength_runouts(st, (strength_scratch *) local, 0, 0, st->boardval, st->boardflush, 0, sums);
+        return;
+    }
+    strength_runouts(st, (strength_scratch *) local, i, st->nrunout - 1, st->boardval + Deck[st->live[i]],
+                     st->boardflush + GET_BIT(st->live[i]), CARD_BIT(st->live[i]), sums);
+}
+
+
+//hand_strengths, and with nbins the river HS histograms of every hand
+//in hist (nbins per combo in GET_INDEX order), counted by each worker
+static int rate_hands(uint32_t board[5], int nboard, uint32_t hand[2], strength results[],
+                      int nbins, uint32_t hist[], int nthreads){
+
+    int i, j, k, t, n, slot, nslots, ntasks, result = FAIL;
+    uint32_t cards[7];
+    uint64_t hp[3][3], now[3];
+    double runouts, behind, ahead;
+    bool dead[52];
+    strength_scratch *scratch = NULL;
+    strengths *st;
+    strength *r;
+    potential *p;
+
+    if (nboard < 3 || nboard > 5 || !init_best5())
+        return FAIL;
+    for (i = 0; i < nboard; i++){
+        if (board[i] > 51 || (i < 2 && hand && hand[i] > 51))
+            return FAIL;
+    }
+    if (set_dead(board, nboard, hand, hand ? 2 : 0, dead) == FAIL)
+        return FAIL;
+    if ( (st = (strengths *) calloc(1, sizeof(strengths))) == NULL )
+        return FAIL;
+
+    for (i = 0; i < nboard; i++){
+        st->boardval += Deck[board[i]];
+        st->boardflush += GET_BIT(board[i]);
+        cards[i] = board[i];
+    }
+    if (hand){
+        dead[hand[0]] = dead[hand[1]] = false;
+    }
+
+    //every combo the board leaves, and its value now
+    st->hand = FAIL;
+    for (i = 0; i < 52; i++){
+        for (j = i + 1; j < 52; j++){
+            if (dead[i] || dead[j])
+                continue;
+            n = st->ncombos++;
+            if ( hand && (CARD_BIT(i) | CARD_BIT(j)) == (CARD_BIT(hand[0]) | CARD_BIT(hand[1])) )
+                st->hand = n;
+            st->keys[n] = Deck[i] + Deck[j];
+            st->bits[n] = GET_BIT(i) + GET_BIT(j);
+            st->masks[n] = CARD_BIT(i) | CARD_BIT(j);
+            st->cards[n][0] = i;
+            st->cards[n][1] = j;
+            cards[nboard] = i;
+            cards[nboard + 1] = j;
+            st->now[n] = best5_rank(cards, nboard + 2);
+        }
+    }
+
+    for (i = 0; i < 52; i++){
+        if (!dead[i])
+            st->live[st->nlive++] = i;
+    }
+    st->nrunout = 5 - nboard;
+    ntasks = st->nrunout ? st->nlive - st->nrunout + 1 : 1;
+    nslots = hand ? 1 : st->ncombos;
+    nthreads = task_threads(nthreads, ntasks);
+    st->sums = (potential *) calloc((size_t) ntasks * nslots, sizeof(potential));
+    scratch = (strength_scratch *) calloc(nthreads, sizeof(strength_scratch));
+    if (!st->sums || !scratch)
+        goto done;
+    st->nbins = nbins;
+    //nothing is left to come on the river, where HS is the river HS
+    st->potentials = results != NULL && st->nrunout;
+    for (t = 0; hist && t < nthreads; t++){
+        if ( (scratch[t].hist = (uint32_t *) calloc((size_t) st->ncombos * nbins, sizeof(uint32_t))) == NULL )
+            goto done;
+    }
+    run_tasks(strength_task, st, scratch, sizeof(strength_scratch), ntasks, nthreads);
+
+    if (hist){
+        memset(hist, 0, (size_t) NUM_STARTING_HANDS * nbins * sizeof(uint32_t));
+        for (i = 0, k = 0, slot = 0; i < 52; i++){
+            for (j = i + 1; j < 52; j++, k++){
+                if (dead[i] || dead[j])
+                    continue;
+                for (t = 0; t < nthreads; t++){
+                    for (n = 0; n < nbins; n++)
+                        hist[(size_t) k * nbins + n] += scratch[t].hist[(size_t) slot * nbins + n];
                 }
+                slot++;
             }
         }
+        result = SUCCESS;
+        goto done;
     }
-    //we end up skipping card 0 if only running out out rivers
-    if (nboard == 4 && !dead[0]){
-        board[4] = 0;
-        CRUNCH
+
+    if (!hand){
+        for (i = 0; i < NUM_STARTING_HANDS; i++)
+            results[i].hs = results[i].ehs = results[i].ehs2 = results[i].ppot = results[i].npot = NAN;
+    }
+    for (i = 0, k = 0, slot = 0; i < 52; i++){
+        for (j = i + 1; j < 52; j++, k++){
+            if (dead[i] || dead[j])
+                continue;
+            if (hand && slot++ != st->hand)
+                continue;
+            r = hand ? results : &results[k];
+
+            //add the tasks up in order so the sums don't depend on threads
+            memset(hp, 0, sizeof(hp));
+            r->ehs = r->ehs2 = runouts = 0.0;
+            for (t = 0; t < ntasks; t++){
+                p = &st->sums[t * nslots + (hand ? 0 : slot)];
+                r->ehs += p->hs;
+                r->ehs2 += p->hs2;
+                runouts += p->nrunouts;
+                for (n = 0; n < 9; n++)
+                    hp[n / 3][n % 3] += p->hp[n / 3][n % 3];
+            }
+            if (!hand)
+                slot++;
+            r->ehs /= runouts;
+            r->ehs2 /= runouts;
+
+            //opponents behind, tied with and ahead of the hand now, each
+            //counted once per runout
+            for (n = 0; n < 3; n++)
+                now[n] = hp[n][0] + hp[n][1] + hp[n][2];
+            r->hs = st->nrunout ? (now[2] + 0.5 * now[1]) / (now[0] + now[1] + now[2]) : r->ehs;
+            behind = now[0] + 0.5 * now[1];
+            ahead = now[2] + 0.5 * now[1];
+            r->ppot = behind ? (hp[0][2] + 0.5 * hp[0][1] + 0.5 * hp[1][2]) / behind : 0.0;
+            r->npot = ahead ? (hp[2][0] + 0.5 * hp[2][1] + 0.5 * hp[1][0]) / ahead : 0.0;
+        }
     }
+    result = SUCCESS;
+
+  done:
+    for (t = 0; scratch && t < nthreads; t++)
+        free(scratch[t].hist);
+    free(scratch);
+    free(st->sums);
+    free(st);
+    return result;
+}
 
-    for (i = 0; i < nhands; i++){
-        results[i] /= nrunnouts;
+
+int hand_strengths(uint32_t board[5], int nboard, uint32_t hand[2], strength results[], int nthreads){
+    //board -> 3 to 5 cards
+    //hand -> the hand to rate, or NULL to rate every hand
+    //results -> the strength of hand, or NUM_STARTING_HANDS strengths
+    //    in GET_INDEX order with NAN for hands that use a board card
+    //nthreads -> workers to share the runouts (see run_tasks)
+    return rate_hands(board, nboard, hand, results, 0, NULL, nthreads);
+}
+
+
+int equity_histograms(uint32_t board[5], int nboard, int nbins, uint32_t hist[], int nthreads){
+    //board -> 3 to 5 cards
+    //hist -> for every hand in GET_INDEX order, the number of runouts
+    //    whose river HS falls in each of nbins even bins from 0 to 1.
+    //    Hands that use a board card get none.
+    //nthreads -> workers to share the runouts (see run_tasks)
+    if (nbins <= 0 || nbins > MAX_BINS)
+        return FAIL;
+    return rate_hands(board, nboard, NULL, NULL, nbins, hist, nthreads);
+}
+
+
+//monte_carlo deals its runs from MC_STREAMS streams, each a jump of
+//the seeded deck, and scores them like full_enumeration, so a seed
+//gives the same results for any number of threads.  Runs go in rounds
+//of up to MC_ROUND; between rounds it checks the standard errors.
+
+#define MC_STREAMS 64
+#define MC_ROUND (MC_STREAMS * 256)
+
+typedef struct{
+    int game;
+    uint32_t holes[MAX_HANDS * MAX_HOLE];     //nhole cards a hand
+    int nhole;
+    int nhands;
+    uint32_t board[5];
+    int nboard;
+    int nstreams;
+    int nruns;      //this round
+    deck decks[MC_STREAMS];
+    uint64_t shares[MC_STREAMS][MAX_HANDS];
+    double squares[MC_STREAMS][MAX_HANDS];
+}simulation;
+
+
+//deal and score the task-th stream's share of the round
+static void simulation_task(void *shared, void *local, int task){
+    simulation *sim = (simulation *) shared;
+    deck *d = &sim->decks[task];
+    uint64_t *shares = sim->shares[task];
+    double *squares = sim->squares[task];
+    uint32_t board[5];
+    int i, n, nruns, nwinners, winners[MAX_HANDS];
+    (void) local;
+
+    for (i = 0; i < sim->nboard; i++)
+        board[i] = sim->board[i];
+    nruns = sim->nruns / sim->nstreams + (task < sim->nruns % sim->nstreams);
+    for (i = 0; i < nruns; i++){
+        deal(d, board + sim->nboard, 5 - sim->nboard);
+        if (sim->game == GAME_OMAHA)
+            nwinners = multi_omaha(sim->holes, sim->nhole, sim->nhands, board, winners);
+        else if (sim->game == GAME_SHORT)
+            nwinners = multi_short((uint32_t (*)[2]) sim->holes, sim->nhands, board, winners);
+        else
+            nwinners = multi_holdem((uint32_t (*)[2]) sim->holes, sim->nhands, board, winners);
+        for (n = nwinners - 1; n >= 0; n--){
+            shares[winners[n]] += SHARE_UNIT / nwinners;
+            squares[winners[n]] += 1.0 / (nwinners * nwinners);
+        }
     }
-    return SUCCESS;
+}
+
+
+//deal game for nhands hands of nhole cards each, one after another in holes
+static int simulate(int game, const uint32_t *holes, int nhole, int nhands, uint32_t board[5], int nboard,
+                    uint32_t deadcards[], int ndead, int nruns, double target_se,
+                    double results[], double stderrs[], uint64_t seed, int nthreads){
+    //game -> GAME_HOLDEM, GAME_OMAHA or GAME_SHORT
+    //board -> up to 4 cards, the rest are dealt
+    //deadcards -> ndead cards that can't be dealt
+    //nruns -> the most runs to deal, at least 1
+    //target_se -> stop once every standard error is at most this, 0 to
+    //    always deal nruns
+    //results, stderrs -> the ev of each hand and its standard error
+    //seed -> the same seed deals the same boards
+    //nthreads -> workers to share the streams (see run_tasks)
+    //Return the number of runs dealt
+
+    int i, t, done, nlive;
+    double mean, variance, worst;
+    uint64_t shares;
+    bool dead[52];
+    simulation *sim;
+
+    if (game == GAME_SHORT){
+        if (!init_short_deck() || set_short_dead(holes, nhands * nhole, board, nboard, dead) == FAIL)
+            return FAIL;
+    }
+    else if (set_dead((void *) holes, nhands * nhole, board, nboard, dead) == FAIL)
+        return FAIL;
+    for (i = 0; i < ndead; i++){
+        if (deadcards[i] > 51 || dead[deadcards[i]])
+            return FAIL;
+        dead[deadcards[i]] = true;
+    }
+    for (i = 0, nlive = 0; i < 52; i++)
+        nlive += !dead[i];
+    if (nlive < 5 - nboard)
+        return FAIL;
+    if ( (sim = (simulation *) calloc(1, sizeof(simulation))) == NULL )
+        return FAIL;
+
+    sim->game = game;
+    memcpy(sim->holes, holes, nhands * nhole * sizeof(uint32_t));
+    sim->nhole = nhole;
+    sim->nhands = nhands;
+    for (i = 0; i < nboard; i++)
+        sim->board[i] = board[i];
+    sim->nboard = nboard;
+    sim->nstreams = (nruns < MC_STREAMS) ? nruns : MC_STREAMS;
+    initdeck(&sim->decks[0], dead, seed);
+    for (t = 1; t < sim->nstreams; t++){
+        sim->decks[t] = sim->decks[t - 1];
+        jumpdeck(&sim->decks[t]);
+    }
+
+    for (done = 0; done < nruns; ){
+        sim->nruns = (nruns - done < MC_ROUND) ? nruns - done : MC_ROUND;
+        run_tasks(simulation_task, sim, NULL, 0, sim->nstreams, nthreads);
+        done += sim->nruns;
+
+        //add the streams up in order so the sums don't depend on threads
+        worst = 0.0;
+        for (i = 0; i < nhands; i++){
+            shares = 0;
+            variance = 0.0;
+            for (t = 0; t < sim->nstreams; t++){
+                shares += sim->shares[t][i];
+                variance += sim->squares[t][i];
+            }
+            mean = (double) shares / ((double) done * SHARE_UNIT);
+            variance = variance / done - mean * mean;
+            results[i] = mean;
+            stderrs[i] = (done > 1 && variance > 0.0) ? sqrt(variance / (done - 1)) : 0.0;
+            if (stderrs[i] > worst)
+                worst = stderrs[i];
+        }
+        //a handful of runs can all agree by chance, so don't trust them
+        if (target_se > 0.0 && done >= MC_STREAMS && worst <= target_se)
+            break;
+    }
+    free(sim);
+    return done;
+}
+
+
+int monte_carlo(uint32_t hands[MAX_HANDS][2], int nhands, uint32_t board[5], int nboard,
+                uint32_t deadcards[], int ndead, int nruns, double target_se,
+                double results[], double stderrs[], uint64_t seed, int nthreads){
+    return simulate(GAME_HOLDEM, hands[0], 2, nhands, board, nboard, deadcards, ndead, nruns,
+                    target_se, results, stderrs, seed, nthreads);
+}
+
+
+//the same for Omaha hands of nhole (4 or 5) cards, one after another in holes
+int omaha_monte_carlo(const uint32_t *holes, int nhole, int nhands, uint32_t board[5], int nboard,
+                      uint32_t deadcards[], int ndead, int nruns, double target_se,
+                      double results[], double stderrs[], uint64_t seed, int nthreads){
+    if (nhole < 4 || nhole > MAX_HOLE)
+        return FAIL;
+    return simulate(GAME_OMAHA, holes, nhole, nhands, board, nboard, deadcards, ndead, nruns,
+                    target_se, results, stderrs, seed, nthreads);
+}
+
+
+//the same for short deck hands (see short_deck.c)
+int short_monte_carlo(uint32_t hands[MAX_HANDS][2], int nhands, uint32_t board[5], int nboard,
+                      uint32_t deadcards[], int ndead, int nruns, double target_se,
+                      double results[], double stderrs[], uint64_t seed, int nthreads){
+    return simulate(GAME_SHORT, hands[0], 2, nhands, board, nboard, deadcards, ndead, nruns,
+                    target_se, results, stderrs, seed, nthreads);
 }
 
 
@@ -424,3 +1870,200 @@ int river_distribution (uint32_t hand[2], uint32_t board[5], int chart[], dictEn
     }
     return 0;
 }
+
+
+//ochs rates hands against each group of a hand grouping over every
+//runout of a flop, turn or river: the opponent cluster hand strength.
+//Each runout ranks every combo the board leaves once for all of the
+//hands.  Wins and ties add up as integers, so each worker keeps its
+//own counts and the totals don't depend on the threads.
+
+typedef struct{
+    int ncombos;            //the combos the board leaves
+    uint32_t keys[NUM_STARTING_HANDS];
+    uint64_t bits[NUM_STARTING_HANDS];
+    uint64_t masks[NUM_STARTING_HANDS];
+    int groups[NUM_STARTING_HANDS];
+    int nhands;
+    const int *hands;       //each hand's combo, or FAIL if the board blocks it
+    int ngroups;
+    uint32_t boardval;
+    uint64_t boardflush;
+    int nlive;
+    uint32_t live[52];
+    int nrunout;
+}groupings;
+
+//each worker's scratch and counts
+typedef struct{
+    int slot[NUM_STARTING_HANDS];   //a combo's place in the runout's list
+    uint16_t live[NUM_STARTING_HANDS];
+    uint32_t keys[NUM_STARTING_HANDS];
+    uint64_t bits[NUM_STARTING_HANDS];
+    uint16_t ranks[NUM_STARTING_HANDS];
+    uint64_t *counts;       //per hand, per group: points then opponents
+}group_scratch;
+
+
+static void group_runout(const groupings *g, group_scratch *s, uint32_t val, uint64_t flush,
+                         uint64_t mask){
+    int h, i, j, a, n = 0;
+    uint64_t *counts;
+    uint16_t mine;
+
+    for (i = 0; i < g->ncombos; i++){
+        if (g->masks[i] & mask){
+            s->slot[i] = FAIL;
+            continue;
+        }
+        s->slot[i] = n;
+        s->live[n] = i;
+        s->keys[n] = g->keys[i];
+        s->bits[n++] = g->bits[i];
+    }
+    rank_keys(val, flush, s->keys, s->bits, n, s->ranks);
+
+    for (h = 0; h < g->nhands; h++){
+        if ( (a = g->hands[h]) == FAIL || s->slot[a] == FAIL )
+            continue;
+        mine = s->ranks[s->slot[a]];
+        counts = s->counts + (size_t) h * g->ngroups * 2;
+        for (j = 0; j < n; j++){
+            if (g->masks[a] & g->masks[s->live[j]])
+                continue;
+            i = g->groups[s->live[j]] * 2;
+            counts[i] += (mine > s->ranks[j]) * 2 + (mine == s->ranks[j]);
+            counts[i + 1]++;
+        }
+    }
+}
+
+
+static void group_runouts(const groupings *g, group_scratch *s, int below, int left,
+                          uint32_t val, uint64_t flush, uint64_t mask){
+    int i;
+
+    if (!left){
+        group_runout(g, s, val, flush, mask);
+        return;
+    }
+    for (i = below; i-- >= left;){
+        group_runouts(g, s, i, left - 1, val + Deck[g->live[i]], flush + GET_BIT(g->live[i]),
+                      mask | CARD_BIT(g->live[i]));
+    }
+}
+
+
+//the runouts whose highest card is the task-th live card from the top
+static void group_task(void *shared, void *local, int task){
+    const groupings *g = (const groupings *) shared;
+    int i = g->nlive - 1 - task;
+
+    if (!g->nrunout){
+        group_runouts(g, (group_scratch *) local, 0, 0, g->boardval, g->boardflush, 0);
+        return;
+    }
+    group_runouts(g, (group_scratch *) local, i, g->nrunout - 1, g->boardval + Deck[g->live[i]],
+                  g->boardflush + GET_BIT(g->live[i]), CARD_BIT(g->live[i]));
+}
+
+
+int ochs(uint32_t hands[][2], int nhands, uint32_t board[5], int nboard,
+         const dictEntry *dict, int ngroups, double results[], int nthreads){
+    //hands -> the hands to rate
+    //board -> 3 to 5 cards
+    //dict -> every combo's group in GET_INDEX order (see river_distribution),
+    //    with groups 0 to ngroups - 1
+    //results -> each hand's equity against each group, ngroups per hand,
+    //    NAN for hands that use a board card and groups left empty
+    //nthreads -> workers to share the runouts (see run_tasks)
+    //Return FAIL for duplicate board cards or too little memory
+
+    int h, i, j, k, t, n, ntasks, *combos = NULL, result = FAIL;
+    uint32_t lo, hi;
+    uint64_t points, opponents;
+    group_scratch *scratch = NULL;
+    bool dead[52];
+    groupings *g;
+
+    if (nboard < 3 || nboard > 5 || ngroups <= 0)
+        return FAIL;
+    for (i = 0; i < nboard; i++){
+        if (board[i] > 51)
+            return FAIL;
+    }
+    if (set_dead(board, nboard, NULL, 0, dead) == FAIL)
+        return FAIL;
+    if ( (g = (groupings *) calloc(1, sizeof(groupings))) == NULL )
+        return FAIL;
+
+    for (i = 0; i < nboard; i++){
+        g->boardval += Deck[board[i]];
+        g->boardflush += GET_BIT(board[i]);
+    }
+    for (i = 0; i < 52; i++){
+        if (!dead[i])
+            g->live[g->nlive++] = i;
+    }
+
+    //every combo the board leaves, with each hand's place among them
+    if ( (combos = (int *) malloc((nhands + NUM_STARTING_HANDS) * sizeof(int))) == NULL )
+        goto done;
+    for (i = 0, k = 0; i < 52; i++){
+        for (j = i + 1; j < 52; j++, k++){
+            combos[nhands + k] = FAIL;
+            if (dead[i] || dead[j])
+                continue;
+            n = g->ncombos++;
+            combos[nhands + k] = n;
+            g->keys[n] = Deck[i] + Deck[j];
+            g->bits[n] = GET_BIT(i) + GET_BIT(j);
+            g->masks[n] = CARD_BIT(i) | CARD_BIT(j);
+            g->groups[n] = dict[k].value;
+        }
+    }
+    for (h = 0; h < nhands; h++){
+        if (hands[h][0] > 51 || hands[h][1] > 51 || hands[h][0] == hands[h][1])
+            goto done;
+        lo = (hands[h][0] < hands[h][1]) ? hands[h][0] : hands[h][1];
+        hi = hands[h][0] ^ hands[h][1] ^ lo;
+        combos[h] = combos[nhands + lo * 52 - lo * (lo + 1) / 2 + hi - lo - 1];
+    }
+    g->hands = combos;
+    g->nhands = nhands;
+    g->ngroups = ngroups;
+
+    g->nrunout = 5 - nboard;
+    ntasks = g->nrunout ? g->nlive - g->nrunout + 1 : 1;
+    nthreads = task_threads(nthreads, ntasks);
+    if ( (scratch = (group_scratch *) calloc(nthreads, sizeof(group_scratch))) == NULL )
+        goto done;
+    for (t = 0; t < nthreads; t++){
+        scratch[t].counts = (uint64_t *) calloc((size_t) nhands * ngroups * 2, sizeof(uint64_t));
+        if (!scratch[t].counts)
+            goto done;
+    }
+    run_tasks(group_task, g, scratch, sizeof(group_scratch), ntasks, nthreads);
+
+    for (h = 0; h < nhands; h++){
+        for (i = 0; i < ngroups; i++){
+            points = opponents = 0;
+            for (t = 0; t < nthreads; t++){
+                points += scratch[t].counts[((size_t) h * ngroups + i) * 2];
+                opponents += scratch[t].counts[((size_t) h * ngroups + i) * 2 + 1];
+            }
+            results[(size_t) h * ngroups + i] = opponents ? points / (2.0 * opponents) : NAN;
+        }
+    }
+    result = SUCCESS;
+
+  done:
+    if (scratch){
+        for (t = 0; t < nthreads; t++)
+            free(scratch[t].counts);
+    }
+    free(scratch);
+    free(combos);
+    free(g);
+    return result;
+}
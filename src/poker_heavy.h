@@ -8,7 +8,7 @@
 
 
 #define RANK_TABLE_SIZE 7825760
-#define FLUSH_TABLE_SIZE (0x7f << 6) + 1
+#define FLUSH_TABLE_SIZE ((0x7f << 6) + 1)
 #define NUM_FLUSHES 4421
 #define NUM_SFS 298
 #define NUM_RANK_COMBOS 49205
@@ -25,12 +25,106 @@
 
 #define NUM_STARTING_HANDS 1326
 #define MAX_HANDS 22
+#define MAX_HOLE 5
+//distinct 5 card hands (see best5.c)
+#define NUM_BEST5_RANKS 7462
+#define MAX_THREADS 64
+//most bins of an equity histogram (see abstraction.c)
+#define MAX_BINS 1024
+//a win's score, which n way ties split exactly (see full_enumeration)
+#define SHARE_UNIT 232792560    //lcm(1..22)
+
+//short deck hold'em deals cards 0-35, ace to six, and their Deck sums
+//are below SHORT_TABLE_SIZE (see short_deck.c)
+#define SHORT_DECK 36
+#define SHORT_TABLE_SIZE 117511
+
+//the games simulate deals (see monte_carlo)
+#define GAME_HOLDEM 0
+#define GAME_OMAHA 1
+#define GAME_SHORT 2
+
+//boards of 5 from the 48 cards two hands leave
+#define PREFLOP_BOARDS 1712304
 
 #define FAIL -1
 #define SUCCESS 1
 
+//compact rank table (see compact_table.c), selected at build time
+//by defining COMPACT_RANKS
+#define COMPACT_BUCKET_BITS 14
+#define COMPACT_SLOT_BITS 16
+#define COMPACT_BUCKETS (1 << COMPACT_BUCKET_BITS)
+#define COMPACT_SLOTS (1 << COMPACT_SLOT_BITS)
+#define COMPACT_BUCKET(key) ((uint32_t) ((key) * 0x9e3779b1u) >> (32 - COMPACT_BUCKET_BITS))
+#define COMPACT_SLOT(key) ((uint32_t) ((key) * 0x85ebca6bu) >> (32 - COMPACT_SLOT_BITS))
+#define COMPACT_INDEX(key) (COMPACT_SLOT(key) ^ Rank_Displace[COMPACT_BUCKET(key)])
+
+#ifdef COMPACT_RANKS
+#define RANK_LOOKUP(key) Rank_Compact[COMPACT_INDEX(key)]
+#else
+#define RANK_LOOKUP(key) Rank_Table[key]
+#endif
+
+//8 or better lows of 5 to 7 cards by their rank key (see low.c)
+#define NUM_LOWS 56
+#define LOW_LOOKUP(n, key) \
+    Low_Compact[(n) - 5][COMPACT_SLOT(key) ^ Low_Displace[(n) - 5][COMPACT_BUCKET(key)]]
+
+//load_tables flags
+#define TABLE_PREFAULT 1
+#define TABLE_HUGEPAGES 2
+
+//where checksum starts (see table_file.c)
+#define CHECKSUM_SEED 0xcbf29ce484222325ULL
+
+//cluster_histograms metrics
+#define METRIC_L2 0
+#define METRIC_EMD 1
+
+//what iso_index returns for bad cards
+#define ISO_FAIL UINT64_MAX
+
+//the entry points stats counts (see stats.c)
+#define STAT_HANDVALUE 0
+#define STAT_HANDRANKS 1
+#define STAT_HOLDEM2P 2
+#define STAT_MULTI_HOLDEM 3
+#define STAT_RIVERVALUE 4
+#define STAT_RIVERTIES 5
+#define STAT_FULL_ENUMERATION 6
+#define STAT_HEADSUP_COUNTS 7
+#define STAT_MONTE_CARLO 8
+#define STAT_RIVER_DISTRIBUTION 9
+#define STAT_HOLDEM_HANDRANKS 10
+#define STAT_BEST5_RANK 11
+#define STAT_BEST5_RANKS 12
+#define STAT_LOW_RANK 13
+#define STAT_LOW_RANKS 14
+#define STAT_OMAHA_RANK 15
+#define STAT_MULTI_OMAHA 16
+#define STAT_OMAHA_ENUMERATION 17
+#define STAT_OMAHA_MONTE_CARLO 18
+#define STAT_OMAHA_LOW 19
+#define STAT_MULTI_OMAHA_HILO 20
+#define STAT_OMAHA_HILO_ENUMERATION 21
+#define STAT_SHORT_RANK 22
+#define STAT_SHORT_RIVERVALUE 23
+#define STAT_SHORT_ENUMERATION 24
+#define STAT_SHORT_MONTE_CARLO 25
+#define STAT_RANGE_EQUITY 26
+#define STAT_HAND_STRENGTH 27
+#define STAT_HAND_STRENGTHS 28
+#define STAT_EQUITY_HISTOGRAMS 29
+#define STAT_PREFLOP_EQUITY 30
+#define NUM_STATS 31
+//calls taking [2^i, 2^(i+1)) ns, the last taking longer too
+#define LATENCY_BUCKETS 32
+
 #define GET_RANK(c) (1 << (c >> 2))
 #define GET_SUIT(c) ((c % 4) * 13)
+//bit c for card c, unlike Bits which groups cards by suit
+#define CARD_BIT(c) (1ULL << (c))
 
 
 struct rivervalue{
@@ -44,6 +138,84 @@ typedef struct{
 } partial;
 
 
+//strengths of n hands that add the Deck sums in keys and card bits in
+//addbits to a common partial hand's key and bits (see rank_keys.c)
+typedef void (*rank_keys_fn)(uint32_t key, uint64_t bits, const uint32_t *keys,
+                             const uint64_t *addbits, int n, uint16_t *out);
+extern rank_keys_fn rank_keys;
+
+//the cards left to deal for one caller (see deal.c)
+typedef struct{
+    uint32_t cards[52];
+    int size;
+    uint64_t state[4];
+}deck;
+
+//a hand's strength on a board (see hand_strengths)
+typedef struct{
+    double hs, ehs, ehs2, ppot, npot;
+}strength;
+
+//a hand's part of hi/lo split pots (see omaha_hilo_enumeration)
+typedef struct{
+    double ev, hi, lo, scoop;
+}hilo;
+
+//a table of buckets cluster_histograms wrote, mapped by load_buckets
+//(see abstraction.c)
+typedef struct{
+    int nboard;
+    int nbuckets;
+    uint32_t first;         //the board classes it covers
+    uint32_t nclasses;
+    uint32_t ncombos;       //per class
+    const uint16_t *buckets;
+    void *map;
+    size_t mapsize;
+}bucket_table;
+
+//what stats counts, per thread and in total (see stats.c)
+typedef struct{
+    uint64_t calls[NUM_STATS];
+    uint64_t hands_given[NUM_STATS];    //hands passed in, not evaluated
+    uint64_t latency[NUM_STATS][LATENCY_BUCKETS];
+    uint64_t ranked;        //hands dohand and rank_keys ranked
+    uint64_t flushes;       //of those, on the flush path
+}stats;
+
+typedef struct stats_block{
+    stats counts;
+    bool shared;            //counted into by threads without their own
+    struct stats_block *prev, *next;
+}stats_block;
+
+//only the thread owning a count adds to it, and readers may see it
+//between adds, so a relaxed store does, except in the shared block
+#define STATS_BUMP(block, field, n) do{ \
+        if ((block)->shared) \
+            __atomic_fetch_add(&(block)->counts.field, (n), __ATOMIC_RELAXED); \
+        else \
+            __atomic_store_n(&(block)->counts.field, (block)->counts.field + (n), __ATOMIC_RELAXED); \
+    }while (0)
+
+#ifdef COLLECT_STATS
+extern const char *const Stat_Names[NUM_STATS];
+extern __thread stats_block *Local_Stats;
+#define STATS_ADD(field, n) do{ \
+        stats_block *s_ = Local_Stats ? Local_Stats : new_local_stats(); \
+        STATS_BUMP(s_, field, n); \
+    }while (0)
+#define STATS_START(t) uint64_t t = stats_clock()
+#define STATS_CALL(entry, t, nhands) stats_call(entry, t, nhands)
+#else
+#define STATS_ADD(field, n) ((void) 0)
+#define STATS_START(t)
+#define STATS_CALL(entry, t, nhands) ((void) 0)
+#endif
+
+//one unit of work for run_tasks (see tasks.c)
+typedef void (*task_fn)(void *shared, void *local, int task);
+
 typedef
 struct{
     int hand[2];
@@ -53,14 +225,95 @@ struct{
 
 int holdem2p(uint32_t h1[2], uint32_t h2[2], uint32_t board[5]);
 int multi_holdem(uint32_t [MAX_HANDS][2], int, uint32_t [5], int []);
+int set_dead(void *cards1_, int n1, void *cards2_, int n2, bool dead[52]);
+uint32_t best5_value(const uint32_t cards[], int n);
+bool init_best5(void);
+int best5_rank(const uint32_t cards[], int n);
+int best5_rank_batch(const uint32_t *hands, int n, int ncards, uint16_t *out);
 uint64_t handvalue(uint32_t hand[7]);
+int rank_batch(const uint32_t *hands, int n, uint16_t *out);
+int holdem_rank_batch(const uint32_t *holes, const uint32_t *boards, int n, uint16_t *out);
 struct rivervalue rivervalue (uint32_t hand[2], uint32_t board[5]);
-double enum2p(uint32_t h1[2], uint32_t h2[2]);
-int full_enumeration(uint32_t [MAX_HANDS][2], int, uint32_t [5], int, double []);
-int monte_carlo(uint32_t [MAX_HANDS][2], int, int, double []);
+int headsup_counts(uint32_t h1[2], uint32_t h2[2], uint64_t counts[3], int nthreads);
+int headsup_board_counts(uint32_t h1[2], uint32_t h2[2], uint32_t board[5], int nboard,
+                         uint64_t counts[3]);
+double enum2p(uint32_t h1[2], uint32_t h2[2], int nthreads);
+int full_enumeration(uint32_t [MAX_HANDS][2], int, uint32_t [5], int, double [], int nthreads);
+int range_equity(const double *weights[], int nranges, uint32_t board[5], int nboard,
+                 double results[], int nthreads);
+int hand_strengths(uint32_t board[5], int nboard, uint32_t hand[2], strength results[], int nthreads);
+int equity_histograms(uint32_t board[5], int nboard, int nbins, uint32_t hist[], int nthreads);
+int monte_carlo(uint32_t [MAX_HANDS][2], int, uint32_t board[5], int nboard,
+                uint32_t deadcards[], int ndead, int nruns, double target_se,
+                double results[], double stderrs[], uint64_t seed, int nthreads);
+int omaha_rank(const uint32_t hole[], int nhole, const uint32_t board[], int nboard);
+int multi_omaha(const uint32_t *holes, int nhole, int nhands, const uint32_t board[5], int winners[]);
+int omaha_enumeration(const uint32_t *holes, int nhole, int nhands, uint32_t board[5], int nboard,
+                      double results[], int nthreads);
+int omaha_monte_carlo(const uint32_t *holes, int nhole, int nhands, uint32_t board[5], int nboard,
+                      uint32_t deadcards[], int ndead, int nruns, double target_se,
+                      double results[], double stderrs[], uint64_t seed, int nthreads);
+bool init_short_deck(void);
+int set_short_dead(const uint32_t *cards1, int n1, const uint32_t *cards2, int n2, bool dead[52]);
+int short_rank(const uint32_t cards[7]);
+int multi_short(uint32_t hands[][2], int n, const uint32_t board[5], int winners[]);
+struct rivervalue short_rivervalue(uint32_t hand[2], uint32_t board[5]);
+int short_enumeration(uint32_t hands[][2], int nhands, uint32_t board[5], int nboard,
+                      double results[], int nthreads);
+int short_monte_carlo(uint32_t hands[MAX_HANDS][2], int nhands, uint32_t board[5], int nboard,
+                      uint32_t deadcards[], int ndead, int nruns, double target_se,
+                      double results[], double stderrs[], uint64_t seed, int nthreads);
+bool init_lows(void);
+int low_rank(const uint32_t cards[], int n);
+int low_rank_batch(const uint32_t *hands, int n, int ncards, uint16_t *out);
+int omaha_low(const uint32_t hole[], int nhole, const uint32_t board[], int nboard);
+int multi_omaha_hilo(const uint32_t *holes, int nhole, int nhands, const uint32_t board[5],
+                     int hiwinners[], int lowinners[], int *nlow);
+int omaha_hilo_enumeration(const uint32_t *holes, int nhole, int nhands, uint32_t board[5], int nboard,
+                           hilo results[], int nthreads);
+uint64_t random_seed(void);
+int initdeck(deck *d, bool dead[52], uint64_t seed);
+void jumpdeck(deck *d);
+double random_unit(deck *d);
+int deal(deck *d, uint32_t cards[], int n);
 int river_distribution (uint32_t hand[2], uint32_t board[5], int chart[], dictEntry *dict);
+int ochs(uint32_t hands[][2], int nhands, uint32_t board[5], int nboard,
+         const dictEntry *dict, int ngroups, double results[], int nthreads);
 void populate_tables(uint16_t ranktable[RANK_TABLE_SIZE],
                      uint16_t flushtable[FLUSH_TABLE_SIZE],
                      const uint16_t straighttable[FLUSH_TABLE_SIZE]);
+bool init_rank_keys(void);
+int build_compact_table(const uint16_t ranktable[RANK_TABLE_SIZE]);
+int build_compact_hash(const uint32_t *keys, const uint16_t *values, int nkeys,
+                       uint16_t displace[COMPACT_BUCKETS], uint16_t compact[COMPACT_SLOTS]);
+int save_tables(const char *path);
+int load_tables(const char *path, int flags);
+bool init_tables(void);
+int preflop_classes(const uint32_t **keys);
+int build_preflop_counts(uint32_t *counts, const uint32_t *matchups, int nmatchups, int nthreads);
+void set_preflop_counts(const uint32_t *counts);
+int preflop_lookup(const uint32_t h1[2], const uint32_t h2[2], uint64_t counts[3]);
+int save_preflop_table(const char *path, const uint32_t *matchups, int nmatchups, int nthreads);
+int load_preflop_table(const char *path);
+int board_classes(int nboard, const uint32_t **boards, const uint32_t **weights);
+int board_class(const uint32_t board[], int nboard, uint32_t hand[2]);
+int save_histograms(const char *path, int nboard, int nbins, int first, int count, int nthreads);
+double cluster_histograms(const char *hist_path, const char *bucket_path, int k, int metric,
+                          int iterations, uint64_t seed, int nthreads);
+int load_buckets(const char *path, bucket_table *table);
+void free_buckets(bucket_table *table);
+int bucket_lookup(const bucket_table *table, const uint32_t hand[2], const uint32_t board[]);
+uint64_t iso_size(int nboard);
+uint64_t iso_index(const uint32_t cards[], int nboard);
+int iso_unindex(uint64_t index, int nboard, uint32_t cards[]);
+int iso_index_batch(const uint32_t *cards, int n, int nboard, uint64_t *out);
+uint64_t checksum(const void *data, size_t n, uint64_t h);
+stats_block *new_local_stats(void);
+uint64_t stats_clock(void);
+void stats_call(int entry, uint64_t start, uint64_t nhands);
+void read_stats(stats *out);
+void reset_stats(void);
+int task_threads(int nthreads, int ntasks);
+void run_tasks(task_fn fn, void *shared, void *locals, size_t localsize, int ntasks, int nthreads);
 
 #endif
@@ -0,0 +1,265 @@
+// Copyright 2013 Allen Boyd Cunningham
+
+// This file is part of pokyr.
+
+//     pokyr is free software: you can redistribute it and/or modify
+//     it under the terms of the GNU General Public License as published by
+//     the Free Software Foundation, either version 3 of the License, or
+//     (at your option) any later version.
+//     pokyr is distributed in the hope that it will be useful,
+//     but WITHOUT ANY WARRANTY; without even the implied warranty of
+//     MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//     GNU General Public License for more details.
+
+//     You should have received a copy of the GNU General Public License
+//     along with pokyr.  If not, see <http://www.gnu.org/licenses/>.
+
+
+#include "poker_heavy.h"
+
+#include <pthread.h>
+#include <string.h>
+
+//the heads-up preflop table holds the first hand's wins and ties for
+//one matchup of each suit class.  Two matchups are in the same class
+//when relabeling suits (and maybe swapping the hands) turns one into
+//the other.  A class is named by its smallest key over every relabeling
+//and order, where a key packs the four cards 6 bits each, first hand
+//first and each hand's lower card first.
+//
+//Every matchup of two combos maps to its class and whether its hands
+//are swapped relative to the class key, so a lookup is two reads.
+
+#define COMBO_INDEX(c1, c2) ((c1) * 52 - (c1) * ((c1) + 1) / 2 + (c2) - (c1) - 1)
+#define PAIRS_BELOW(n) ((n) * ((n) - 1) / 2)
+#define NO_CLASS 0xffffffffu
+//the wins of a class a partial table leaves out
+#define MISSING_COUNTS 0xffffffffu
+
+typedef struct{
+    int nclasses;
+    uint32_t *keys;     //sorted
+    uint32_t *map;      //class << 1 | swapped, by pair of combos
+}class_list;
+
+static class_list Classes;
+static pthread_once_t Classes_Once = PTHREAD_ONCE_INIT;
+
+//wins and ties of each class, NULL until a table is loaded
+static const uint32_t *Preflop_Counts = NULL;
+
+
+static uint32_t pack_hand(uint32_t c1, uint32_t c2){
+    return (c1 < c2) ? (c1 << 6 | c2) : (c2 << 6 | c1);
+}
+
+
+//the class key of h1 vs h2, and whether the key has h2 first
+static uint32_t canonical_matchup(const uint32_t h1[2], const uint32_t h2[2], bool *swapped){
+    static const uint8_t perms[24][4] = {
+        {0,1,2,3}, {0,1,3,2}, {0,2,1,3}, {0,2,3,1}, {0,3,1,2}, {0,3,2,1},
+        {1,0,2,3}, {1,0,3,2}, {1,2,0,3}, {1,2,3,0}, {1,3,0,2}, {1,3,2,0},
+        {2,0,1,3}, {2,0,3,1}, {2,1,0,3}, {2,1,3,0}, {2,3,0,1}, {2,3,1,0},
+        {3,0,1,2}, {3,0,2,1}, {3,1,0,2}, {3,1,2,0}, {3,2,0,1}, {3,2,1,0}
+    };
+    uint32_t a, b, key, best = NO_CLASS;
+    const uint8_t *p;
+    int i;
+
+    *swapped = false;
+    for (i = 0; i < 24; i++){
+        p = perms[i];
+        a = pack_hand((h1[0] & ~3u) | p[h1[0] & 3], (h1[1] & ~3u) | p[h1[1] & 3]);
+        b = pack_hand((h2[0] & ~3u) | p[h2[0] & 3], (h2[1] & ~3u) | p[h2[1] & 3]);
+        if ( (key = a << 12 | b) < best ){
+            best = key;
+            *swapped = false;
+        }
+        if ( (key = b << 12 | a) < best ){
+            best = key;
+            *swapped = true;
+        }
+    }
+    return best;
+}
+
+
+static int compare_keys(const void *a, const void *b){
+    uint32_t x = *(const uint32_t *) a, y = *(const uint32_t *) b;
+    return (x > y) - (x < y);
+}
+
+
+static void build_classes(void){
+    uint32_t combos[NUM_STARTING_HANDS][2], *keys, *found, key;
+    int i, j, n = 0, npairs = PAIRS_BELOW(NUM_STARTING_HANDS);
+    bool swapped;
+
+    for (i = 0; i < 52; i++){
+        for (j = i + 1; j < 52; j++, n++){
+            combos[n][0] = i;
+            combos[n][1] = j;
+        }
+    }
+    Classes.keys = (uint32_t *) malloc(npairs * sizeof(uint32_t));
+    Classes.map = (uint32_t *) malloc(npairs * sizeof(uint32_t));
+    if ( (keys = (uint32_t *) malloc(npairs * sizeof(uint32_t))) == NULL || !Classes.keys || !Classes.map ){
+        free(keys);
+        free(Classes.keys);
+        free(Classes.map);
+        Classes.keys = Classes.map = NULL;
+        return;
+    }
+
+    //the key of every pair of disjoint combos, then the distinct ones
+    for (j = 1, n = 0; j < NUM_STARTING_HANDS; j++){
+        for (i = 0; i < j; i++, n++){
+            if (combos[i][0] == combos[j][0] || combos[i][0] == combos[j][1] ||
+                combos[i][1] == combos[j][0] || combos[i][1] == combos[j][1])
+                Classes.map[n] = NO_CLASS;
+            else
+                Classes.map[n] = keys[n] = canonical_matchup(combos[i], combos[j], &swapped) << 1 | swapped;
+        }
+    }
+    for (n = 0, i = 0; n < npairs; n++){
+        if (Classes.map[n] != NO_CLASS)
+            Classes.keys[i++] = keys[n] >> 1;
+    }
+    qsort(Classes.keys, i, sizeof(uint32_t), compare_keys);
+    for (n = 1, j = 1; n < i; n++){
+        if (Classes.keys[n] != Classes.keys[j - 1])
+            Classes.keys[j++] = Classes.keys[n];
+    }
+    Classes.nclasses = j;
+
+    for (n = 0; n < npairs; n++){
+        if (Classes.map[n] == NO_CLASS)
+            continue;
+        key = keys[n] >> 1;
+        found = (uint32_t *) bsearch(&key, Classes.keys, Classes.nclasses, sizeof(uint32_t), compare_keys);
+        Classes.map[n] = (uint32_t) (found - Classes.keys) << 1 | (keys[n] & 1);
+    }
+    free(keys);
+}
+
+
+//the number of matchup classes, with their sorted keys in keys
+//Return FAIL if there wasn't memory to list them
+int preflop_classes(const uint32_t **keys){
+    pthread_once(&Classes_Once, build_classes);
+    if (!Classes.map)
+        return FAIL;
+    *keys = Classes.keys;
+    return Classes.nclasses;
+}
+
+
+//the class of the matchup h1 against h2, shifted up with whether its
+//hands are swapped relative to the class key in the low bit
+//Return NO_CLASS if the cards aren't 4 different ones
+static uint32_t matchup_entry(const uint32_t h1[2], const uint32_t h2[2]){
+    uint32_t x, y, swap;
+
+    if (h1[0] > 51 || h1[1] > 51 || h2[0] > 51 || h2[1] > 51 ||
+        h1[0] == h1[1] || h2[0] == h2[1])
+        return NO_CLASS;
+
+    x = (h1[0] < h1[1]) ? COMBO_INDEX(h1[0], h1[1]) : COMBO_INDEX(h1[1], h1[0]);
+    y = (h2[0] < h2[1]) ? COMBO_INDEX(h2[0], h2[1]) : COMBO_INDEX(h2[1], h2[0]);
+    if (x == y)
+        return NO_CLASS;
+    if (x > y){
+        swap = Classes.map[PAIRS_BELOW(x) + y];
+        return (swap == NO_CLASS) ? NO_CLASS : swap ^ 1;
+    }
+    return Classes.map[PAIRS_BELOW(y) + x];
+}
+
+
+typedef struct{
+    const uint32_t *keys;
+    const bool *wanted;
+    uint32_t *counts;
+}preflop_job;
+
+
+static void preflop_task(void *shared, void *local, int task){
+    const preflop_job *job = (const preflop_job *) shared;
+    uint32_t key = job->keys[task];
+    uint32_t h1[2] = {key >> 18, (key >> 12) & 63}, h2[2] = {(key >> 6) & 63, key & 63};
+    uint64_t counts[3];
+    (void) local;
+
+    if (job->wanted && !job->wanted[task]){
+        job->counts[2 * task] = MISSING_COUNTS;
+        job->counts[2 * task + 1] = 0;
+        return;
+    }
+    headsup_counts(h1, h2, counts, 1);
+    job->counts[2 * task] = (uint32_t) counts[0];
+    job->counts[2 * task + 1] = (uint32_t) counts[2];
+}
+
+
+//fill counts with the wins and ties of every class's first hand, or
+//only of the classes of the nmatchups matchups (rows of 4 cards, the
+//first hand's then the second's) when matchups isn't NULL, marking
+//the rest missing so lookups of them fail
+//nthreads workers share the classes (see run_tasks)
+//Return FAIL for bad or duplicate cards in a matchup
+int build_preflop_counts(uint32_t *counts, const uint32_t *matchups, int nmatchups, int nthreads){
+    preflop_job job;
+    bool *wanted = NULL;
+    uint32_t entry;
+    int i, nclasses;
+
+    if ( (nclasses = preflop_classes(&job.keys)) == FAIL )
+        return FAIL;
+    if (matchups){
+        if ( (wanted = (bool *) calloc(nclasses, sizeof(bool))) == NULL )
+            return FAIL;
+        for (i = 0; i < nmatchups; i++){
+            if ( (entry = matchup_entry(matchups + 4 * i, matchups + 4 * i + 2)) == NO_CLASS ){
+                free(wanted);
+                return FAIL;
+            }
+            wanted[entry >> 1] = true;
+        }
+    }
+    job.wanted = wanted;
+    job.counts = counts;
+    run_tasks(preflop_task, &job, NULL, 0, nclasses, nthreads);
+    free(wanted);
+    return SUCCESS;
+}
+
+
+//use counts (2 per class, which the caller keeps alive) for lookups
+//from now on, or stop using a table if counts is NULL
+void set_preflop_counts(const uint32_t *counts){
+    __atomic_store_n(&Preflop_Counts, counts, __ATOMIC_RELEASE);
+}
+
+
+//fill counts with h1 wins, h2 wins and ties from the loaded table
+//Return FAIL if no table is loaded, the cards aren't 4 different ones
+//or the table leaves the matchup out
+int preflop_lookup(const uint32_t h1[2], const uint32_t h2[2], uint64_t counts[3]){
+    const uint32_t *table = __atomic_load_n(&Preflop_Counts, __ATOMIC_ACQUIRE);
+    uint32_t entry, wins, ties, losses;
+    bool flip;
+
+    if (!table || (entry = matchup_entry(h1, h2)) == NO_CLASS)
+        return FAIL;
+
+    flip = entry & 1;
+    wins = table[2 * (entry >> 1)];
+    ties = table[2 * (entry >> 1) + 1];
+    if (wins == MISSING_COUNTS)
+        return FAIL;
+    losses = PREFLOP_BOARDS - wins - ties;
+    counts[0] = flip ? losses : wins;
+    counts[1] = flip ? wins : losses;
+    counts[2] = ties;
+    return SUCCESS;
+}
@@ -0,0 +1,152 @@
+// Copyright 2013 Allen Boyd Cunningham
+
+// This file is part of pokyr.
+
+//     pokyr is free software: you can redistribute it and/or modify
+//     it under the terms of the GNU General Public License as published by
+//     the Free Software Foundation, either version 3 of the License, or
+//     (at your option) any later version.
+//     pokyr is distributed in the hope that it will be useful,
+//     but WITHOUT ANY WARRANTY; without even the implied warranty of
+//     MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//     GNU General Public License for more details.
+
+//     You should have received a copy of the GNU General Public License
+//     along with pokyr.  If not, see <http://www.gnu.org/licenses/>.
+
+
+#include "poker_heavy.h"
+
+#include <string.h>
+
+//rank_keys ranks many hands that share a partial hand at once: out[i]
+//is the strength of the cards summed in key and bits plus the cards
+//summed in keys[i] and addbits[i].  The enumerators call it with the
+//last one or two runout cards as the additions.
+//
+//The AVX2 version does 8 hands per step with gathers from the rank
+//table and leaves the (rare) flushes to scalar code.  It is picked at
+//init when the cpu has AVX2 and POKYR_SIMD isn't "0".
+
+extern uint16_t *Rank_Table;
+extern uint16_t Rank_Displace[COMPACT_BUCKETS + 1];
+extern uint16_t Rank_Compact[COMPACT_SLOTS + 1];
+extern uint16_t Flush_Table[FLUSH_TABLE_SIZE];
+extern const int8_t isFlushTable[400];
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define HAVE_AVX2_KERNEL
+#include <immintrin.h>
+#endif
+
+
+static void rank_keys_scalar(uint32_t key, uint64_t bits, const uint32_t *keys,
+                             const uint64_t *addbits, int n, uint16_t *out){
+    uint32_t val;
+    int i, shift;
+
+    STATS_ADD(ranked, n);
+    for (i = 0; i < n; i++){
+        val = key + keys[i];
+        if ( (shift = isFlushTable[val >> SUITSHIFT]) != FAIL ){
+            STATS_ADD(flushes, 1);
+            out[i] = Flush_Table[((bits + addbits[i]) >> shift) & CARD_MASK];
+        }
+        else
+            out[i] = RANK_LOOKUP(val & RANKMASK);
+    }
+}
+
+
+#ifdef HAVE_AVX2_KERNEL
+
+//isFlushTable widened for 32 bit gathers
+static int32_t Flush_Shift[400];
+
+//gather 8 uint16 table entries as 32 bit lanes
+//reading from one entry back puts each wanted entry in the high half
+//without reading past the end of the table, which is safe as long as
+//no index is 0 (true of every rank sum, the smallest being 4 deuces
+//and 3 treys)
+#define GATHER16(table, idx) \
+    _mm256_srli_epi32(_mm256_i32gather_epi32((const int *) ((table) - 1), (idx), 2), 16)
+
+__attribute__((target("avx2")))
+static void rank_keys_avx2(uint32_t key, uint64_t bits, const uint32_t *keys,
+                           const uint64_t *addbits, int n, uint16_t *out){
+    const __m256i base = _mm256_set1_epi32((int) key);
+    const __m256i rankmask = _mm256_set1_epi32(RANKMASK);
+    const __m256i none = _mm256_set1_epi32(FAIL);
+    const uint16_t *ranktable = Rank_Table;
+    __m256i k, shifts, vals, packed;
+    uint32_t val;
+    int i, j, flushes;
+
+    #ifdef COMPACT_RANKS
+    const __m256i mult1 = _mm256_set1_epi32((int) 0x9e3779b1u);
+    const __m256i mult2 = _mm256_set1_epi32((int) 0x85ebca6bu);
+    __m256i bucket, slot;
+    (void) ranktable;
+    #endif
+
+    for (i = 0; i + 8 <= n; i += 8){
+        k = _mm256_add_epi32(base, _mm256_loadu_si256((const __m256i *) (keys + i)));
+        shifts = _mm256_i32gather_epi32(Flush_Shift, _mm256_srli_epi32(k, SUITSHIFT), 4);
+        flushes = _mm256_movemask_ps(_mm256_castsi256_ps(_mm256_cmpgt_epi32(shifts, none)));
+        STATS_ADD(ranked, 8);
+        STATS_ADD(flushes, __builtin_popcount(flushes));
+        k = _mm256_and_si256(k, rankmask);
+
+        #ifdef COMPACT_RANKS
+        bucket = _mm256_srli_epi32(_mm256_mullo_epi32(k, mult1), 32 - COMPACT_BUCKET_BITS);
+        slot = _mm256_srli_epi32(_mm256_mullo_epi32(k, mult2), 32 - COMPACT_SLOT_BITS);
+        //buckets and slots can be 0, so read forward and mask instead
+        bucket = _mm256_and_si256(_mm256_i32gather_epi32((const int *) Rank_Displace, bucket, 2),
+                                  _mm256_set1_epi32(0xffff));
+        vals = _mm256_and_si256(_mm256_i32gather_epi32((const int *) Rank_Compact,
+                                                       _mm256_xor_si256(slot, bucket), 2),
+                                _mm256_set1_epi32(0xffff));
+        #else
+        vals = GATHER16(ranktable, k);
+        #endif
+
+        packed = _mm256_permute4x64_epi64(_mm256_packus_epi32(vals, vals), 0x08);
+        _mm_storeu_si128((__m128i *) (out + i), _mm256_castsi256_si128(packed));
+
+        for (j = 0; flushes; j++, flushes >>= 1){
+            if (flushes & 1){
+                val = key + keys[i + j];
+                out[i + j] = Flush_Table[((bits + addbits[i + j]) >> isFlushTable[val >> SUITSHIFT]) & CARD_MASK];
+            }
+        }
+    }
+    rank_keys_scalar(key, bits, keys + i, addbits + i, n - i, out + i);
+}
+
+#endif
+
+
+rank_keys_fn rank_keys = rank_keys_scalar;
+
+
+//pick the fastest rank_keys the cpu supports
+//Return true if that is a vector version
+bool init_rank_keys(void){
+    const char *env = getenv("POKYR_SIMD");
+
+    rank_keys = rank_keys_scalar;
+    if (env && strcmp(env, "0") == 0)
+        return false;
+
+    #ifdef HAVE_AVX2_KERNEL
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx2")){
+        int i;
+        for (i = 0; i < 400; i++)
+            Flush_Shift[i] = isFlushTable[i];
+        rank_keys = rank_keys_avx2;
+        return true;
+    }
+    #endif
+    return false;
+}
@@ -0,0 +1,460 @@
+// Copyright 2013 Allen Boyd Cunningham
+
+// This file is part of pokyr.
+
+//     pokyr is free software: you can redistribute it and/or modify
+//     it under the terms of the GNU General Public License as published by
+//     the Free Software Foundation, either version 3 of the License, or
+//     (at your option) any later version.
+//     pokyr is distributed in the hope that it will be useful,
+//     but WITHOUT ANY WARRANTY; without even the implied warranty of
+//     MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//     GNU General Public License for more details.
+
+//     You should have received a copy of the GNU General Public License
+//     along with pokyr.  If not, see <http://www.gnu.org/licenses/>.
+
+
+#include "poker_heavy.h"
+
+#include <pthread.h>
+#include <string.h>
+
+//Short deck (6+) hold'em deals from the 36 cards ace to six, which are
+//cards 0-35 as they are.  A-6-7-8-9 is the lowest straight and a flush
+//beats a full house.
+//
+//The ranks a short deck has get the 9 smallest specialK numbers, so the
+//Deck sums of 7 of its cards are below SHORT_TABLE_SIZE, and the rank
+//table is 230 KB instead of 15 MB.  It is built like populate_tables
+//builds the full one: each rank combination of 7 cards, and each flush,
+//is valued once and the values are ranked densely.  Flushes are looked
+//up by the 9 rank bits of their suit.
+
+//DECK = [r | (s << SUITSHIFT) for r in SPECIALKS for s in (0, 1, 8, 57)]
+static const uint32_t Deck[52] = DECK;
+extern const uint64_t Bits[52];
+extern const int8_t isFlushTable[400];
+
+//rank combinations of 7 cards from 9 ranks, no more than 4 of a rank
+#define NUM_SHORT_COMBOS 6030
+//the ranks of a suit in Bits, from the ace down
+#define SHORT_FLUSH_SHIFT 4
+#define SHORT_FLUSH_MASK 0x1ff
+
+static uint16_t Short_Ranks[SHORT_TABLE_SIZE];
+static uint16_t Short_Flush[SHORT_FLUSH_MASK + 1];
+
+static bool Short_Ready = false;
+static pthread_once_t Short_Once = PTHREAD_ONCE_INIT;
+
+
+//a value that orders 7 card short deck hands
+//categories go in bits 26 up, then up to two paired ranks 4 bits
+//each, then a bit per kicker rank
+static uint32_t short_value(const uint32_t cards[7]){
+    int counts[9] = {0}, suits[4] = {0};
+    uint32_t suitbits[4] = {0, 0, 0, 0}, rankbits = 0, kickers, bits, value;
+    int i, r, flush = -1, quads = -1, trips = -1, pair1 = -1, pair2 = -1, high, nkickers;
+
+    for (i = 0; i < 7; i++){
+        r = 8 - (int) (cards[i] >> 2);      //6 is 0 and A is 8
+        counts[r]++;
+        suitbits[cards[i] & 3] |= 1u << r;
+        rankbits |= 1u << r;
+        if (++suits[cards[i] & 3] == 5)
+            flush = cards[i] & 3;
+    }
+
+    //the high card of the best straight in bits, or -1
+    #define STRAIGHT_HIGH(bits, high) \
+        for (high = 8; high >= 4 && ((bits) >> (high - 4) & 0x1f) != 0x1f; high--); \
+        if (high < 4) \
+            high = (((bits) & 0x10f) == 0x10f) ? 3 : -1;
+
+    if (flush != -1){
+        STRAIGHT_HIGH(suitbits[flush], high)
+        if (high != -1)
+            return 8u << 26 | high;
+    }
+    for (r = 8; r >= 0; r--){
+        if (counts[r] == 4 && quads == -1)
+            quads = r;
+        else if (counts[r] == 3 && trips == -1)
+            trips = r;
+        else if (counts[r] >= 2 && pair1 == -1)
+            pair1 = r;
+        else if (counts[r] >= 2 && pair2 == -1)
+            pair2 = r;
+    }
+    if (quads != -1){
+        for (r = 8; r == quads || !counts[r]; r--);
+        return 7u << 26 | quads << 22 | 1u << r;
+    }
+    if (flush != -1){
+        for (bits = suitbits[flush]; __builtin_popcount(bits) > 5; bits &= bits - 1);
+        return 6u << 26 | bits;
+    }
+    if (trips != -1){
+        //a second set of trips plays as the pair
+        for (r = 8; r >= 0 && (r == trips || counts[r] < 2); r--);
+        if (r >= 0)
+            return 5u << 26 | trips << 22 | r << 18;
+    }
+    STRAIGHT_HIGH(rankbits, high)
+    #undef STRAIGHT_HIGH
+    if (high != -1)
+        return 4u << 26 | high;
+
+    if (trips != -1){
+        kickers = rankbits & ~(1u << trips);
+        nkickers = 2;
+        value = 3u << 26 | trips << 22;
+    }
+    else if (pair2 != -1){
+        kickers = rankbits & ~(1u << pair1) & ~(1u << pair2);
+        nkickers = 1;
+        value = 2u << 26 | pair1 << 22 | pair2 << 18;
+    }
+    else if (pair1 != -1){
+        kickers = rankbits & ~(1u << pair1);
+        nkickers = 3;
+        value = 1u << 26 | pair1 << 22;
+    }
+    else{
+        kickers = rankbits;
+        nkickers = 5;
+        value = 0;
+    }
+    while (__builtin_popcount(kickers) > nkickers)
+        kickers &= kickers - 1;
+    return value | kickers;
+}
+
+
+static int compare_values(const void *a, const void *b){
+    uint32_t x = *(const uint32_t *) a, y = *(const uint32_t *) b;
+    return (x > y) - (x < y);
+}
+
+
+//append the Deck sum and value of every rank combination of 7 cards to
+//keys and values, with cards[0..k) chosen and same of them of rank r
+static int walk_combos(uint32_t *keys, uint32_t *values, int count, uint32_t cards[7], int k,
+                       uint32_t r, int same){
+    int i;
+
+    if (k == 7){
+        for (i = 0, keys[count] = 0; i < 7; i++)
+            keys[count] += Deck[cards[i]] & RANKMASK;
+        values[count] = short_value(cards);
+        return count + 1;
+    }
+    for (; r < 9; r++, same = 0){
+        if (same == 4)
+            continue;
+        //the suits go round, so the cards never flush
+        cards[k] = r << 2 | (k & 3);
+        count = walk_combos(keys, values, count, cards, k + 1, r, same + 1);
+    }
+    return count;
+}
+
+
+//the value of the flush of the ranks in mask (5 to 7 of them)
+static uint32_t flush_value(uint32_t mask){
+    uint32_t cards[7];
+    int r, n = 0, offsuit = 1;
+
+    for (r = 0; r < 9; r++){
+        if (mask >> (8 - r) & 1)
+            cards[n++] = (uint32_t) r << 2;
+    }
+    //fill up with cards of other suits that can't pair the flush
+    //into anything better
+    for (r = 0; n < 7; r++){
+        if (!(mask >> (8 - r) & 1))
+            cards[n++] = (uint32_t) r << 2 | offsuit++;
+    }
+    return short_value(cards);
+}
+
+
+static void build_short(void){
+    uint32_t keys[NUM_SHORT_COMBOS], *values, cards[7], mask, *found;
+    int i, nvalues, ndistinct;
+
+    if ( (values = (uint32_t *) malloc((NUM_SHORT_COMBOS * 2 + SHORT_FLUSH_MASK + 1) * sizeof(uint32_t))) == NULL )
+        return;
+
+    //the scale: every rank combination and flush, in order, once each
+    if (walk_combos(keys, values, 0, cards, 0, 0, 0) != NUM_SHORT_COMBOS)
+        goto done;
+    nvalues = NUM_SHORT_COMBOS;
+    for (mask = 0; mask <= SHORT_FLUSH_MASK; mask++){
+        if (__builtin_popcount(mask) >= 5)
+            values[nvalues++] = flush_value(mask);
+    }
+    memcpy(values + nvalues, values, NUM_SHORT_COMBOS * sizeof(uint32_t));
+    qsort(values, nvalues, sizeof(uint32_t), compare_values);
+    for (i = 1, ndistinct = 1; i < nvalues; i++){
+        if (values[i] != values[ndistinct - 1])
+            values[ndistinct++] = values[i];
+    }
+
+    //the combos' values were saved after the scale
+    for (i = 0; i < NUM_SHORT_COMBOS; i++){
+        found = (uint32_t *) bsearch(values + nvalues + i, values, ndistinct, sizeof(uint32_t),
+                                     compare_values);
+        Short_Ranks[keys[i]] = (uint16_t) (found - values + 1);
+    }
+    for (mask = 0; mask <= SHORT_FLUSH_MASK; mask++){
+        if (__builtin_popcount(mask) < 5)
+            continue;
+        cards[0] = flush_value(mask);
+        found = (uint32_t *) bsearch(cards, values, ndistinct, sizeof(uint32_t), compare_values);
+        Short_Flush[mask] = (uint16_t) (found - values + 1);
+    }
+    Short_Ready = true;
+
+done:
+    free(values);
+}
+
+
+//build the tables the first time
+//Return false if there wasn't memory for them
+bool init_short_deck(void){
+    pthread_once(&Short_Once, build_short);
+    return Short_Ready;
+}
+
+
+static inline uint16_t short_lookup(uint32_t key, uint64_t bits){
+    int shift = isFlushTable[key >> SUITSHIFT];
+
+    if (shift != FAIL)
+        return Short_Flush[(bits >> (shift + SHORT_FLUSH_SHIFT)) & SHORT_FLUSH_MASK];
+    return Short_Ranks[key & RANKMASK];
+}
+
+
+//like set_dead, with the cards below the six dead too
+//Return FAIL for duplicate cards or cards not in a short deck
+int set_short_dead(const uint32_t *cards1, int n1, const uint32_t *cards2, int n2, bool dead[52]){
+    int i;
+
+    if (set_dead((void *) cards1, n1, (void *) cards2, n2, dead) == FAIL)
+        return FAIL;
+    for (i = SHORT_DECK; i < 52; i++){
+        if (dead[i])
+            return FAIL;
+        dead[i] = true;
+    }
+    return SUCCESS;
+}
+
+
+//the strength of 7 short deck cards, higher is better
+//Return FAIL for bad or duplicate cards
+int short_rank(const uint32_t cards[7]){
+    uint32_t key = 0;
+    uint64_t bits = 0;
+    int i;
+
+    if (!init_short_deck())
+        return FAIL;
+    for (i = 0; i < 7; i++){
+        if (cards[i] >= SHORT_DECK || (bits & Bits[cards[i]]))
+            return FAIL;
+        key += Deck[cards[i]];
+        bits |= Bits[cards[i]];
+    }
+    return short_lookup(key, bits);
+}
+
+
+//fill winners with the indexes of the n hands tied for the best on a
+//5 card board
+//Return the number of winners, or FAIL if the tables can't be built
+int multi_short(uint32_t hands[][2], int n, const uint32_t board[5], int winners[]){
+    uint32_t boardkey = 0;
+    uint64_t boardbits = 0;
+    int i, rank, best = -1, nwinners = 0;
+
+    if (!init_short_deck())
+        return FAIL;
+    for (i = 0; i < 5; i++){
+        boardkey += Deck[board[i]];
+        boardbits |= Bits[board[i]];
+    }
+    for (i = 0; i < n; i++){
+        rank = short_lookup(boardkey + Deck[hands[i][0]] + Deck[hands[i][1]],
+                            boardbits | Bits[hands[i][0]] | Bits[hands[i][1]]);
+        if (rank > best){
+            best = rank;
+            nwinners = 0;
+        }
+        if (rank == best)
+            winners[nwinners++] = i;
+    }
+    return nwinners;
+}
+
+
+//count the wins and ties of hand against every other hand the short
+//deck leaves on a 5 card board
+struct rivervalue short_rivervalue(uint32_t hand[2], uint32_t board[5]){
+    struct rivervalue value = {0, 0};
+    uint32_t boardkey = 0;
+    uint64_t boardbits = 0;
+    bool dead[52];
+    int i, j, rank, opp;
+
+    if (!init_short_deck() || set_short_dead(hand, 2, board, 5, dead) == FAIL){
+        value.wins = FAIL;
+        return value;
+    }
+    for (i = 0; i < 5; i++){
+        boardkey += Deck[board[i]];
+        boardbits |= Bits[board[i]];
+    }
+    rank = short_lookup(boardkey + Deck[hand[0]] + Deck[hand[1]],
+                        boardbits | Bits[hand[0]] | Bits[hand[1]]);
+    for (i = 0; i < SHORT_DECK; i++){
+        if (dead[i])
+            continue;
+        for (j = i + 1; j < SHORT_DECK; j++){
+            if (dead[j])
+                continue;
+            opp = short_lookup(boardkey + Deck[i] + Deck[j], boardbits | Bits[i] | Bits[j]);
+            value.wins += rank > opp;
+            value.ties += rank == opp;
+        }
+    }
+    return value;
+}
+
+
+//Enumeration splits the runouts by their highest live card, like
+//full_enumeration, and scores them in SHARE_UNITs so the results don't
+//depend on the threads.
+
+//what every worker reads
+typedef struct{
+    int nhands;
+    uint32_t handkeys[MAX_HANDS];
+    uint64_t handbits[MAX_HANDS];
+    uint32_t boardkey;
+    uint64_t boardbits;
+    int nboard;
+    int nlive;
+    uint32_t live[SHORT_DECK];
+}short_job;
+
+//what each worker writes
+typedef struct{
+    uint64_t shares[MAX_HANDS];
+    uint64_t nrunouts;
+}short_scorer;
+
+
+static void score_board(const short_job *job, short_scorer *s, uint32_t key, uint64_t bits){
+    int i, w, rank, best = -1, nwinners = 0, winners[MAX_HANDS];
+
+    for (i = 0; i < job->nhands; i++){
+        rank = short_lookup(key + job->handkeys[i], bits | job->handbits[i]);
+        if (rank > best){
+            best = rank;
+            nwinners = 0;
+        }
+        if (rank == best)
+            winners[nwinners++] = i;
+    }
+    for (w = 0; w < nwinners; w++)
+        s->shares[winners[w]] += SHARE_UNIT / nwinners;
+    s->nrunouts++;
+}
+
+
+//deal the cards from nboard on from the live cards below below
+static void short_runouts(const short_job *job, short_scorer *s, uint32_t key, uint64_t bits,
+                          int nboard, int below){
+    int i;
+
+    if (nboard == 5){
+        score_board(job, s, key, bits);
+        return;
+    }
+    for (i = below; i-- > 4 - nboard;)
+        short_runouts(job, s, key + Deck[job->live[i]], bits | Bits[job->live[i]], nboard + 1, i);
+}
+
+
+static void short_task(void *shared, void *local, int task){
+    const short_job *job = (const short_job *) shared;
+    int i = job->nlive - 1 - task;
+
+    if (job->nboard == 5){
+        score_board(job, (short_scorer *) local, job->boardkey, job->boardbits);
+        return;
+    }
+    short_runouts(job, (short_scorer *) local, job->boardkey + Deck[job->live[i]],
+                  job->boardbits | Bits[job->live[i]], job->nboard + 1, i);
+}
+
+
+int short_enumeration(uint32_t hands[][2], int nhands, uint32_t board[5], int nboard,
+                      double results[], int nthreads){
+    //hands -> two card hands from the short deck
+    //board -> nboard cards, between 0 and 5
+    //results -> the ev of each hand
+    //nthreads -> workers to share the next board card (see run_tasks)
+
+    bool dead[52];
+    uint64_t shares[MAX_HANDS], nrunouts = 0;
+    short_job job;
+    short_scorer *s;
+    int i, t, ntasks;
+
+    if (nhands < 1 || nhands > MAX_HANDS || nboard < 0 || nboard > 5 ||
+        nhands * 2 + 5 > SHORT_DECK || !init_short_deck())
+        return FAIL;
+    if (set_short_dead(hands[0], nhands * 2, board, nboard, dead) == FAIL)
+        return FAIL;
+
+    job.nhands = nhands;
+    for (i = 0; i < nhands; i++){
+        job.handkeys[i] = Deck[hands[i][0]] + Deck[hands[i][1]];
+        job.handbits[i] = Bits[hands[i][0]] | Bits[hands[i][1]];
+    }
+    job.boardkey = 0;
+    job.boardbits = 0;
+    for (i = 0; i < nboard; i++){
+        job.boardkey += Deck[board[i]];
+        job.boardbits |= Bits[board[i]];
+    }
+    job.nboard = nboard;
+    for (i = 0, job.nlive = 0; i < SHORT_DECK; i++){
+        if (!dead[i])
+            job.live[job.nlive++] = i;
+    }
+
+    ntasks = (nboard == 5) ? 1 : job.nlive - (4 - nboard);
+    nthreads = task_threads(nthreads, ntasks);
+    if ( (s = (short_scorer *) calloc(nthreads, sizeof(short_scorer))) == NULL )
+        return FAIL;
+    run_tasks(short_task, &job, s, sizeof(short_scorer), ntasks, nthreads);
+
+    for (i = 0; i < nhands; i++)
+        shares[i] = 0;
+    for (t = 0; t < nthreads; t++){
+        for (i = 0; i < nhands; i++)
+            shares[i] += s[t].shares[i];
+        nrunouts += s[t].nrunouts;
+    }
+    for (i = 0; i < nhands; i++)
+        results[i] = (double) shares[i] / ((double) nrunouts * SHARE_UNIT);
+    free(s);
+    return SUCCESS;
+}
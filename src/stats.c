@@ -0,0 +1,162 @@
+// Copyright 2013 Allen Boyd Cunningham
+
+// This file is part of pokyr.
+
+//     pokyr is free software: you can redistribute it and/or modify
+//     it under the terms of the GNU General Public License as published by
+//     the Free Software Foundation, either version 3 of the License, or
+//     (at your option) any later version.
+//     pokyr is distributed in the hope that it will be useful,
+//     but WITHOUT ANY WARRANTY; without even the implied warranty of
+//     MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//     GNU General Public License for more details.
+
+//     You should have received a copy of the GNU General Public License
+//     along with pokyr.  If not, see <http://www.gnu.org/licenses/>.
+
+
+#include "poker_heavy.h"
+
+//Counters of what the module spends its time on, built in when
+//COLLECT_STATS is defined (POKYR_STATS=1 at setup).  Without it the
+//STATS_ macros are empty and none of this is compiled.
+//
+//Each thread counts into its own block, so counting is a plain add
+//with no sharing between cpus.  Blocks of threads that exit are folded
+//into Retired, and reset_stats just remembers the totals so far for
+//read_stats to take off, so neither touches a block another thread is
+//counting into.
+
+#ifdef COLLECT_STATS
+
+#include <pthread.h>
+#include <string.h>
+#include <time.h>
+
+const char *const Stat_Names[NUM_STATS] = {
+    "handvalue", "handranks", "holdem2p", "multi_holdem", "rivervalue", "riverties",
+    "full_enumeration", "headsup_counts", "monte_carlo", "river_distribution",
+    "holdem_handranks", "best5_rank", "best5_ranks", "low_rank", "low_ranks", "omaha_rank",
+    "multi_omaha", "omaha_enumeration", "omaha_monte_carlo", "omaha_low",
+    "multi_omaha_hilo", "omaha_hilo_enumeration", "short_rank", "short_rivervalue",
+    "short_enumeration", "short_monte_carlo", "range_equity", "hand_strength",
+    "hand_strengths", "equity_histograms", "preflop_equity"
+};
+
+__thread stats_block *Local_Stats;
+
+static stats_block *All_Stats;      //live threads' blocks
+static stats Retired;
+static stats Base;
+//counts of threads that couldn't get a block of their own
+static stats_block Shared_Stats = {.shared = true};
+static pthread_mutex_t Stats_Lock = PTHREAD_MUTEX_INITIALIZER;
+static pthread_key_t Stats_Key;
+static pthread_once_t Stats_Once = PTHREAD_ONCE_INIT;
+
+#define NUM_COUNTS (sizeof(stats) / sizeof(uint64_t))
+
+
+static void add_stats(stats *to, const stats *from){
+    uint64_t *t = (uint64_t *) to;
+    const uint64_t *f = (const uint64_t *) from;
+    size_t i;
+
+    for (i = 0; i < NUM_COUNTS; i++)
+        t[i] += __atomic_load_n(f + i, __ATOMIC_RELAXED);
+}
+
+
+//fold an exiting thread's block into Retired
+static void retire_stats(void *block_){
+    stats_block *block = (stats_block *) block_;
+
+    pthread_mutex_lock(&Stats_Lock);
+    add_stats(&Retired, &block->counts);
+    if (block->prev)
+        block->prev->next = block->next;
+    else
+        All_Stats = block->next;
+    if (block->next)
+        block->next->prev = block->prev;
+    pthread_mutex_unlock(&Stats_Lock);
+    free(block);
+}
+
+static void make_key(void){
+    pthread_key_create(&Stats_Key, retire_stats);
+}
+
+
+//the calling thread's block the first time it counts anything
+stats_block *new_local_stats(void){
+    stats_block *block;
+
+    pthread_once(&Stats_Once, make_key);
+    if ( (block = (stats_block *) calloc(1, sizeof(stats_block))) == NULL )
+        return &Shared_Stats;
+
+    pthread_mutex_lock(&Stats_Lock);
+    block->next = All_Stats;
+    if (All_Stats)
+        All_Stats->prev = block;
+    All_Stats = block;
+    pthread_mutex_unlock(&Stats_Lock);
+
+    pthread_setspecific(Stats_Key, block);
+    Local_Stats = block;
+    return block;
+}
+
+
+uint64_t stats_clock(void){
+    struct timespec t;
+    clock_gettime(CLOCK_MONOTONIC, &t);
+    return (uint64_t) t.tv_sec * 1000000000u + (uint64_t) t.tv_nsec;
+}
+
+
+//count a call of entry point entry that started at stats_clock() start
+//and was given nhands hands
+void stats_call(int entry, uint64_t start, uint64_t nhands){
+    stats_block *s = Local_Stats ? Local_Stats : new_local_stats();
+    uint64_t ns = stats_clock() - start;
+    int bucket = 63 - __builtin_clzll(ns | 1);
+
+    if (bucket >= LATENCY_BUCKETS)
+        bucket = LATENCY_BUCKETS - 1;
+    STATS_BUMP(s, calls[entry], 1);
+    STATS_BUMP(s, hands_given[entry], nhands);
+    STATS_BUMP(s, latency[entry][bucket], 1);
+}
+
+
+static void total_stats(stats *total){
+    stats_block *block;
+
+    memcpy(total, &Retired, sizeof(stats));
+    add_stats(total, &Shared_Stats.counts);
+    for (block = All_Stats; block; block = block->next)
+        add_stats(total, &block->counts);
+}
+
+//the counts of every thread since the last reset_stats
+void read_stats(stats *out){
+    uint64_t *o = (uint64_t *) out;
+    const uint64_t *b = (const uint64_t *) &Base;
+    size_t i;
+
+    pthread_mutex_lock(&Stats_Lock);
+    total_stats(out);
+    for (i = 0; i < NUM_COUNTS; i++)
+        o[i] -= b[i];
+    pthread_mutex_unlock(&Stats_Lock);
+}
+
+void reset_stats(void){
+    pthread_mutex_lock(&Stats_Lock);
+    total_stats(&Base);
+    pthread_mutex_unlock(&Stats_Lock);
+}
+
+#endif
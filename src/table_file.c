@@ -0,0 +1,440 @@
+// Copyright 2013 Allen Boyd Cunningham
+
+// This file is part of pokyr.
+
+//     pokyr is free software: you can redistribute it and/or modify
+//     it under the terms of the GNU General Public License as published by
+//     the Free Software Foundation, either version 3 of the License, or
+//     (at your option) any later version.
+//     pokyr is distributed in the hope that it will be useful,
+//     but WITHOUT ANY WARRANTY; without even the implied warranty of
+//     MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//     GNU General Public License for more details.
+
+//     You should have received a copy of the GNU General Public License
+//     along with pokyr.  If not, see <http://www.gnu.org/licenses/>.
+
+
+#include "poker_heavy.h"
+
+#include <string.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+//save the populated Rank_Table and Flush_Table to disk so later
+//processes can map them instead of calling populate_tables again
+//
+//file layout:
+//    table_header
+//    zero padding up to TABLE_ALIGN
+//    Rank_Table  (rank_count uint16_t)
+//    Flush_Table (flush_count uint16_t)
+
+#define TABLE_MAGIC "POKYRTBL"
+#define TABLE_VERSION 1
+#define TABLE_ALIGN 4096
+#define HUGE_PAGE_SIZE (2 << 20)
+
+typedef struct{
+    char magic[8];
+    uint32_t version;
+    uint32_t header_size;
+    uint64_t fingerprint;
+    uint64_t rank_offset;
+    uint64_t rank_count;
+    uint64_t flush_offset;
+    uint64_t flush_count;
+    uint64_t checksum;
+}table_header;
+
+extern uint16_t *Rank_Table;
+extern uint16_t Flush_Table[FLUSH_TABLE_SIZE];
+extern const uint16_t Straight_Table[FLUSH_TABLE_SIZE];
+extern const int8_t isFlushTable[400];
+
+//set once init_tables has the tables in place
+static bool Tables_Ready;
+//set once a table file backs Rank_Table
+static bool Tables_Loaded;
+
+//FNV-1a over 64 bit words, with the tail folded in bytewise
+uint64_t checksum(const void *data, size_t n, uint64_t h){
+    const uint8_t *p = (const uint8_t *) data;
+    uint64_t word;
+
+    for (; n >= 8; n -= 8, p += 8){
+        memcpy(&word, p, 8);
+        h ^= word;
+        h *= 0x100000001b3ULL;
+    }
+    for (; n; n--, p++){
+        h ^= *p;
+        h *= 0x100000001b3ULL;
+    }
+    return h;
+}
+
+
+//identifies the inputs populate_tables was run from, so a file
+//written by a build with different generator tables reads as stale
+static uint64_t fingerprint(void){
+    static const uint32_t deck[52] = DECK;
+    uint64_t h = CHECKSUM_SEED;
+    uint64_t sizes[2] = {RANK_TABLE_SIZE, FLUSH_TABLE_SIZE};
+
+    h = checksum(sizes, sizeof(sizes), h);
+    h = checksum(deck, sizeof(deck), h);
+    h = checksum(Straight_Table, FLUSH_TABLE_SIZE * sizeof(uint16_t), h);
+    h = checksum(isFlushTable, sizeof(isFlushTable), h);
+    return h;
+}
+
+
+static table_header make_header(void){
+    table_header header;
+
+    memset(&header, 0, sizeof(header));
+    memcpy(header.magic, TABLE_MAGIC, 8);
+    header.version = TABLE_VERSION;
+    header.header_size = sizeof(table_header);
+    header.fingerprint = fingerprint();
+    header.rank_offset = TABLE_ALIGN;
+    header.rank_count = RANK_TABLE_SIZE;
+    header.flush_offset = TABLE_ALIGN + RANK_TABLE_SIZE * sizeof(uint16_t);
+    header.flush_count = FLUSH_TABLE_SIZE;
+    return header;
+}
+
+
+//write the current tables to path
+//the file is written next to path and renamed into place so
+//processes racing to create it never see a partial file
+int save_tables(const char *path){
+    static const char zeros[TABLE_ALIGN];
+    table_header header = make_header();
+    char *tmp;
+    FILE *f;
+    bool ok;
+
+    header.checksum = checksum(Rank_Table, RANK_TABLE_SIZE * sizeof(uint16_t), CHECKSUM_SEED);
+    header.checksum = checksum(Flush_Table, FLUSH_TABLE_SIZE * sizeof(uint16_t), header.checksum);
+
+    if ( (tmp = (char *) malloc(strlen(path) + 32)) == NULL )
+        return FAIL;
+    sprintf(tmp, "%s.%ld.tmp", path, (long) getpid());
+
+    if ( (f = fopen(tmp, "wb")) == NULL ){
+        free(tmp);
+        return FAIL;
+    }
+    ok = fwrite(&header, sizeof(header), 1, f) == 1 &&
+         fwrite(zeros, TABLE_ALIGN - sizeof(header), 1, f) == 1 &&
+         fwrite(Rank_Table, sizeof(uint16_t), RANK_TABLE_SIZE, f) == RANK_TABLE_SIZE &&
+         fwrite(Flush_Table, sizeof(uint16_t), FLUSH_TABLE_SIZE, f) == FLUSH_TABLE_SIZE;
+    ok = (fclose(f) == 0) && ok;
+
+    if ( !ok || rename(tmp, path) != 0 ){
+        remove(tmp);
+        free(tmp);
+        return FAIL;
+    }
+    free(tmp);
+    return SUCCESS;
+}
+
+
+//copy the rank table into anonymous memory aligned for transparent
+//huge pages, since page cache backed mappings rarely get them
+static void *huge_copy(const void *src, size_t size){
+    size_t mapsize = size + HUGE_PAGE_SIZE;
+    uint8_t *map, *aligned;
+
+    map = (uint8_t *) mmap(NULL, mapsize, PROT_READ | PROT_WRITE,
+                           MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (map == MAP_FAILED)
+        return NULL;
+
+    aligned = (uint8_t *) (((uintptr_t) map + HUGE_PAGE_SIZE - 1) & ~(uintptr_t) (HUGE_PAGE_SIZE - 1));
+    if (aligned != map)
+        munmap(map, aligned - map);
+    mapsize -= aligned - map;
+    if (mapsize > size)
+        munmap(aligned + size, mapsize - size);
+
+    #ifdef MADV_HUGEPAGE
+    madvise(aligned, size, MADV_HUGEPAGE);
+    #endif
+    memcpy(aligned, src, size);
+    mprotect(aligned, size, PROT_READ);
+    return aligned;
+}
+
+
+//point Rank_Table at the table stored in path and fill Flush_Table,
+//unless a table file was loaded already
+//Return FAIL without touching the current tables if the file is
+//missing, from another version or build, fails its checksum or, after
+//init_tables, holds tables other than the ones in use
+int load_tables(const char *path, int flags){
+    const size_t ranksize = RANK_TABLE_SIZE * sizeof(uint16_t);
+    const size_t flushsize = FLUSH_TABLE_SIZE * sizeof(uint16_t);
+    table_header expected = make_header();
+    const table_header *header;
+    struct stat st;
+    uint8_t *map;
+    void *ranks;
+    size_t size;
+    int fd, mapflags = MAP_PRIVATE;
+    uint64_t sum;
+
+    if ( (fd = open(path, O_RDONLY)) < 0 )
+        return FAIL;
+    if ( fstat(fd, &st) != 0 || (size_t) st.st_size != expected.flush_offset + flushsize ){
+        close(fd);
+        return FAIL;
+    }
+    size = (size_t) st.st_size;
+
+    #ifdef MAP_POPULATE
+    if (flags & TABLE_PREFAULT)
+        mapflags |= MAP_POPULATE;
+    #endif
+    map = (uint8_t *) mmap(NULL, size, PROT_READ, mapflags, fd, 0);
+    close(fd);
+    if (map == MAP_FAILED)
+        return FAIL;
+
+    header = (const table_header *) map;
+    expected.checksum = header->checksum;
+    if ( memcmp(header, &expected, sizeof(table_header)) != 0 ){
+        munmap(map, size);
+        return FAIL;
+    }
+
+    sum = checksum(map + header->rank_offset, ranksize, CHECKSUM_SEED);
+    sum = checksum(map + header->flush_offset, flushsize, sum);
+    if (sum != header->checksum){
+        munmap(map, size);
+        return FAIL;
+    }
+
+    //once the tables are in use other threads may be reading them at
+    //any time, so they are never written again: a later file has to
+    //hold the same tables (as one from the same build does) and only
+    //Rank_Table's pointer moves to it
+    if ( Tables_Ready && (memcmp(Flush_Table, map + header->flush_offset, flushsize) != 0 ||
+                          memcmp(Rank_Table, map + header->rank_offset, ranksize) != 0) ){
+        munmap(map, size);
+        return FAIL;
+    }
+    #ifdef COMPACT_RANKS
+    if ( !Tables_Ready && build_compact_table((const uint16_t *) (map + header->rank_offset)) == FAIL ){
+        munmap(map, size);
+        return FAIL;
+    }
+    #endif
+
+    //the mapping behind Rank_Table can't be unmapped while other threads
+    //may be reading it, so only the first table file is kept and later
+    //ones, which hold the same tables, are just checked
+    if (__atomic_exchange_n(&Tables_Loaded, true, __ATOMIC_ACQ_REL)){
+        munmap(map, size);
+        return SUCCESS;
+    }
+
+    if (flags & TABLE_HUGEPAGES){
+        if ( (ranks = huge_copy(map + header->rank_offset, ranksize)) == NULL ){
+            munmap(map, size);
+            __atomic_store_n(&Tables_Loaded, false, __ATOMIC_RELEASE);
+            return FAIL;
+        }
+    }
+    else
+        ranks = map + header->rank_offset;
+    if (!Tables_Ready)
+        memcpy(Flush_Table, map + header->flush_offset, flushsize);
+    if (flags & TABLE_HUGEPAGES)
+        munmap(map, size);
+
+    if (Tables_Ready){
+        __atomic_store_n(&Rank_Table, (uint16_t *) ranks, __ATOMIC_RELEASE);
+        return SUCCESS;
+    }
+    Rank_Table = (uint16_t *) ranks;
+    return SUCCESS;
+}
+
+
+//the heads-up preflop table (see preflop.c) is saved the same way
+//
+//file layout:
+//    preflop_header
+//    class keys (nclasses uint32_t)
+//    counts     (nclasses pairs of uint32_t, wins and ties)
+
+#define PREFLOP_MAGIC "POKYRPRE"
+#define PREFLOP_VERSION 2
+
+typedef struct{
+    char magic[8];
+    uint32_t version;
+    uint32_t header_size;
+    uint64_t fingerprint;
+    uint64_t nclasses;
+    uint64_t boards;
+    uint64_t checksum;
+}preflop_header;
+
+
+static int make_preflop_header(preflop_header *header, const uint32_t **keys){
+    int nclasses;
+
+    if ( (nclasses = preflop_classes(keys)) == FAIL )
+        return FAIL;
+    memset(header, 0, sizeof(*header));
+    memcpy(header->magic, PREFLOP_MAGIC, 8);
+    header->version = PREFLOP_VERSION;
+    header->header_size = sizeof(preflop_header);
+    header->fingerprint = fingerprint();
+    header->nclasses = nclasses;
+    header->boards = PREFLOP_BOARDS;
+    return nclasses;
+}
+
+
+//enumerate every heads-up preflop class and write the table to path
+//this takes minutes, spread over nthreads workers (see run_tasks)
+//Given matchups (see build_preflop_counts) only their classes are
+//enumerated, and the table leaves the rest out.
+int save_preflop_table(const char *path, const uint32_t *matchups, int nmatchups, int nthreads){
+    preflop_header header;
+    const uint32_t *keys;
+    uint32_t *counts;
+    int nclasses;
+    char *tmp;
+    FILE *f;
+    bool ok;
+
+    if ( (nclasses = make_preflop_header(&header, &keys)) == FAIL )
+        return FAIL;
+    if ( (counts = (uint32_t *) malloc(2 * nclasses * sizeof(uint32_t))) == NULL )
+        return FAIL;
+    if (build_preflop_counts(counts, matchups, nmatchups, nthreads) == FAIL){
+        free(counts);
+        return FAIL;
+    }
+    header.checksum = checksum(keys, nclasses * sizeof(uint32_t), CHECKSUM_SEED);
+    header.checksum = checksum(counts, 2 * nclasses * sizeof(uint32_t), header.checksum);
+
+    if ( (tmp = (char *) malloc(strlen(path) + 32)) == NULL ){
+        free(counts);
+        return FAIL;
+    }
+    sprintf(tmp, "%s.%ld.tmp", path, (long) getpid());
+
+    if ( (f = fopen(tmp, "wb")) == NULL ){
+        free(counts);
+        free(tmp);
+        return FAIL;
+    }
+    ok = fwrite(&header, sizeof(header), 1, f) == 1 &&
+         fwrite(keys, sizeof(uint32_t), nclasses, f) == (size_t) nclasses &&
+         fwrite(counts, sizeof(uint32_t), 2 * nclasses, f) == (size_t) (2 * nclasses);
+    ok = (fclose(f) == 0) && ok;
+    free(counts);
+
+    if ( !ok || rename(tmp, path) != 0 ){
+        remove(tmp);
+        free(tmp);
+        return FAIL;
+    }
+    free(tmp);
+    return SUCCESS;
+}
+
+
+//read the table save_preflop_table wrote and serve heads-up preflop
+//enumerations from it
+//Return FAIL, keeping the current table, if the file is missing, from
+//another version or build, or fails its checksum
+int load_preflop_table(const char *path){
+    preflop_header expected, header;
+    const uint32_t *keys;
+    uint32_t *data;
+    size_t n;
+    int nclasses;
+    FILE *f;
+    bool ok;
+
+    if ( (f = fopen(path, "rb")) == NULL )
+        return FAIL;
+    if ( (nclasses = make_preflop_header(&expected, &keys)) == FAIL ){
+        fclose(f);
+        return FAIL;
+    }
+    n = 3 * (size_t) nclasses;
+    if ( (data = (uint32_t *) malloc(n * sizeof(uint32_t))) == NULL ){
+        fclose(f);
+        return FAIL;
+    }
+    ok = fread(&header, sizeof(header), 1, f) == 1 &&
+         fread(data, sizeof(uint32_t), n, f) == n &&
+         fgetc(f) == EOF;
+    fclose(f);
+
+    expected.checksum = header.checksum;
+    if ( !ok || memcmp(&header, &expected, sizeof(header)) != 0 ||
+         checksum(data + nclasses, 2 * nclasses * sizeof(uint32_t),
+                  checksum(data, nclasses * sizeof(uint32_t), CHECKSUM_SEED)) != header.checksum ||
+         memcmp(data, keys, nclasses * sizeof(uint32_t)) != 0 ){
+        free(data);
+        return FAIL;
+    }
+
+    //like the rank tables, a table being replaced is left alone since
+    //other threads may still be reading it
+    set_preflop_counts(data + nclasses);
+    return SUCCESS;
+}
+
+
+//called once on import
+//POKYR_TABLE_FILE names a table file to map.  When it is missing or
+//stale the tables are built as usual and written there for next time.
+//POKYR_TABLE_PREFAULT and POKYR_TABLE_HUGEPAGES set the load flags.
+//POKYR_PREFLOP_FILE names a preflop table to load, which is too slow
+//to build here so is left alone if it is missing or stale.
+//Return false if the tables could not be built
+bool init_tables(void){
+    extern uint16_t Rank_Storage[RANK_TABLE_SIZE];
+    const char *path = getenv("POKYR_TABLE_FILE");
+    const char *env;
+    int flags = 0;
+
+    if (path && *path){
+        if ( (env = getenv("POKYR_TABLE_PREFAULT")) && *env && *env != '0' )
+            flags |= TABLE_PREFAULT;
+        if ( (env = getenv("POKYR_TABLE_HUGEPAGES")) && *env && *env != '0' )
+            flags |= TABLE_HUGEPAGES;
+        if (load_tables(path, flags) == SUCCESS)
+            goto preflop;
+    }
+
+    populate_tables(Rank_Storage, Flush_Table, Straight_Table);
+    Rank_Table = Rank_Storage;
+    #ifdef COMPACT_RANKS
+    if (build_compact_table(Rank_Table) == FAIL)
+        return false;
+    #endif
+
+    if (path && *path)
+        save_tables(path);
+
+  preflop:
+    Tables_Ready = true;
+    if ( (path = getenv("POKYR_PREFLOP_FILE")) && *path )
+        load_preflop_table(path);
+    return true;
+}
@@ -0,0 +1,106 @@
+// Copyright 2013 Allen Boyd Cunningham
+
+// This file is part of pokyr.
+
+//     pokyr is free software: you can redistribute it and/or modify
+//     it under the terms of the GNU General Public License as published by
+//     the Free Software Foundation, either version 3 of the License, or
+//     (at your option) any later version.
+//     pokyr is distributed in the hope that it will be useful,
+//     but WITHOUT ANY WARRANTY; without even the implied warranty of
+//     MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//     GNU General Public License for more details.
+
+//     You should have received a copy of the GNU General Public License
+//     along with pokyr.  If not, see <http://www.gnu.org/licenses/>.
+
+
+#include "poker_heavy.h"
+
+#include <pthread.h>
+#include <unistd.h>
+
+//run_tasks hands tasks 0 to ntasks - 1 out in order to whichever
+//worker is free, so callers put their biggest tasks first.  Each worker
+//keeps its own results in its slot of locals for the caller to combine
+//afterwards, which keeps the results independent of the scheduling.
+
+typedef struct{
+    task_fn fn;
+    void *shared;
+    int ntasks;
+    int next;
+    pthread_mutex_t lock;
+}task_queue;
+
+typedef struct{
+    task_queue *queue;
+    void *local;
+}worker;
+
+
+static void *work(void *arg){
+    worker *w = (worker *) arg;
+    task_queue *q = w->queue;
+    int task;
+
+    for (;;){
+        pthread_mutex_lock(&q->lock);
+        task = q->next++;
+        pthread_mutex_unlock(&q->lock);
+        if (task >= q->ntasks)
+            break;
+        q->fn(q->shared, w->local, task);
+    }
+    return NULL;
+}
+
+
+//the number of workers run_tasks will use when asked for nthreads
+//0 means one per online cpu
+int task_threads(int nthreads, int ntasks){
+    if (nthreads <= 0){
+        long ncpus = sysconf(_SC_NPROCESSORS_ONLN);
+        nthreads = (ncpus > 0) ? (int) ncpus : 1;
+    }
+    if (nthreads > MAX_THREADS)
+        nthreads = MAX_THREADS;
+    if (nthreads > ntasks)
+        nthreads = ntasks;
+    return (nthreads > 0) ? nthreads : 1;
+}
+
+
+//call fn(shared, local, task) for every task, spreading them over
+//task_threads(nthreads, ntasks) workers with the calling thread as the
+//first.  locals holds that many slots of localsize bytes.
+//Workers that can't be started leave their tasks to the others.
+void run_tasks(task_fn fn, void *shared, void *locals, size_t localsize, int ntasks, int nthreads){
+    pthread_t threads[MAX_THREADS];
+    bool started[MAX_THREADS];
+    worker workers[MAX_THREADS];
+    task_queue q;
+    int i;
+
+    nthreads = task_threads(nthreads, ntasks);
+    q.fn = fn;
+    q.shared = shared;
+    q.ntasks = ntasks;
+    q.next = 0;
+    pthread_mutex_init(&q.lock, NULL);
+
+    for (i = 0; i < nthreads; i++){
+        workers[i].queue = &q;
+        workers[i].local = (char *) locals + i * localsize;
+    }
+    for (i = 1; i < nthreads; i++)
+        started[i] = pthread_create(&threads[i], NULL, work, &workers[i]) == 0;
+
+    work(&workers[0]);
+
+    for (i = 1; i < nthreads; i++){
+        if (started[i])
+            pthread_join(threads[i], NULL);
+    }
+    pthread_mutex_destroy(&q.lock);
+}